@@ -7,14 +7,89 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include "main/IdeaPlaceEx.h"
+#include "main/BatchPlacer.h"
 
 namespace py = pybind11;
 void initIdeaPlaceExAPI(py::module &m)
 {
+    py::enum_<PROJECT_NAMESPACE::SolveStageType>(m, "SolveStageType")
+        .value("NOT_STARTED", PROJECT_NAMESPACE::SolveStageType::NOT_STARTED)
+        .value("GLOBAL_PLACEMENT", PROJECT_NAMESPACE::SolveStageType::GLOBAL_PLACEMENT)
+        .value("LEGALIZATION", PROJECT_NAMESPACE::SolveStageType::LEGALIZATION)
+        .value("DETAILED_PLACEMENT", PROJECT_NAMESPACE::SolveStageType::DETAILED_PLACEMENT)
+        .value("PIN_ASSIGNMENT", PROJECT_NAMESPACE::SolveStageType::PIN_ASSIGNMENT)
+        .value("FINISHED", PROJECT_NAMESPACE::SolveStageType::FINISHED)
+        .value("CANCELLED", PROJECT_NAMESPACE::SolveStageType::CANCELLED)
+        ;
+    py::enum_<PROJECT_NAMESPACE::MsgType>(m, "MsgType")
+        .value("INF", PROJECT_NAMESPACE::MsgType::INF)
+        .value("WRN", PROJECT_NAMESPACE::MsgType::WRN)
+        .value("ERR", PROJECT_NAMESPACE::MsgType::ERR)
+        .value("DBG", PROJECT_NAMESPACE::MsgType::DBG)
+        ;
+    py::class_<::klib::MemoryStats>(m, "MemoryStats")
+        .def_readonly("stage", &::klib::MemoryStats::stage, "The name of the stage")
+        .def_readonly("numAllocs", &::klib::MemoryStats::numAllocs, "The number of heap allocations")
+        .def_readonly("allocBytes", &::klib::MemoryStats::allocBytes, "The total bytes allocated on the heap")
+        .def_readonly("peakHeapBytes", &::klib::MemoryStats::peakHeapBytes, "The peak of the live heap bytes above the start of the stage")
+        .def_readonly("netHeapBytes", &::klib::MemoryStats::netHeapBytes, "The live heap bytes at the end minus the start of the stage")
+        .def_readonly("rssBytes", &::klib::MemoryStats::rssBytes, "The resident set size at the end of the stage")
+        .def_readonly("peakRssBytes", &::klib::MemoryStats::peakRssBytes, "The peak resident set size during the stage")
+        ;
+    py::class_<PROJECT_NAMESPACE::ConvergenceTrace>(m, "ConvergenceTrace")
+        .def(py::init<>())
+        .def("names", &PROJECT_NAMESPACE::ConvergenceTrace::names, "The names of the columns")
+        .def("numRows", &PROJECT_NAMESPACE::ConvergenceTrace::numRows, "The number of recorded iterations")
+        .def("numColumns", &PROJECT_NAMESPACE::ConvergenceTrace::numColumns, "The number of columns")
+        .def("column", [](const PROJECT_NAMESPACE::ConvergenceTrace &self, const std::string &name)
+                {
+                    PROJECT_NAMESPACE::IndexType colIdx = self.columnIdx(name);
+                    if (colIdx == PROJECT_NAMESPACE::INDEX_TYPE_MAX)
+                    {
+                        throw py::key_error(name);
+                    }
+                    const auto &column = self.column(colIdx);
+                    return py::array_t<PROJECT_NAMESPACE::RealType>(column.size(), column.data());
+                }, "Get a column as a NumPy array")
+        .def("array", [](const PROJECT_NAMESPACE::ConvergenceTrace &self)
+                {
+                    auto values = self.rowMajor();
+                    py::array_t<PROJECT_NAMESPACE::RealType> array({static_cast<py::ssize_t>(self.numRows()), static_cast<py::ssize_t>(self.numColumns())});
+                    std::copy(values.begin(), values.end(), array.mutable_data());
+                    return array;
+                }, "Get the table as a 2D NumPy array, one row per iteration")
+        .def("writeCsv", &PROJECT_NAMESPACE::ConvergenceTrace::writeCsv, "Write the table as comma-separated values")
+        .def("writeBinary", &PROJECT_NAMESPACE::ConvergenceTrace::writeBinary, "Write the table as binary columns")
+        .def("readBinary", &PROJECT_NAMESPACE::ConvergenceTrace::readBinary, "Read the table written by writeBinary")
+        ;
+    py::class_<PROJECT_NAMESPACE::SolveProgress>(m, "SolveProgress")
+        .def_readonly("stage", &PROJECT_NAMESPACE::SolveProgress::stage, "The current stage")
+        .def_readonly("outerIter", &PROJECT_NAMESPACE::SolveProgress::outerIter, "The number of finished outer iterations of the global placement")
+        .def_readonly("obj", &PROJECT_NAMESPACE::SolveProgress::obj, "The total objective of the global placement")
+        .def_readonly("objHpwl", &PROJECT_NAMESPACE::SolveProgress::objHpwl, "The wirelength objective")
+        .def_readonly("objOvl", &PROJECT_NAMESPACE::SolveProgress::objOvl, "The overlapping penalty")
+        .def_readonly("objOob", &PROJECT_NAMESPACE::SolveProgress::objOob, "The out of boundary penalty")
+        .def_readonly("objAsym", &PROJECT_NAMESPACE::SolveProgress::objAsym, "The asymmetry penalty")
+        .def_readonly("objCos", &PROJECT_NAMESPACE::SolveProgress::objCos, "The signal path penalty")
+        .def_readonly("objPowerWl", &PROJECT_NAMESPACE::SolveProgress::objPowerWl, "The power wirelength")
+        .def_readonly("objCrf", &PROJECT_NAMESPACE::SolveProgress::objCrf, "The current flow penalty")
+        ;
     py::class_<PROJECT_NAMESPACE::IdeaPlaceEx>(m , "IdeaPlaceEx")
         .def(py::init<>())
-        .def("solve", &PROJECT_NAMESPACE::IdeaPlaceEx::solve, "Solve the problem")
+        .def("solve", &PROJECT_NAMESPACE::IdeaPlaceEx::solve, "Solve the problem", py::call_guard<py::gil_scoped_release>())
+        .def("solveAsync", [](PROJECT_NAMESPACE::IdeaPlaceEx &self, PROJECT_NAMESPACE::LocType gridSize, bool writeConst, std::string filename)
+                { self.solveAsync(gridSize, writeConst, filename); },
+                "Solve the problem in a new thread. Poll with isSolveDone or wait with waitSolve",
+                py::arg("gridSize") = -1, py::arg("writeConst") = false, py::arg("filename") = "")
+        .def("waitSolve", &PROJECT_NAMESPACE::IdeaPlaceEx::waitSolve, "Wait for the asynchronous solving and return its result", py::call_guard<py::gil_scoped_release>())
+        .def("isSolveDone", &PROJECT_NAMESPACE::IdeaPlaceEx::isSolveDone, "Whether the asynchronous solving has finished")
+        .def("cancelSolve", &PROJECT_NAMESPACE::IdeaPlaceEx::cancelSolve, "Stop the solving at the next outer iteration or LP, keeping the best partial placement")
+        .def("isSolveCancelled", &PROJECT_NAMESPACE::IdeaPlaceEx::isSolveCancelled, "Whether the last solving was cancelled")
+        .def("solveProgress", &PROJECT_NAMESPACE::IdeaPlaceEx::solveProgress, "Get the latest progress of the solving")
+        .def("setProgressCallback", &PROJECT_NAMESPACE::IdeaPlaceEx::setProgressCallback, "Set the callback for the progress events. Called from the thread running the placement")
         .def("alignToGrid", &PROJECT_NAMESPACE::IdeaPlaceEx::alignToGrid, "Align the placement to grid")
         .def("numThreads", &PROJECT_NAMESPACE::IdeaPlaceEx::setNumThreads, "Set number of threads")
         .def("readTechSimpleFile", &PROJECT_NAMESPACE::IdeaPlaceEx::readTechSimpleFile, "Internal usage: Read in the techsimple file")
@@ -23,8 +98,11 @@ void initIdeaPlaceExAPI(py::module &m)
         .def("readNetWgtFile", &PROJECT_NAMESPACE::IdeaPlaceEx::readNetWgtFile, "Internal usage: Read in the .netwgt file")
         .def("readSymFile", &PROJECT_NAMESPACE::IdeaPlaceEx::readSymFile, "Internal usage: Read in the .sym file")
         .def("readGdsLayout", &PROJECT_NAMESPACE::IdeaPlaceEx::readGdsLayout, "Internal Usage: Read in a gds for cell, the name of the GDS cell need to match the cell name")
+        .def("readGdsLayouts", &PROJECT_NAMESPACE::IdeaPlaceEx::readGdsLayouts, "Internal Usage: Read in the gds files for a number of cells in parallel. If the cell indices are empty, the names of the GDS cells need to match the cell names", py::arg("gdsFiles"), py::arg("cellIdxs") = std::vector<PROJECT_NAMESPACE::IndexType>())
         .def("readSymNetFile", &PROJECT_NAMESPACE::IdeaPlaceEx::readSymNetFile, "Internal Usage: Read in a .symnet file")
         .def("readSigpathFile", &PROJECT_NAMESPACE::IdeaPlaceEx::readSigpathFile, "Internal Usage: Read in a .sigpath file")
+        .def("saveSnapshot", &PROJECT_NAMESPACE::IdeaPlaceEx::saveSnapshot, "Save the whole database into a binary snapshot")
+        .def("loadSnapshot", &PROJECT_NAMESPACE::IdeaPlaceEx::loadSnapshot, "Load the whole database from a binary snapshot")
         .def("addGdsLayer", &PROJECT_NAMESPACE::IdeaPlaceEx::addGdsLayer, py::arg("cellIdx") = PROJECT_NAMESPACE::INDEX_TYPE_MAX, "Add a gds to a cell")
         .def("finishAddingGdsLayer", &PROJECT_NAMESPACE::IdeaPlaceEx::finishAddingGdsLayer, "Finish the gds layer adding, trigger a init function")
         .def("allocateCell", &PROJECT_NAMESPACE::IdeaPlaceEx::allocateCell, "Allocate a new cell, return the index of the cell")
@@ -47,6 +125,13 @@ void initIdeaPlaceExAPI(py::module &m)
         .def("pinIdx", &PROJECT_NAMESPACE::IdeaPlaceEx::pinIdx, "Get the index based on pin name")
         .def("openVirtualPinAssignment", &PROJECT_NAMESPACE::IdeaPlaceEx::openVirtualPinAssignment, "Open the virtual pin assignment functionality")
         .def("closeVirtualPinAssignment", &PROJECT_NAMESPACE::IdeaPlaceEx::closeVirtualPinAssignment, "Close the virtual pin assignment functionality")
+        .def("openGdsStreamReader", &PROJECT_NAMESPACE::IdeaPlaceEx::openGdsStreamReader, "Read the gds layouts by streaming the shapes into bounding boxes")
+        .def("closeGdsStreamReader", &PROJECT_NAMESPACE::IdeaPlaceEx::closeGdsStreamReader, "Read the gds layouts by flattening the full gds database")
+        .def("openGpCheckpoint", &PROJECT_NAMESPACE::IdeaPlaceEx::openGpCheckpoint, "Write the global placement checkpoints into a file every number of outer iterations")
+        .def("closeGpCheckpoint", &PROJECT_NAMESPACE::IdeaPlaceEx::closeGpCheckpoint, "Stop writing the global placement checkpoints")
+        .def("setGpResumeFile", &PROJECT_NAMESPACE::IdeaPlaceEx::setGpResumeFile, "Resume the global placement from a checkpoint file")
+        .def("openResultCache", &PROJECT_NAMESPACE::IdeaPlaceEx::openResultCache, "Cache the placement results in a directory, and reuse them for the same inputs")
+        .def("closeResultCache", &PROJECT_NAMESPACE::IdeaPlaceEx::closeResultCache, "Stop using the placement result cache")
         .def("setIoPinBoundaryExtension", &PROJECT_NAMESPACE::IdeaPlaceEx::setIoPinBoundaryExtension, "Set the extension of io pin locations to the boundary of cell placements")
         .def("setIoPinInterval", &PROJECT_NAMESPACE::IdeaPlaceEx::setIoPinInterval, "Set the minimum interval of io pins")
         .def("markIoNet", &PROJECT_NAMESPACE::IdeaPlaceEx::markAsIoNet, "Mark a net as IO net")
@@ -75,8 +160,51 @@ void initIdeaPlaceExAPI(py::module &m)
         .def("runtimeGlobalPlaceUpdateProblem", &PROJECT_NAMESPACE::IdeaPlaceEx::runtimeGlobalPlaceUpdateProblem, "Get the time used for updating the problem in gloobal placement")
         .def("runtimeLegalization", &PROJECT_NAMESPACE::IdeaPlaceEx::runtimeLegalization, "Get the time used for legalization")
         .def("runtimeDetailedPlacement", &PROJECT_NAMESPACE::IdeaPlaceEx::runtimeDetailedPlacement, "Get the time used for detailed placement")
+        .def("enableTrace", &PROJECT_NAMESPACE::IdeaPlaceEx::enableTrace, "Start recording the timing intervals for the trace")
+        .def("disableTrace", &PROJECT_NAMESPACE::IdeaPlaceEx::disableTrace, "Stop recording the timing intervals")
+        .def("clearTrace", &PROJECT_NAMESPACE::IdeaPlaceEx::clearTrace, "Drop the recorded timing intervals")
+        .def("writeTrace", &PROJECT_NAMESPACE::IdeaPlaceEx::writeTrace, "Write the recorded timing intervals in the Chrome trace_event format")
+        .def("profileReport", &PROJECT_NAMESPACE::IdeaPlaceEx::profileReport, "Get the recorded timing intervals summarized as a tree")
+        .def("enablePerfCounters", &PROJECT_NAMESPACE::IdeaPlaceEx::enablePerfCounters, "Count the hardware events in the timed stages. Return false if not available")
+        .def("disablePerfCounters", &PROJECT_NAMESPACE::IdeaPlaceEx::disablePerfCounters, "Stop counting the hardware events")
+        .def("perfCounters", &PROJECT_NAMESPACE::IdeaPlaceEx::perfCounters, "Get the cycles, instructions, cache misses and branch misses of a timed stage")
+        .def("perfReport", &PROJECT_NAMESPACE::IdeaPlaceEx::perfReport, "Get the hardware counts of the timed stages")
+        .def("enableMemoryTracking", &PROJECT_NAMESPACE::IdeaPlaceEx::enableMemoryTracking, "Count the heap allocations by the stages of solve()")
+        .def("disableMemoryTracking", &PROJECT_NAMESPACE::IdeaPlaceEx::disableMemoryTracking, "Stop counting the heap allocations")
+        .def("memoryStats", &PROJECT_NAMESPACE::IdeaPlaceEx::memoryStats, "Get the memory usage of each stage in the last solve()")
+        .def("memoryReport", &PROJECT_NAMESPACE::IdeaPlaceEx::memoryReport, "Get the memory usage of each stage in the last solve() as a table")
+        .def("enableConvergenceTrace", &PROJECT_NAMESPACE::IdeaPlaceEx::enableConvergenceTrace, "Record the state of each global placement iteration")
+        .def("disableConvergenceTrace", &PROJECT_NAMESPACE::IdeaPlaceEx::disableConvergenceTrace, "Stop recording the global placement iterations")
+        .def("convergenceTrace", &PROJECT_NAMESPACE::IdeaPlaceEx::convergenceTrace, "Get the global placement iterations recorded in the last solve()", py::return_value_policy::copy)
+        .def("writeConvergenceTrace", &PROJECT_NAMESPACE::IdeaPlaceEx::writeConvergenceTrace, "Write the recorded global placement iterations. CSV if the file name ends with .csv")
+        .def("generateSyntheticNetlist", &PROJECT_NAMESPACE::IdeaPlaceEx::generateSyntheticNetlist, "Generate a synthetic problem of a number of cells into an empty placer. The same seed gives the same problem",
+                py::arg("numCells"), py::arg("seed") = 1)
+        .def("setMinMsgType", &PROJECT_NAMESPACE::IdeaPlaceEx::setMinMsgType, "Only print the messages at least as severe as the type")
+        .def("startAsyncLog", &PROJECT_NAMESPACE::IdeaPlaceEx::startAsyncLog, "Format and write the messages in a background thread", py::arg("bufferSize") = 1 << 18)
+        .def("stopAsyncLog", &PROJECT_NAMESPACE::IdeaPlaceEx::stopAsyncLog, "Write the pending messages and go back to writing them at once")
         .def("addHorConstr", &PROJECT_NAMESPACE::IdeaPlaceEx::addHorConstr, "Add a horizontal constraint")
         .def("addVerConstr", &PROJECT_NAMESPACE::IdeaPlaceEx::addVerConstr, "Add a vertical constraint")
         .def("hpwl", &PROJECT_NAMESPACE::IdeaPlaceEx::hpwl, "Half perimeter wirelength")
         ;
+    py::class_<PROJECT_NAMESPACE::BatchJobResult>(m, "BatchJobResult")
+        .def_readonly("isFinished", &PROJECT_NAMESPACE::BatchJobResult::isFinished, "Whether the job has run to the end without error")
+        .def_readonly("isCancelled", &PROJECT_NAMESPACE::BatchJobResult::isCancelled, "Whether the job was cancelled")
+        .def_readonly("symAxis", &PROJECT_NAMESPACE::BatchJobResult::symAxis, "The return value of solve()")
+        .def_readonly("numThreads", &PROJECT_NAMESPACE::BatchJobResult::numThreads, "The number of threads used by the job")
+        .def_readonly("workerIdx", &PROJECT_NAMESPACE::BatchJobResult::workerIdx, "The worker running the job")
+        .def_readonly("waitTime", &PROJECT_NAMESPACE::BatchJobResult::waitTime, "The time from the start of the batch to the start of the job in us")
+        .def_readonly("runtime", &PROJECT_NAMESPACE::BatchJobResult::runtime, "The runtime of the job in us")
+        ;
+    py::class_<PROJECT_NAMESPACE::BatchPlacer>(m, "BatchPlacer")
+        .def(py::init<>())
+        .def("addJob", &PROJECT_NAMESPACE::BatchPlacer::addJob, "Add a prepared IdeaPlaceEx as a job. Return the index of the job",
+                py::arg("placer"), py::arg("gridStep") = -1, py::arg("numThreads") = 0, py::keep_alive<1, 2>())
+        .def("numThreads", &PROJECT_NAMESPACE::BatchPlacer::setNumThreads, "Set the total number of threads shared by the jobs")
+        .def("setNumCellsPerThread", &PROJECT_NAMESPACE::BatchPlacer::setNumCellsPerThread, "Set the number of cells given one thread when deciding the thread budgets")
+        .def("run", &PROJECT_NAMESPACE::BatchPlacer::run, "Run all the jobs. Return whether all of them are finished", py::call_guard<py::gil_scoped_release>())
+        .def("cancel", &PROJECT_NAMESPACE::BatchPlacer::cancel, "Cancel the running batch. The running jobs keep their partial placements")
+        .def("numJobs", &PROJECT_NAMESPACE::BatchPlacer::numJobs, "Get the number of jobs")
+        .def("result", &PROJECT_NAMESPACE::BatchPlacer::result, "Get the result of a job", py::return_value_policy::copy)
+        .def("runtime", &PROJECT_NAMESPACE::BatchPlacer::runtime, "Get the runtime of the last run in us")
+        ;
 }
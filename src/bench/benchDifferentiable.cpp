@@ -0,0 +1,397 @@
+/**
+ * @file benchDifferentiable.cpp
+ * @brief Benchmark the per-call cost of the global placement operators in place/different.h
+ * @date 10/17/2026
+ */
+
+#include <benchmark/benchmark.h>
+#include <omp.h>
+#include <random>
+#include <Eigen/Dense>
+#include "place/differentSecondOrder.hpp"
+#include "place/VectorMath.h"
+
+/* Each operator type is measured for the objective evaluation, the gradient accumulation and, if the operator has one, the Jacobi hessian approximation.
+ * The arguments are the number of operators, the size of each operator (the pins of a net or the pairs of a symmetric group) and the number of OpenMP threads.
+ * The batch of the vertical constraints is one operator evaluated by one thread. It is built from the same constraints as VerOp with the same arguments, so compare it to VerOp at one thread.
+ * Use --benchmark_format=json or --benchmark_out=<file> --benchmark_out_format=json for the machine-readable results */
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace BenchDifferentiableDetails
+{
+    typedef RealType NumType;
+    typedef RealType CoordType;
+    typedef diff::LseHpwlDifferentiable<NumType, CoordType> HpwlOp;
+    typedef diff::CellPairOverlapPenaltyDifferentiable<NumType, CoordType> OvlOp;
+    typedef diff::CellOutOfBoundaryPenaltyDifferentiable<NumType, CoordType> OobOp;
+    typedef diff::AsymmetryDifferentiable<NumType, CoordType> AsymOp;
+    typedef diff::CosineDatapathDifferentiable<NumType, CoordType> CosOp;
+    typedef diff::PowerVerQuadraticWireLengthDifferentiable<NumType, CoordType> PowerWlOp;
+    typedef diff::VerticalConstraintDifferentiable<NumType, CoordType> VerOp;
+    typedef diff::HorizontalConstraintDifferentiable<NumType, CoordType> HorOp;
+    typedef diff::RelationalConstraintBatchDifferentiable<NumType, CoordType> BatchOp;
+    typedef Eigen::Map<Eigen::Matrix<NumType, Eigen::Dynamic, 1>> VectorMap;
+
+    constexpr IndexType NUM_CELLS = 1024;
+    constexpr CoordType CELL_SPACING = 4.0; ///< The average area per cell is CELL_SPACING^2
+    constexpr NumType ALPHA = 1.0;
+    constexpr NumType LAMBDA = 1.0;
+
+    /// @brief the placement variables and the per-thread gradient and hessian diagonal the operators accumulate into.
+    /// The layout of the variables follows the placer: x and y of each cell, then the symmetric axes
+    struct Problem
+    {
+        explicit Problem(IndexType numSymGrps)
+            : rng(numSymGrps)
+        {
+            const CoordType width = CELL_SPACING * std::sqrt(static_cast<CoordType>(NUM_CELLS));
+            boundary = Box<CoordType>(0, 0, width, width);
+            std::uniform_real_distribution<CoordType> coord(0, width);
+            std::uniform_real_distribution<CoordType> size(1, CELL_SPACING);
+            vars.resize(2 * NUM_CELLS + numSymGrps);
+            for (auto &var : vars)
+            {
+                var = coord(rng);
+            }
+            for (IndexType cellIdx = 0; cellIdx < NUM_CELLS; ++cellIdx)
+            {
+                widths.emplace_back(size(rng));
+                heights.emplace_back(size(rng));
+            }
+            grads.assign(omp_get_max_threads(), std::vector<NumType>(vars.size(), 0));
+            hessians.assign(omp_get_max_threads(), std::vector<NumType>(vars.size(), 0));
+        }
+        IndexType varIdx(IndexType idx, Orient2DType orient) const
+        {
+            if (orient == Orient2DType::HORIZONTAL) { return 2 * idx; }
+            if (orient == Orient2DType::VERTICAL) { return 2 * idx + 1; }
+            return 2 * NUM_CELLS + idx;
+        }
+        IndexType randomCell() { return std::uniform_int_distribution<IndexType>(0, NUM_CELLS - 1)(rng); }
+        CoordType randomOffset(IndexType cellIdx, Orient2DType orient)
+        {
+            CoordType len = orient == Orient2DType::HORIZONTAL ? widths[cellIdx] : heights[cellIdx];
+            return std::uniform_real_distribution<CoordType>(0, len)(rng);
+        }
+        XY<CoordType> randomPinOffset(IndexType cellIdx)
+        {
+            CoordType x = randomOffset(cellIdx, Orient2DType::HORIZONTAL);
+            return XY<CoordType>(x, randomOffset(cellIdx, Orient2DType::VERTICAL));
+        }
+
+        std::mt19937 rng;
+        std::vector<CoordType> vars;
+        std::vector<CoordType> widths;
+        std::vector<CoordType> heights;
+        Box<CoordType> boundary;
+        std::vector<std::vector<NumType>> grads; ///< One gradient per thread, so that the threads do not race
+        std::vector<std::vector<NumType>> hessians; ///< One hessian diagonal per thread
+        std::function<NumType(void)> getAlphaFunc = [] () { return ALPHA; };
+        std::function<NumType(void)> getLambdaFunc = [] () { return LAMBDA; };
+    };
+
+    /// @brief connect an operator to the variables and the gradient of the problem
+    template<typename OpType>
+    inline void bind(OpType &op, Problem &problem)
+    {
+        op.setGetVarFunc([&problem](IndexType idx, Orient2DType orient) { return problem.vars[problem.varIdx(idx, orient)]; });
+        op.setAccumulateGradFunc([&problem](NumType value, IndexType idx, Orient2DType orient)
+                {
+                    problem.grads[omp_get_thread_num()][problem.varIdx(idx, orient)] += value;
+                });
+    }
+
+    /* Build the operators. The size is the number of pins for the nets, and the number of pairs for the symmetric groups. The others have a fixed size */
+    inline void build(std::vector<HpwlOp> &ops, Problem &problem, IndexType numOps, IndexType size)
+    {
+        for (IndexType opIdx = 0; opIdx < numOps; ++opIdx)
+        {
+            ops.emplace_back(HpwlOp(problem.getAlphaFunc, problem.getLambdaFunc));
+            for (IndexType pinIdx = 0; pinIdx < size; ++pinIdx)
+            {
+                IndexType cellIdx = problem.randomCell();
+                auto offset = problem.randomPinOffset(cellIdx);
+                ops.back().addVar(cellIdx, offset.x(), offset.y());
+            }
+        }
+    }
+    inline void build(std::vector<OvlOp> &ops, Problem &problem, IndexType numOps, IndexType)
+    {
+        for (IndexType opIdx = 0; opIdx < numOps; ++opIdx)
+        {
+            IndexType cellIdxI = problem.randomCell();
+            IndexType cellIdxJ = problem.randomCell();
+            ops.emplace_back(OvlOp(cellIdxI, problem.widths[cellIdxI], problem.heights[cellIdxI],
+                        cellIdxJ, problem.widths[cellIdxJ], problem.heights[cellIdxJ],
+                        problem.getAlphaFunc, problem.getLambdaFunc));
+        }
+    }
+    inline void build(std::vector<OobOp> &ops, Problem &problem, IndexType numOps, IndexType)
+    {
+        for (IndexType opIdx = 0; opIdx < numOps; ++opIdx)
+        {
+            IndexType cellIdx = problem.randomCell();
+            ops.emplace_back(OobOp(cellIdx, problem.widths[cellIdx], problem.heights[cellIdx], &problem.boundary,
+                        problem.getAlphaFunc, problem.getLambdaFunc));
+        }
+    }
+    inline void build(std::vector<AsymOp> &ops, Problem &problem, IndexType numOps, IndexType size)
+    {
+        for (IndexType opIdx = 0; opIdx < numOps; ++opIdx)
+        {
+            ops.emplace_back(AsymOp(opIdx, problem.getLambdaFunc));
+            for (IndexType pairIdx = 0; pairIdx < size; ++pairIdx)
+            {
+                IndexType cellIdx = problem.randomCell();
+                ops.back().addSymPair(cellIdx, problem.randomCell(), problem.widths[cellIdx]);
+            }
+            IndexType cellIdx = problem.randomCell();
+            ops.back().addSelfSym(cellIdx, problem.widths[cellIdx]);
+        }
+    }
+    inline void build(std::vector<CosOp> &ops, Problem &problem, IndexType numOps, IndexType)
+    {
+        for (IndexType opIdx = 0; opIdx < numOps; ++opIdx)
+        {
+            IndexType sCellIdx = problem.randomCell();
+            IndexType midCellIdx = problem.randomCell();
+            IndexType tCellIdx = problem.randomCell();
+            ops.emplace_back(CosOp(sCellIdx, problem.randomPinOffset(sCellIdx),
+                        midCellIdx, problem.randomPinOffset(midCellIdx), problem.randomPinOffset(midCellIdx),
+                        tCellIdx, problem.randomPinOffset(tCellIdx),
+                        problem.getLambdaFunc));
+        }
+    }
+    inline void build(std::vector<PowerWlOp> &ops, Problem &problem, IndexType numOps, IndexType size)
+    {
+        for (IndexType opIdx = 0; opIdx < numOps; ++opIdx)
+        {
+            ops.emplace_back(PowerWlOp(problem.getLambdaFunc));
+            for (IndexType pinIdx = 0; pinIdx < size; ++pinIdx)
+            {
+                IndexType cellIdx = problem.randomCell();
+                auto offset = problem.randomPinOffset(cellIdx);
+                ops.back().addVar(cellIdx, offset.x(), offset.y());
+            }
+            ops.back().setVirtualPin(0, problem.boundary.yLo());
+        }
+    }
+    template<typename OpType>
+    inline void buildRelational(std::vector<OpType> &ops, Problem &problem, IndexType numOps, Orient2DType orient)
+    {
+        for (IndexType opIdx = 0; opIdx < numOps; ++opIdx)
+        {
+            IndexType sCellIdx = problem.randomCell();
+            IndexType tCellIdx = problem.randomCell();
+            ops.emplace_back(OpType(sCellIdx, problem.randomOffset(sCellIdx, orient),
+                        tCellIdx, problem.randomOffset(tCellIdx, orient),
+                        problem.getLambdaFunc));
+            ops.back().setGetAlphaFunc(problem.getAlphaFunc);
+        }
+    }
+    inline void build(std::vector<VerOp> &ops, Problem &problem, IndexType numOps, IndexType)
+    {
+        buildRelational(ops, problem, numOps, Orient2DType::VERTICAL);
+    }
+    inline void build(std::vector<HorOp> &ops, Problem &problem, IndexType numOps, IndexType)
+    {
+        buildRelational(ops, problem, numOps, Orient2DType::HORIZONTAL);
+    }
+
+    /// @brief the operators of a benchmark run
+    template<typename OpType>
+    struct Fixture
+    {
+        explicit Fixture(const benchmark::State &state)
+            : problem(state.range(0))
+        {
+            ops.reserve(state.range(0));
+            build(ops, problem, state.range(0), state.range(1));
+            for (auto &op : ops)
+            {
+                bind(op, problem);
+            }
+            omp_set_num_threads(state.range(2));
+        }
+        Problem problem;
+        std::vector<OpType> ops;
+    };
+
+    /// @brief the vertical constraints of Fixture<VerOp> in one batch, reading the variables of the problem as the placer does
+    struct BatchFixture
+    {
+        explicit BatchFixture(const benchmark::State &state)
+            : fixture(state),
+              pl(fixture.problem.vars.data(), fixture.problem.vars.size()),
+              grad(fixture.problem.grads[0].data(), fixture.problem.grads[0].size())
+        {
+            const auto &problem = fixture.problem;
+            for (const auto &op : fixture.ops)
+            {
+                batch.addConstraint(problem.varIdx(op._sCellIdx, Orient2DType::VERTICAL), op._sOffset,
+                        problem.varIdx(op._tCellIdx, Orient2DType::VERTICAL), op._tOffset, op._weight);
+            }
+            batch.setGetAlphaFunc(problem.getAlphaFunc);
+            batch.setGetLambdaFunc(problem.getLambdaFunc);
+        }
+        Fixture<VerOp> fixture;
+        BatchOp batch;
+        VectorMap pl;
+        VectorMap grad;
+    };
+
+    inline void setCounters(benchmark::State &state)
+    {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["threads"] = state.range(2);
+    }
+}
+
+/// @brief evaluate the objective of all the operators
+template<typename OpType>
+static void BM_Evaluate(benchmark::State &state)
+{
+    BenchDifferentiableDetails::Fixture<OpType> fixture(state);
+    const auto &ops = fixture.ops;
+    for (auto _ : state)
+    {
+        RealType obj = 0;
+        #pragma omp parallel for schedule(static) reduction(+:obj)
+        for (IndexType opIdx = 0; opIdx < ops.size(); ++opIdx)
+        {
+            obj += diff::placement_differentiable_traits<OpType>::evaluate(ops[opIdx]);
+        }
+        benchmark::DoNotOptimize(obj);
+    }
+    BenchDifferentiableDetails::setCounters(state);
+}
+
+/// @brief accumulate the gradient of all the operators
+template<typename OpType>
+static void BM_Gradient(benchmark::State &state)
+{
+    BenchDifferentiableDetails::Fixture<OpType> fixture(state);
+    const auto &ops = fixture.ops;
+    for (auto _ : state)
+    {
+        #pragma omp parallel for schedule(static)
+        for (IndexType opIdx = 0; opIdx < ops.size(); ++opIdx)
+        {
+            diff::placement_differentiable_traits<OpType>::accumlateGradient(ops[opIdx]);
+        }
+        benchmark::ClobberMemory();
+    }
+    BenchDifferentiableDetails::setCounters(state);
+}
+
+/// @brief accumulate the Jacobi hessian approximation of all the operators
+template<typename OpType>
+static void BM_JacobiHessian(benchmark::State &state)
+{
+    BenchDifferentiableDetails::Fixture<OpType> fixture(state);
+    const auto &ops = fixture.ops;
+    auto &problem = fixture.problem;
+    const std::function<void(RealType, IndexType, IndexType, Orient2DType, Orient2DType)> accumulateHessianFunc =
+        [&problem](RealType value, IndexType idx, IndexType, Orient2DType orient, Orient2DType)
+        {
+            problem.hessians[omp_get_thread_num()][problem.varIdx(idx, orient)] += value;
+        };
+    for (auto _ : state)
+    {
+        #pragma omp parallel for schedule(static)
+        for (IndexType opIdx = 0; opIdx < ops.size(); ++opIdx)
+        {
+            diff::jacobi_hessian_approx_trait<OpType>::accumulateHessian(ops[opIdx], accumulateHessianFunc);
+        }
+        benchmark::ClobberMemory();
+    }
+    BenchDifferentiableDetails::setCounters(state);
+}
+
+/// @brief evaluate the objective of the batch of the vertical constraints
+static void BM_BatchEvaluate(benchmark::State &state)
+{
+    BenchDifferentiableDetails::BatchFixture fixture(state);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(fixture.batch.evaluate(fixture.pl));
+    }
+    BenchDifferentiableDetails::setCounters(state);
+}
+
+/// @brief accumulate the gradient of the batch of the vertical constraints
+static void BM_BatchGradient(benchmark::State &state)
+{
+    BenchDifferentiableDetails::BatchFixture fixture(state);
+    for (auto _ : state)
+    {
+        fixture.batch.accumulateGradient(fixture.pl, fixture.grad);
+        benchmark::ClobberMemory();
+    }
+    BenchDifferentiableDetails::setCounters(state);
+}
+
+/// @brief the arguments of the operators with a fixed size: number of operators, 1, number of threads
+static void fixedSizeArgs(benchmark::internal::Benchmark *bench)
+{
+    bench->ArgNames({"ops", "size", "threads"});
+    for (int64_t numOps : {1 << 8, 1 << 12, 1 << 16})
+    {
+        for (int64_t numThreads : {1, 2, 4, 8})
+        {
+            bench->Args({numOps, 1, numThreads});
+        }
+    }
+}
+
+/// @brief the arguments of the batches: number of constraints, 1, 1 thread
+static void batchArgs(benchmark::internal::Benchmark *bench)
+{
+    bench->ArgNames({"ops", "size", "threads"});
+    for (int64_t numOps : {1 << 8, 1 << 12, 1 << 16})
+    {
+        bench->Args({numOps, 1, 1});
+    }
+}
+
+/// @brief the arguments of the operators over a set of cells: number of operators, cells per operator, number of threads
+static void variableSizeArgs(benchmark::internal::Benchmark *bench)
+{
+    bench->ArgNames({"ops", "size", "threads"});
+    for (int64_t numOps : {1 << 8, 1 << 12, 1 << 16})
+    {
+        for (int64_t size : {2, 8, 32})
+        {
+            for (int64_t numThreads : {1, 2, 4, 8})
+            {
+                bench->Args({numOps, size, numThreads});
+            }
+        }
+    }
+}
+
+using namespace BenchDifferentiableDetails;
+
+#define IDEAPLACE_BENCH_OPERATOR(OpType, argsFunc) \
+    BENCHMARK_TEMPLATE(BM_Evaluate, OpType)->Apply(argsFunc)->UseRealTime(); \
+    BENCHMARK_TEMPLATE(BM_Gradient, OpType)->Apply(argsFunc)->UseRealTime();
+#define IDEAPLACE_BENCH_OPERATOR_WITH_HESSIAN(OpType, argsFunc) \
+    IDEAPLACE_BENCH_OPERATOR(OpType, argsFunc) \
+    BENCHMARK_TEMPLATE(BM_JacobiHessian, OpType)->Apply(argsFunc)->UseRealTime();
+
+IDEAPLACE_BENCH_OPERATOR_WITH_HESSIAN(HpwlOp, variableSizeArgs)
+IDEAPLACE_BENCH_OPERATOR_WITH_HESSIAN(OvlOp, fixedSizeArgs)
+IDEAPLACE_BENCH_OPERATOR_WITH_HESSIAN(OobOp, fixedSizeArgs)
+IDEAPLACE_BENCH_OPERATOR_WITH_HESSIAN(AsymOp, variableSizeArgs)
+IDEAPLACE_BENCH_OPERATOR_WITH_HESSIAN(CosOp, fixedSizeArgs)
+IDEAPLACE_BENCH_OPERATOR_WITH_HESSIAN(PowerWlOp, variableSizeArgs)
+// The relational constraints have no hessian approximation
+IDEAPLACE_BENCH_OPERATOR(VerOp, fixedSizeArgs)
+IDEAPLACE_BENCH_OPERATOR(HorOp, fixedSizeArgs)
+BENCHMARK(BM_BatchEvaluate)->Apply(batchArgs)->UseRealTime();
+BENCHMARK(BM_BatchGradient)->Apply(batchArgs)->UseRealTime();
+
+PROJECT_NAMESPACE_END
+
+BENCHMARK_MAIN();
@@ -0,0 +1,147 @@
+/**
+ * @file benchGdsBBox.cpp
+ * @brief Benchmark the direct polygon bounding box folding against the rectangle decomposition
+ * @date 10/17/2026
+ */
+
+#include <benchmark/benchmark.h>
+#include "parser/ParserGds.h"
+#include "util/Polygon2Rect.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace BenchGdsBBoxDetails
+{
+    constexpr IndexType NUM_LAYERS = 4; ///< diffusion, poly, metal1, contact
+    constexpr LocType FINGER_WIDTH = 40;
+    constexpr LocType FINGER_PITCH = 200;
+    constexpr LocType FINGER_LENGTH = 1000;
+    constexpr LocType BAR_HEIGHT = 100;
+    constexpr LocType CONTACT_SIZE = 60;
+
+    /// @brief a comb polygon: a horizontal bar with the fingers hanging downward
+    inline ParserCellGds::PolygonLayer comb(IndexType layer, LocType xLo, LocType yLo, IndexType numFingers)
+    {
+        ParserCellGds::PolygonLayer poly;
+        poly.layer = layer;
+        const LocType yTop = yLo + FINGER_LENGTH;
+        for (IndexType fingerIdx = 0; fingerIdx < numFingers; ++fingerIdx)
+        {
+            const LocType x = xLo + static_cast<LocType>(fingerIdx) * FINGER_PITCH;
+            poly.pts.emplace_back(XY<LocType>(x, yLo));
+            poly.pts.emplace_back(XY<LocType>(x + FINGER_WIDTH, yLo));
+            if (fingerIdx + 1 < numFingers)
+            {
+                poly.pts.emplace_back(XY<LocType>(x + FINGER_WIDTH, yTop));
+                poly.pts.emplace_back(XY<LocType>(x + FINGER_PITCH, yTop));
+            }
+        }
+        const LocType xHi = xLo + static_cast<LocType>(numFingers - 1) * FINGER_PITCH + FINGER_WIDTH;
+        poly.pts.emplace_back(XY<LocType>(xHi, yTop + BAR_HEIGHT));
+        poly.pts.emplace_back(XY<LocType>(xLo, yTop + BAR_HEIGHT));
+        return poly;
+    }
+
+    /// @brief a rectangle polygon
+    inline ParserCellGds::PolygonLayer rect(IndexType layer, LocType xLo, LocType yLo, LocType xHi, LocType yHi)
+    {
+        ParserCellGds::PolygonLayer poly;
+        poly.layer = layer;
+        poly.pts = { XY<LocType>(xLo, yLo), XY<LocType>(xHi, yLo), XY<LocType>(xHi, yHi), XY<LocType>(xLo, yHi) };
+        return poly;
+    }
+
+    /// @brief generate a dense array of multi-finger transistors
+    /// @param first: the number of transistors
+    /// @param second: the number of fingers per transistor
+    inline std::vector<ParserCellGds::PolygonLayer> denseTransistors(IndexType numTransistors, IndexType numFingers)
+    {
+        std::vector<ParserCellGds::PolygonLayer> polygons;
+        const LocType devWidth = static_cast<LocType>(numFingers + 1) * FINGER_PITCH;
+        const LocType devHeight = 2 * (FINGER_LENGTH + BAR_HEIGHT);
+        const IndexType numCols = static_cast<IndexType>(std::ceil(std::sqrt(static_cast<RealType>(numTransistors))));
+        for (IndexType devIdx = 0; devIdx < numTransistors; ++devIdx)
+        {
+            const LocType x = static_cast<LocType>(devIdx % numCols) * devWidth;
+            const LocType y = static_cast<LocType>(devIdx / numCols) * devHeight;
+            polygons.emplace_back(rect(0, x, y + BAR_HEIGHT, x + devWidth - FINGER_PITCH / 2, y + FINGER_LENGTH));
+            polygons.emplace_back(comb(1, x + FINGER_PITCH / 2, y, numFingers));
+            polygons.emplace_back(comb(2, x, y + FINGER_LENGTH + BAR_HEIGHT, numFingers + 1));
+            for (IndexType fingerIdx = 0; fingerIdx <= numFingers; ++fingerIdx)
+            {
+                const LocType cx = x + static_cast<LocType>(fingerIdx) * FINGER_PITCH;
+                for (LocType cy = y + 2 * BAR_HEIGHT; cy + CONTACT_SIZE < y + FINGER_LENGTH; cy += 2 * CONTACT_SIZE)
+                {
+                    polygons.emplace_back(rect(3, cx - CONTACT_SIZE / 2, cy, cx + CONTACT_SIZE / 2, cy + CONTACT_SIZE));
+                }
+            }
+        }
+        return polygons;
+    }
+
+    inline std::vector<Box<LocType>> emptyBBoxes()
+    {
+        return std::vector<Box<LocType>>(NUM_LAYERS, Box<LocType>(LOC_TYPE_MAX, LOC_TYPE_MAX, LOC_TYPE_MIN, LOC_TYPE_MIN));
+    }
+
+    /// @brief the previous approach of ParserCellGds::dumpToDb: decompose the polygons into rectangles
+    inline void decomposePolygonRects(const std::vector<ParserCellGds::PolygonLayer> &polygons, std::vector<std::pair<IndexType, Box<LocType>>> &rects)
+    {
+        std::vector<Box<LocType>> shapes;
+        for (const auto &poly : polygons)
+        {
+            shapes.clear();
+            ::klib::convertPolygon2Rects<LocType>(poly.pts, shapes);
+            for (const auto &shape : shapes)
+            {
+                rects.emplace_back(poly.layer, shape);
+            }
+        }
+    }
+}
+
+/// @brief the bounding box fast path used by ParserCellGds::dumpToDb
+static void BM_FoldPolygonBBoxes(benchmark::State &state)
+{
+    const auto polygons = BenchGdsBBoxDetails::denseTransistors(state.range(0), state.range(1));
+    for (auto _ : state)
+    {
+        auto bboxes = BenchGdsBBoxDetails::emptyBBoxes();
+        ParserCellGdsDetails::foldPolygonBBoxes(polygons, bboxes);
+        benchmark::DoNotOptimize(bboxes.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["polygons"] = polygons.size();
+    state.SetItemsProcessed(state.iterations() * polygons.size());
+}
+
+/// @brief the previous approach: decompose into rectangles and then union them
+static void BM_DecomposePolygonRects(benchmark::State &state)
+{
+    const auto polygons = BenchGdsBBoxDetails::denseTransistors(state.range(0), state.range(1));
+    std::vector<std::pair<IndexType, Box<LocType>>> rects;
+    for (auto _ : state)
+    {
+        auto bboxes = BenchGdsBBoxDetails::emptyBBoxes();
+        rects.clear();
+        BenchGdsBBoxDetails::decomposePolygonRects(polygons, rects);
+        for (const auto &rect : rects)
+        {
+            bboxes.at(rect.first).unionBox(rect.second);
+        }
+        benchmark::DoNotOptimize(bboxes.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["polygons"] = polygons.size();
+    state.counters["rects"] = rects.size();
+    state.SetItemsProcessed(state.iterations() * polygons.size());
+}
+
+/// Arguments: number of transistors, number of fingers per transistor
+#define BENCH_GDS_BBOX_ARGS ArgsProduct({{16, 128, 1024}, {4, 16}})->Unit(benchmark::kMicrosecond)
+BENCHMARK(BM_FoldPolygonBBoxes)->BENCH_GDS_BBOX_ARGS;
+BENCHMARK(BM_DecomposePolygonRects)->BENCH_GDS_BBOX_ARGS;
+
+PROJECT_NAMESPACE_END
+
+BENCHMARK_MAIN();
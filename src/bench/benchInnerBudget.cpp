@@ -0,0 +1,43 @@
+/**
+ * @file benchInnerBudget.cpp
+ * @brief Compare the fixed and the adaptive inner iteration budgets of the first order global placement
+ * @date 10/17/2026
+ */
+
+#include "bench/benchPlacement.h"
+
+/* The argument is the number of cells of the generated netlist. The time is of the global placement alone.
+ * The counters are from one more run with the convergence trace, which is not timed: the gradient evaluations of the inner iterations in the solve,
+ * the outer iterations and the HPWL of the result */
+
+PROJECT_NAMESPACE_BEGIN
+
+template<typename nlp_settings>
+static void BM_InnerBudget(benchmark::State &state)
+{
+    using namespace BenchPlacementDetails;
+    const auto &placement = problem(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Database db = placement;
+        state.ResumeTiming();
+        NlpGPlacerFirstOrder<nlp_settings> placer(db);
+        placer.solve();
+    }
+    Database db = placement;
+    ConvergenceTrace trace;
+    NlpGPlacerFirstOrder<nlp_settings> placer(db);
+    placer.setConvergenceTrace(&trace);
+    placer.solve();
+    state.counters["gradEvaluations"] = numInnerIterations(trace);
+    state.counters["outerIterations"] = trace.column(trace.columnIdx("outer")).back();
+    state.counters["hpwl"] = db.hpwl();
+}
+
+BENCHMARK_TEMPLATE(BM_InnerBudget, nlp::nlp_default_settings)->Apply(BenchPlacementDetails::numCellsArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_InnerBudget, nlp::nlp_adaptive_budget_settings)->Apply(BenchPlacementDetails::numCellsArgs)->Unit(benchmark::kMillisecond);
+
+PROJECT_NAMESPACE_END
+
+BENCHMARK_MAIN();
@@ -0,0 +1,234 @@
+/**
+ * @file benchLegalization.cpp
+ * @brief Benchmark the kernels of the constraint graph legalization on synthetic placements of growing size and density
+ * @date 10/17/2026
+ */
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include "db/NetlistGenerator.h"
+#include "place/CGLegalizer.h"
+
+/* The arguments are the number of cells and the density in percent, ie. the total cell area over the layout area. Above 100 the cells must overlap, as the global placement output.
+ * The edge counts are the counters. The kernels needing the constraint graphs are timed after the steps before them in CGLegalizer, which are excluded from the time */
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief the access to the private kernels of CGLegalizer and LpLegalizeSolver
+class LegalizationKernels
+{
+    public:
+        static void generateConstraints(CGLegalizer &legalizer) { legalizer.generateHorConstraints(); }
+        static void constructConstraintGraphs(CGLegalizer &legalizer) { legalizer.constructConstraintGraphs(); }
+        static void dagTransitiveReduction(CGLegalizer &legalizer)
+        {
+            legalizer.dagTransitiveReduction(legalizer._hCG);
+            legalizer.dagTransitiveReduction(legalizer._vCG);
+        }
+        static bool dagfyConstraintGraphs(CGLegalizer &legalizer) { return legalizer.dagfyConstraintGraphs(); }
+        static void getNecessaryEdges(CGLegalizer &legalizer) { legalizer.getNecessaryEdges(); }
+        static void legalize(CGLegalizer &legalizer)
+        {
+            legalizer.generateHorConstraints();
+            legalizer._wStar = legalizer.lpLegalization(true);
+            legalizer.generateVerConstraints();
+            legalizer._hStar = legalizer.lpLegalization(false);
+        }
+        static bool lpDetailedPlacement(CGLegalizer &legalizer) { return legalizer.lpDetailedPlacement(); }
+        static IndexType numConstraintEdges(const CGLegalizer &legalizer)
+        {
+            return legalizer._hConstraints.edges().size() + legalizer._vConstraints.edges().size();
+        }
+        static IndexType numGraphEdges(CGLegalizer &legalizer)
+        {
+            return boost::num_edges(legalizer._hCG.boostGraph()) + boost::num_edges(legalizer._vCG.boostGraph());
+        }
+        static Constraints & constraints(CGLegalizer &legalizer, bool isHor) { return isHor ? legalizer._hConstraints : legalizer._vConstraints; }
+        /// @brief build the LP model without solving it
+        static void buildLpModel(LpLegalizeSolver &solver)
+        {
+            solver.addIlpVars();
+            solver.addIlpConstraints();
+            solver.configureObjFunc();
+        }
+};
+
+namespace BenchLegalizationDetails
+{
+    /// @brief a generated netlist randomly placed with the density. Generated once for each size and density
+    inline const Database & placement(IndexType numCells, IndexType densityPercent)
+    {
+        static std::map<std::pair<IndexType, IndexType>, Database> cache;
+        auto findIter = cache.find(std::make_pair(numCells, densityPercent));
+        if (findIter != cache.end())
+        {
+            return findIter->second;
+        }
+        MsgPrinter::setMinMsgType(MsgType::WRN);
+        Database &db = cache[std::make_pair(numCells, densityPercent)];
+        if (!NetlistGenerator(numCells, 1).generate(db))
+        {
+            ERR("benchLegalization: cannot generate the netlist of %d cells \n", numCells);
+        }
+        const RealType side = std::sqrt(db.calculateTotalCellArea() * 100 / densityPercent);
+        std::mt19937 rng(numCells + densityPercent);
+        for (IndexType cellIdx = 0; cellIdx < db.numCells(); ++cellIdx)
+        {
+            auto &cell = db.cell(cellIdx);
+            std::uniform_real_distribution<RealType> x(0, std::max(side - cell.cellBBox().xLen(), 1.0));
+            std::uniform_real_distribution<RealType> y(0, std::max(side - cell.cellBBox().yLen(), 1.0));
+            cell.setXLo(static_cast<LocType>(x(rng)));
+            cell.setYLo(static_cast<LocType>(y(rng)));
+        }
+        return db;
+    }
+}
+
+/// @brief the sweep line generating the horizontal and vertical constraint edges
+static void BM_SweeplineConstraints(benchmark::State &state)
+{
+    Database db = BenchLegalizationDetails::placement(state.range(0), state.range(1));
+    CGLegalizer legalizer(db);
+    for (auto _ : state)
+    {
+        LegalizationKernels::generateConstraints(legalizer);
+    }
+    state.counters["edges"] = LegalizationKernels::numConstraintEdges(legalizer);
+}
+
+/// @brief the transitive reduction of the two constraint graphs from the sweep line
+static void BM_DagTransitiveReduction(benchmark::State &state)
+{
+    Database db = BenchLegalizationDetails::placement(state.range(0), state.range(1));
+    CGLegalizer legalizer(db);
+    IndexType numEdgesBefore = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        LegalizationKernels::generateConstraints(legalizer);
+        LegalizationKernels::constructConstraintGraphs(legalizer);
+        numEdgesBefore = LegalizationKernels::numGraphEdges(legalizer);
+        state.ResumeTiming();
+        LegalizationKernels::dagTransitiveReduction(legalizer);
+    }
+    state.counters["edges"] = numEdgesBefore;
+    state.counters["removedEdges"] = numEdgesBefore - LegalizationKernels::numGraphEdges(legalizer);
+}
+
+/// @brief removing the cycles of the two reduced constraint graphs
+static void BM_DagfyConstraintGraphs(benchmark::State &state)
+{
+    Database db = BenchLegalizationDetails::placement(state.range(0), state.range(1));
+    CGLegalizer legalizer(db);
+    IndexType numEdgesBefore = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        LegalizationKernels::generateConstraints(legalizer);
+        LegalizationKernels::constructConstraintGraphs(legalizer);
+        LegalizationKernels::dagTransitiveReduction(legalizer);
+        numEdgesBefore = LegalizationKernels::numGraphEdges(legalizer);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(LegalizationKernels::dagfyConstraintGraphs(legalizer));
+    }
+    state.counters["edges"] = numEdgesBefore;
+    state.counters["changedEdges"] = std::abs(static_cast<RealType>(LegalizationKernels::numGraphEdges(legalizer)) - numEdgesBefore);
+}
+
+/// @brief adding the edges between the cell pairs not yet constrained in either direction
+static void BM_GetNecessaryEdges(benchmark::State &state)
+{
+    Database db = BenchLegalizationDetails::placement(state.range(0), state.range(1));
+    CGLegalizer legalizer(db);
+    IndexType numEdgesBefore = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        LegalizationKernels::generateConstraints(legalizer);
+        LegalizationKernels::constructConstraintGraphs(legalizer);
+        LegalizationKernels::dagTransitiveReduction(legalizer);
+        LegalizationKernels::dagfyConstraintGraphs(legalizer);
+        numEdgesBefore = LegalizationKernels::numGraphEdges(legalizer);
+        state.ResumeTiming();
+        LegalizationKernels::getNecessaryEdges(legalizer);
+    }
+    state.counters["edges"] = numEdgesBefore;
+    state.counters["addedEdges"] = LegalizationKernels::numGraphEdges(legalizer) - numEdgesBefore;
+}
+
+/// @brief building the variables, constraints and objective of the horizontal and vertical legalization LPs, without solving
+static void BM_LpModelConstruction(benchmark::State &state)
+{
+    Database db = BenchLegalizationDetails::placement(state.range(0), state.range(1));
+    CGLegalizer legalizer(db);
+    LegalizationKernels::generateConstraints(legalizer);
+    for (auto _ : state)
+    {
+        LpLegalizeSolver horSolver(db, LegalizationKernels::constraints(legalizer, true), true);
+        LegalizationKernels::buildLpModel(horSolver);
+        LpLegalizeSolver verSolver(db, LegalizationKernels::constraints(legalizer, false), false);
+        LegalizationKernels::buildLpModel(verSolver);
+    }
+    state.counters["edges"] = LegalizationKernels::numConstraintEdges(legalizer);
+}
+
+/// @brief one pass of the LP detailed placement. The third argument is the pass, as CGLegalizer runs two, each starting from the result of the one before
+static void BM_LpDetailedPlacement(benchmark::State &state)
+{
+    const auto &placement = BenchLegalizationDetails::placement(state.range(0), state.range(1));
+    IndexType numEdges = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Database db = placement;
+        CGLegalizer legalizer(db);
+        LegalizationKernels::legalize(legalizer);
+        for (IndexType passIdx = 1; passIdx < state.range(2); ++passIdx)
+        {
+            LegalizationKernels::lpDetailedPlacement(legalizer);
+        }
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(LegalizationKernels::lpDetailedPlacement(legalizer));
+        numEdges = LegalizationKernels::numConstraintEdges(legalizer);
+    }
+    state.counters["edges"] = numEdges;
+}
+
+/// @brief the arguments: number of cells and density in percent
+static void placementArgs(benchmark::internal::Benchmark *bench)
+{
+    bench->ArgNames({"cells", "density"});
+    for (int64_t numCells : {200, 500, 1000})
+    {
+        for (int64_t densityPercent : {50, 100, 200})
+        {
+            bench->Args({numCells, densityPercent});
+        }
+    }
+}
+
+/// @brief the arguments: number of cells, density in percent and the detailed placement pass
+static void detailedPlacementArgs(benchmark::internal::Benchmark *bench)
+{
+    bench->ArgNames({"cells", "density", "pass"});
+    for (int64_t numCells : {200, 500, 1000})
+    {
+        for (int64_t densityPercent : {50, 100, 200})
+        {
+            bench->Args({numCells, densityPercent, 1});
+            bench->Args({numCells, densityPercent, 2});
+        }
+    }
+}
+
+BENCHMARK(BM_SweeplineConstraints)->Apply(placementArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DagTransitiveReduction)->Apply(placementArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DagfyConstraintGraphs)->Apply(placementArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GetNecessaryEdges)->Apply(placementArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LpModelConstruction)->Apply(placementArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LpDetailedPlacement)->Apply(detailedPlacementArgs)->Unit(benchmark::kMillisecond);
+
+PROJECT_NAMESPACE_END
+
+BENCHMARK_MAIN();
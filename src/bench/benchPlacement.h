@@ -0,0 +1,57 @@
+/**
+ * @file benchPlacement.h
+ * @brief The problems and the helpers shared by the global placement benchmarks
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_BENCH_PLACEMENT_H_
+#define IDEAPLACE_BENCH_PLACEMENT_H_
+
+#include <benchmark/benchmark.h>
+#include "db/NetlistGenerator.h"
+#include "place/NlpGPlacer.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace BenchPlacementDetails
+{
+    /// @brief a generated netlist prepared as IdeaPlaceEx does before the global placement. Generated once for each size
+    inline const Database & problem(IndexType numCells)
+    {
+        static std::map<IndexType, Database> cache;
+        auto findIter = cache.find(numCells);
+        if (findIter != cache.end())
+        {
+            return findIter->second;
+        }
+        MsgPrinter::setMinMsgType(MsgType::WRN);
+        Database &db = cache[numCells];
+        if (!NetlistGenerator(numCells, 1).generate(db))
+        {
+            ERR("benchPlacement: cannot generate the netlist of %d cells \n", numCells);
+        }
+        db.splitSignalPathsBySymPairs();
+        return db;
+    }
+
+    /// @brief the number of inner iterations in a convergence trace, one gradient evaluation each. The rows at the start of the outer iterations are not counted
+    inline IndexType numInnerIterations(const ConvergenceTrace &trace)
+    {
+        const auto &inner = trace.column(trace.columnIdx("inner"));
+        return std::count_if(inner.begin(), inner.end(), [](RealType iter) { return iter > 0; });
+    }
+
+    /// @brief the arguments: the number of cells. The global placer keeps the partials of an operator in arrays of IDEAPLACE_DEFAULT_MAX_NUM_CELLS
+    inline void numCellsArgs(benchmark::internal::Benchmark *bench)
+    {
+        bench->ArgNames({"cells"});
+        for (int64_t numCells : {20, 50, 80})
+        {
+            bench->Args({numCells});
+        }
+    }
+}
+
+PROJECT_NAMESPACE_END
+
+#endif // IDEAPLACE_BENCH_PLACEMENT_H_
@@ -0,0 +1,132 @@
+/**
+ * @file benchSnapshot.cpp
+ * @brief Benchmark saving and loading the binary database snapshot on generated large designs
+ * @date 10/17/2026
+ */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <random>
+#include "db/DatabaseSnapshot.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace BenchSnapshotDetails
+{
+    constexpr IndexType NUM_LAYERS = 4;
+    constexpr IndexType NUM_PINS_PER_CELL = 4;
+    constexpr IndexType NUM_PINS_PER_NET = 4;
+
+    /// @brief generate a database with the given number of cells
+    inline void generate(Database &db, IndexType numCells)
+    {
+        std::mt19937 rng(numCells);
+        std::uniform_int_distribution<LocType> coord(0, 10000);
+        for (IndexType layer = 0; layer < NUM_LAYERS; ++layer)
+        {
+            db.tech().addGdsLayer(layer + 1);
+        }
+        db.tech().initRuleDataStructure();
+        for (IndexType cellIdx = 0; cellIdx < numCells; ++cellIdx)
+        {
+            db.allocateCell();
+            db.setCellName(cellIdx, "M" + std::to_string(cellIdx));
+            db.initCell(cellIdx);
+            for (IndexType layer = 0; layer < NUM_LAYERS; ++layer)
+            {
+                LocType x = coord(rng);
+                LocType y = coord(rng);
+                db.cell(cellIdx).unionBBox(layer, Box<LocType>(x, y, x + 200, y + 200));
+            }
+            db.cell(cellIdx).calculateCellBBox();
+            for (IndexType idx = 0; idx < NUM_PINS_PER_CELL; ++idx)
+            {
+                IndexType pinIdx = db.allocatePin();
+                db.setPinName(pinIdx, "P" + std::to_string(idx));
+                db.pin(pinIdx).setCellIdx(cellIdx);
+                db.pin(pinIdx).shape() = Box<LocType>(0, 0, 20, 20);
+                db.addPinToCell(cellIdx, pinIdx);
+            }
+        }
+        std::uniform_int_distribution<IndexType> pinDist(0, db.numPins() - 1);
+        for (IndexType netIdx = 0; netIdx < db.numPins() / NUM_PINS_PER_NET; ++netIdx)
+        {
+            db.allocateNet();
+            db.setNetName(netIdx, "net" + std::to_string(netIdx));
+            for (IndexType idx = 0; idx < NUM_PINS_PER_NET; ++idx)
+            {
+                IndexType pinIdx = pinDist(rng);
+                db.net(netIdx).addPin(pinIdx);
+                db.pin(pinIdx).addNetIdx(netIdx);
+            }
+        }
+        for (IndexType cellIdx = 0; cellIdx + 1 < numCells; cellIdx += 16)
+        {
+            IndexType symGrpIdx = db.allocateSymGrp();
+            db.symGroup(symGrpIdx).addSymPair(cellIdx, cellIdx + 1);
+        }
+    }
+
+    /// @brief the snapshot of the generated database. Generated once for each size
+    inline const std::string & snapshotFile(IndexType numCells)
+    {
+        static std::unordered_map<IndexType, std::string> cache;
+        auto findIter = cache.find(numCells);
+        if (findIter != cache.end())
+        {
+            return findIter->second;
+        }
+        auto filename = (std::filesystem::temp_directory_path() / ("ideaplace_bench_" + std::to_string(numCells) + ".snapshot")).string();
+        Database db;
+        generate(db, numCells);
+        DatabaseSnapshot(db).save(filename);
+        return cache.emplace(numCells, filename).first->second;
+    }
+}
+
+/// @brief write the snapshot
+static void BM_SaveSnapshot(benchmark::State &state)
+{
+    Database db;
+    BenchSnapshotDetails::generate(db, state.range(0));
+    auto filename = (std::filesystem::temp_directory_path() / "ideaplace_bench_save.snapshot").string();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(DatabaseSnapshot(db).save(filename));
+    }
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(filename));
+}
+
+/// @brief read the snapshot into an empty database
+static void BM_LoadSnapshot(benchmark::State &state)
+{
+    const auto &filename = BenchSnapshotDetails::snapshotFile(state.range(0));
+    for (auto _ : state)
+    {
+        Database db;
+        benchmark::DoNotOptimize(DatabaseSnapshot(db).load(filename));
+        benchmark::DoNotOptimize(db.numCells());
+    }
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(filename));
+}
+
+/// @brief copy the database in memory, as the reference of the loading
+static void BM_CopyDatabase(benchmark::State &state)
+{
+    Database db;
+    BenchSnapshotDetails::generate(db, state.range(0));
+    for (auto _ : state)
+    {
+        Database copy = db;
+        benchmark::DoNotOptimize(copy.numCells());
+    }
+}
+
+/// Argument: number of cells
+BENCHMARK(BM_SaveSnapshot)->RangeMultiplier(8)->Range(1 << 9, 1 << 15)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadSnapshot)->RangeMultiplier(8)->Range(1 << 9, 1 << 15)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CopyDatabase)->RangeMultiplier(8)->Range(1 << 9, 1 << 15)->Unit(benchmark::kMillisecond);
+
+PROJECT_NAMESPACE_END
+
+BENCHMARK_MAIN();
@@ -0,0 +1,166 @@
+/**
+ * @file benchTextParser.cpp
+ * @brief Benchmark the text parsers on generated large .pin and .connection files
+ * @date 10/17/2026
+ */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <random>
+#include "parser/ParserPin.h"
+#include "parser/ParserConnection.h"
+#include "util/MmapTokenizer.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace BenchTextParserDetails
+{
+    constexpr IndexType NUM_PINS_PER_CELL = 4;
+    constexpr IndexType NUM_SHAPES_PER_PIN = 2;
+    constexpr IndexType NUM_PINS_PER_NET = 4;
+
+    /// @brief generated .pin and .connection files for a number of cells
+    struct GeneratedFiles
+    {
+        std::string pinFile;
+        std::string connectionFile;
+    };
+
+    inline std::string cellName(IndexType cellIdx) { return "M" + std::to_string(cellIdx); }
+    inline std::string pinName(IndexType pinIdx) { return "P" + std::to_string(pinIdx); }
+
+    /// @brief generate the files once for each size, and reuse them for the following runs
+    inline const GeneratedFiles & generate(IndexType numCells)
+    {
+        static std::unordered_map<IndexType, GeneratedFiles> cache;
+        auto findIter = cache.find(numCells);
+        if (findIter != cache.end())
+        {
+            return findIter->second;
+        }
+        auto dir = std::filesystem::temp_directory_path();
+        GeneratedFiles files;
+        files.pinFile = (dir / ("ideaplace_bench_" + std::to_string(numCells) + ".pin")).string();
+        files.connectionFile = (dir / ("ideaplace_bench_" + std::to_string(numCells) + ".connection")).string();
+        std::mt19937 rng(numCells);
+        std::uniform_real_distribution<RealType> coord(0.0, 10.0);
+        {
+            std::ofstream out(files.pinFile);
+            out.precision(4);
+            out << std::fixed;
+            for (IndexType cellIdx = 0; cellIdx < numCells; ++cellIdx)
+            {
+                out << cellName(cellIdx) << "\n";
+                for (IndexType pinIdx = 0; pinIdx < NUM_PINS_PER_CELL; ++pinIdx)
+                {
+                    out << pinName(pinIdx) << " " << NUM_SHAPES_PER_PIN << "\n";
+                    for (IndexType shapeIdx = 0; shapeIdx < NUM_SHAPES_PER_PIN; ++shapeIdx)
+                    {
+                        RealType xLo = coord(rng);
+                        RealType yLo = coord(rng);
+                        out << shapeIdx + 1 << " (" << xLo << ", " << yLo << ") (" << xLo + 0.2 << ", " << yLo + 0.2 << ") ";
+                    }
+                    out << "\n";
+                }
+            }
+        }
+        {
+            std::ofstream out(files.connectionFile);
+            std::uniform_int_distribution<IndexType> cellDist(0, numCells - 1);
+            std::uniform_int_distribution<IndexType> pinDist(0, NUM_PINS_PER_CELL - 1);
+            const IndexType numNets = numCells * NUM_PINS_PER_CELL / NUM_PINS_PER_NET;
+            for (IndexType netIdx = 0; netIdx < numNets; ++netIdx)
+            {
+                out << "net" << netIdx;
+                for (IndexType idx = 0; idx < NUM_PINS_PER_NET; ++idx)
+                {
+                    out << " " << cellName(cellDist(rng)) << " " << pinName(pinDist(rng));
+                }
+                out << "\n";
+            }
+        }
+        return cache.emplace(numCells, files).first->second;
+    }
+}
+
+/// @brief the previous tokenization: std::getline + std::istringstream into std::vector<std::string>
+static void BM_TokenizeIstream(benchmark::State &state)
+{
+    const auto &files = BenchTextParserDetails::generate(state.range(0));
+    for (auto _ : state)
+    {
+        std::ifstream inf(files.pinFile.c_str());
+        std::string line;
+        IndexType numWords = 0;
+        while (std::getline(inf, line))
+        {
+            std::vector<std::string> words;
+            std::istringstream iss(line);
+            for (std::string str; iss >> str; )
+            {
+                words.emplace_back(str);
+            }
+            numWords += words.size();
+        }
+        benchmark::DoNotOptimize(numWords);
+    }
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(files.pinFile));
+}
+
+/// @brief the memory-mapped tokenizer
+static void BM_TokenizeMmap(benchmark::State &state)
+{
+    const auto &files = BenchTextParserDetails::generate(state.range(0));
+    for (auto _ : state)
+    {
+        ::klib::MmapFile file;
+        file.open(files.pinFile);
+        ::klib::LineTokenizer tokenizer(file.content());
+        IndexType numWords = 0;
+        while (tokenizer.nextLine())
+        {
+            numWords += tokenizer.numFields();
+        }
+        benchmark::DoNotOptimize(numWords);
+    }
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(files.pinFile));
+}
+
+/// @brief parsing the .pin file into the database
+static void BM_ParsePin(benchmark::State &state)
+{
+    const auto &files = BenchTextParserDetails::generate(state.range(0));
+    for (auto _ : state)
+    {
+        Database db;
+        ParserPin(db).read(files.pinFile);
+        benchmark::DoNotOptimize(db.numCells());
+    }
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(files.pinFile));
+}
+
+/// @brief parsing the .connection file into the database. The .pin file is read outside the timing
+static void BM_ParseConnection(benchmark::State &state)
+{
+    const auto &files = BenchTextParserDetails::generate(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Database db;
+        ParserPin(db).read(files.pinFile);
+        state.ResumeTiming();
+        ParserConnection(db).read(files.connectionFile);
+        benchmark::DoNotOptimize(db.numNets());
+    }
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(files.connectionFile));
+}
+
+/// Argument: number of cells
+BENCHMARK(BM_TokenizeIstream)->RangeMultiplier(8)->Range(1 << 9, 1 << 15)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TokenizeMmap)->RangeMultiplier(8)->Range(1 << 9, 1 << 15)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParsePin)->RangeMultiplier(8)->Range(1 << 9, 1 << 15)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParseConnection)->RangeMultiplier(8)->Range(1 << 9, 1 << 15)->Unit(benchmark::kMillisecond);
+
+PROJECT_NAMESPACE_END
+
+BENCHMARK_MAIN();
@@ -0,0 +1,42 @@
+/**
+ * @file benchWirelengthModel.cpp
+ * @brief Compare the LSE and the weighted-average wirelength in the first order global placement
+ * @date 10/17/2026
+ */
+
+#include "bench/benchPlacement.h"
+
+/* The argument is the number of cells of the generated netlist. The time is of the global placement alone.
+ * The counters are from one more run with the convergence trace, which is not timed: the outer and inner iterations to converge, and the HPWL of the result */
+
+PROJECT_NAMESPACE_BEGIN
+
+template<typename nlp_settings>
+static void BM_GlobalPlacement(benchmark::State &state)
+{
+    using namespace BenchPlacementDetails;
+    const auto &placement = problem(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Database db = placement;
+        state.ResumeTiming();
+        NlpGPlacerFirstOrder<nlp_settings> placer(db);
+        placer.solve();
+    }
+    Database db = placement;
+    ConvergenceTrace trace;
+    NlpGPlacerFirstOrder<nlp_settings> placer(db);
+    placer.setConvergenceTrace(&trace);
+    placer.solve();
+    state.counters["outerIterations"] = trace.column(trace.columnIdx("outer")).back();
+    state.counters["innerIterations"] = numInnerIterations(trace);
+    state.counters["hpwl"] = db.hpwl();
+}
+
+BENCHMARK_TEMPLATE(BM_GlobalPlacement, nlp::nlp_default_settings)->Apply(BenchPlacementDetails::numCellsArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GlobalPlacement, nlp::nlp_wa_settings)->Apply(BenchPlacementDetails::numCellsArgs)->Unit(benchmark::kMillisecond);
+
+PROJECT_NAMESPACE_END
+
+BENCHMARK_MAIN();
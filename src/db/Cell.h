@@ -175,6 +175,7 @@ class Cell
         IndexType symNetIdx() const {return _symNetIdx; }
 
     private:
+        friend class DatabaseSnapshot;
         std::string _name; ///< The cell name
         XY<LocType> _loc; ///< The location of the cell
         std::vector<IndexType> _pinIdxArray; ///< The index to the pins belonging to the cell
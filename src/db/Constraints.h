@@ -80,6 +80,7 @@ class SymGroup
         const std::vector<SymPair> & vSymPairs() const { return _symPairs; }
         const std::vector<IndexType> & vSelfSyms() const { return _selfSyms; }
     private:
+        friend class DatabaseSnapshot;
         std::vector<SymPair> _symPairs; ///< The symmetric pairs
         std::vector<IndexType> _selfSyms; ///< The self symmetric cells
 };
@@ -103,6 +104,7 @@ class ProximityGroup
       IntType weight() const { return _weight; }
 
     private:
+      friend class DatabaseSnapshot;
       std::vector<IndexType> _cells; ///< The cells belonging to this proximity group
       IntType _weight; ///< The weight of this proximity group
 };
@@ -124,6 +126,7 @@ class SignalPath
             this->_isPower = other._isPower;
         }
     private:
+        friend class DatabaseSnapshot;
         std::vector<IndexType> _pinIdxArray; ///< The indices of pins composing the path
         BoolType _isPower = false;
 };
@@ -22,6 +22,164 @@ bool Database::initCell(IndexType cellIdx)
     return true;
 }
 
+/*------------------------------*/ 
+/* Name look up                 */
+/*------------------------------*/ 
+void Database::buildCellNameIdx(bool fromScratch) const
+{
+    if (fromScratch)
+    {
+        _cellNameIdx.map.clear();
+        _cellNameIdx.size = 0;
+    }
+    _cellNameIdx.map.reserve(_cellArray.size());
+    for (IndexType cellIdx = _cellNameIdx.size; cellIdx < _cellArray.size(); ++cellIdx)
+    {
+        // Keep the first one for the duplicated names
+        _cellNameIdx.map.emplace(_cellArray[cellIdx].name(), cellIdx);
+    }
+    _cellNameIdx.size = _cellArray.size();
+    _cellNameIdx.isStale = false;
+}
+
+void Database::buildPinNameIdx() const
+{
+    _pinNameIdx.map.clear();
+    _pinNameIdx.map.resize(_cellArray.size());
+    for (IndexType cellIdx = 0; cellIdx < _cellArray.size(); ++cellIdx)
+    {
+        this->buildCellPinNameIdx(cellIdx);
+    }
+    _pinNameIdx.size = _pinArray.size();
+    _pinNameIdx.isStale = false;
+}
+
+void Database::buildCellPinNameIdx(IndexType cellIdx) const
+{
+    const auto &cell = _cellArray.at(cellIdx);
+    auto &pinMap = _pinNameIdx.map.at(cellIdx);
+    pinMap.clear();
+    pinMap.reserve(cell.numPinIdx());
+    for (IndexType idx = 0; idx < cell.numPinIdx(); ++idx)
+    {
+        pinMap.emplace(_pinArray.at(cell.pinIdx(idx)).name(), cell.pinIdx(idx));
+    }
+}
+
+void Database::buildNetNameIdx(bool fromScratch) const
+{
+    if (fromScratch)
+    {
+        _netNameIdx.map.clear();
+        _netNameIdx.size = 0;
+    }
+    _netNameIdx.map.reserve(_netArray.size());
+    for (IndexType netIdx = _netNameIdx.size; netIdx < _netArray.size(); ++netIdx)
+    {
+        _netNameIdx.map.emplace(_netArray[netIdx].name(), netIdx);
+    }
+    _netNameIdx.size = _netArray.size();
+    _netNameIdx.isStale = false;
+}
+
+IndexType Database::cellIdxByName(std::string_view cellName) const
+{
+    const std::string name(cellName);
+    for (IntType trial = 0; trial < 2; ++trial)
+    {
+        if (trial > 0 || _cellNameIdx.isStale || _cellNameIdx.size > _cellArray.size())
+        {
+            this->buildCellNameIdx(true);
+        }
+        else if (_cellNameIdx.size < _cellArray.size())
+        {
+            this->buildCellNameIdx(false);
+        }
+        auto findIter = _cellNameIdx.map.find(name);
+        if (findIter == _cellNameIdx.map.end())
+        {
+            return INDEX_TYPE_MAX;
+        }
+        // The cell might have been renamed without notifying the database
+        if (_cellArray[findIter->second].name() == name)
+        {
+            return findIter->second;
+        }
+    }
+    return INDEX_TYPE_MAX;
+}
+
+IndexType Database::pinIdxByName(IndexType cellIdx, std::string_view pinName) const
+{
+    const std::string name(pinName);
+    if (_pinNameIdx.isStale || _pinNameIdx.map.size() != _cellArray.size())
+    {
+        this->buildPinNameIdx();
+    }
+    for (IntType trial = 0; trial < 2; ++trial)
+    {
+        if (trial > 0)
+        {
+            this->buildCellPinNameIdx(cellIdx);
+        }
+        const auto &pinMap = _pinNameIdx.map.at(cellIdx);
+        auto findIter = pinMap.find(name);
+        if (findIter == pinMap.end())
+        {
+            // Only the pins attached with Cell::addPin are not indexed. Otherwise the pin does not exist
+            if (pinMap.size() >= _cellArray[cellIdx].numPinIdx())
+            {
+                return INDEX_TYPE_MAX;
+            }
+            continue;
+        }
+        // The pin might have been renamed without notifying the database
+        if (_pinArray[findIter->second].name() == name)
+        {
+            return findIter->second;
+        }
+    }
+    return INDEX_TYPE_MAX;
+}
+
+void Database::addPinToCell(IndexType cellIdx, IndexType pinIdx)
+{
+    _cellArray.at(cellIdx).addPin(pinIdx);
+    // Index the pin in place if the index is up to date, instead of rebuilding it for every appended pin
+    if (!_pinNameIdx.isStale && cellIdx < _pinNameIdx.map.size())
+    {
+        _pinNameIdx.map[cellIdx].emplace(_pinArray.at(pinIdx).name(), pinIdx);
+        // So that naming the pin afterward marks the index stale
+        _pinNameIdx.size = std::max(_pinNameIdx.size, pinIdx + 1);
+    }
+}
+
+IndexType Database::netIdxByName(std::string_view netName) const
+{
+    const std::string name(netName);
+    for (IntType trial = 0; trial < 2; ++trial)
+    {
+        if (trial > 0 || _netNameIdx.isStale || _netNameIdx.size > _netArray.size())
+        {
+            this->buildNetNameIdx(true);
+        }
+        else if (_netNameIdx.size < _netArray.size())
+        {
+            this->buildNetNameIdx(false);
+        }
+        auto findIter = _netNameIdx.map.find(name);
+        if (findIter == _netNameIdx.map.end())
+        {
+            return INDEX_TYPE_MAX;
+        }
+        if (_netArray[findIter->second].name() == name)
+        {
+            return findIter->second;
+        }
+    }
+    return INDEX_TYPE_MAX;
+}
+
 LocType Database::hpwl() const
 {
     LocType hpwl = 0;
@@ -165,6 +323,57 @@ bool Database::checkSym()
     return true;
 }
 
+IndexType Database::numSymViolations() const
+{
+    LocType axis = LOC_TYPE_MIN;
+    for (const auto &symGrp : _symGroups)
+    {
+        if (symGrp.numSymPairs() > 0)
+        {
+            const auto &symPair = symGrp.symPair(0);
+            axis = (cell(symPair.firstCell()).xCenter() + cell(symPair.secondCell()).xCenter()) / 2;
+            break;
+        }
+    }
+    IndexType numViolations = 0;
+    for (const auto &symGrp : _symGroups)
+    {
+        for (IndexType symPairIdx = 0; symPairIdx < symGrp.numSymPairs(); ++symPairIdx)
+        {
+            const auto &symPair = symGrp.symPair(symPairIdx);
+            const auto &cell1 = cell(symPair.firstCell());
+            const auto &cell2 = cell(symPair.secondCell());
+            if ((cell1.xCenter() + cell2.xCenter()) / 2 != axis or cell1.yLoc() != cell2.yLoc())
+            {
+                ++numViolations;
+            }
+        }
+        for (IndexType ssIdx = 0; ssIdx < symGrp.numSelfSyms(); ++ssIdx)
+        {
+            // Without any pair, the first self-symmetric cell decides the axis
+            if (axis == LOC_TYPE_MIN)
+            {
+                axis = cell(symGrp.selfSym(ssIdx)).xCenter();
+            }
+            if (cell(symGrp.selfSym(ssIdx)).xCenter() != axis)
+            {
+                ++numViolations;
+            }
+        }
+    }
+    return numViolations;
+}
+
+Box<LocType> Database::placementBBox() const
+{
+    Box<LocType> bbox(LOC_TYPE_MAX, LOC_TYPE_MAX, LOC_TYPE_MIN, LOC_TYPE_MIN);
+    for (const auto &cell : _cellArray)
+    {
+        bbox.unionBox(cell.cellBBoxOff());
+    }
+    return bbox;
+}
+
 /*------------------------------*/ 
 /* Debug functions              */
 /*------------------------------*/ 
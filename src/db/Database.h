@@ -8,6 +8,8 @@
 #ifndef IDEAPLACE_DATABASE_H_
 #define IDEAPLACE_DATABASE_H_
 
+#include <string_view>
+#include <unordered_map>
 #include "Cell.h"
 #include "Net.h"
 #include "Pin.h"
@@ -88,7 +90,7 @@ class Database
         /// @brief set name of cell
         /// @param first: cellIdx
         /// @param second: cellName
-        void setCellName(IndexType cellIdx, const std::string name) { _cellArray.at(cellIdx).setName(name); }
+        void setCellName(IndexType cellIdx, const std::string name) { _cellArray.at(cellIdx).setName(name); _cellNameIdx.markRenamed(cellIdx); }
         /// @brief get the number of nets
         /// @param the index of the nets
         /// @return the net of the index
@@ -104,6 +106,10 @@ class Database
         /// @brief allocate a new net in the array
         /// @return index of the new net
         IndexType allocateNet() { _netArray.emplace_back(Net()); return _netArray.size() -1; }
+        /// @brief set name of net
+        /// @param first: netIdx
+        /// @param second: netName
+        void setNetName(IndexType netIdx, const std::string &name) { _netArray.at(netIdx).setName(name); _netNameIdx.markRenamed(netIdx); }
         const std::vector<Net> & nets() const { return _netArray; }
         std::vector<Net> & nets() { return _netArray; }
         /// @brief get the number of pins
@@ -120,6 +126,14 @@ class Database
         /// @brief allocate a new pin in the array
         /// @return the index of the pin
         IndexType allocatePin() { _pinArray.emplace_back(Pin()); return _pinArray.size() - 1; }
+        /// @brief set name of pin
+        /// @param first: pinIdx
+        /// @param second: pinName
+        void setPinName(IndexType pinIdx, const std::string &name) { _pinArray.at(pinIdx).setName(name); _pinNameIdx.markRenamed(pinIdx); }
+        /// @brief attach a pin to a cell, and index it for pinIdxByName
+        /// @param first: the index of the cell
+        /// @param second: the index of the pin
+        void addPinToCell(IndexType cellIdx, IndexType pinIdx);
         const std::vector<Pin> & vPinArray() const { return _pinArray; }
         std::vector<Pin> &vPinArray() { return _pinArray; }
         /// @brief get the vector of proximity groups
@@ -147,27 +161,9 @@ class Database
         void addPinToSignalPath(IndexType pathIdx, const std::string & cellName, const std::string & pinName)
         {
             auto & sig = this->signalPath(pathIdx);
-            IndexType pinIdx = INDEX_TYPE_MAX;
-            IndexType cellIdx = INDEX_TYPE_MAX;
-            for (IndexType idx = 0; idx < this->numCells(); ++idx)
-            {
-                const auto & cell = this->cell(idx);
-                if (cell.name() == cellName)
-                {
-                    cellIdx = idx;
-                    for (IndexType jdx = 0; jdx < cell.numPinIdx(); ++jdx)
-                    {
-                        const auto &pin = this->pin(cell.pinIdx(jdx));
-                        if (pin.name() == pinName)
-                        {
-                            pinIdx = cell.pinIdx(jdx);
-                            break;
-                        }
-                    }
-                    break;
-                }
-            }
+            IndexType cellIdx = this->cellIdxByName(cellName);
             AssertMsg(cellIdx != INDEX_TYPE_MAX, "Unknown pin! cellname: %s, pinname %s \n", cellName.c_str(), pinName.c_str());
+            IndexType pinIdx = this->pinIdxByName(cellIdx, pinName);
             if (pinIdx  == INDEX_TYPE_MAX)
             {
                 WRN("%s unknown pin name. cell name %s pin name %s \n", __FUNCTION__, cellName.c_str(), pinName.c_str());
@@ -181,6 +177,25 @@ class Database
         /// @return the relational constraint vector
         std::vector<RelationalConstraint> & relationalConstraints()  { return _relationalConstraints; }
         /*------------------------------*/ 
+        /* Name look up                 */
+        /*------------------------------*/ 
+        /// @brief find a cell by its name. The first one if there are multiple cells with the same name
+        /// @param the name of the cell
+        /// @return the index of the cell. INDEX_TYPE_MAX if not found
+        IndexType cellIdxByName(std::string_view cellName) const;
+        /// @brief find a pin of a cell by its name
+        /// @param first: the index of the cell
+        /// @param second: the name of the pin
+        /// @return the index of the pin. INDEX_TYPE_MAX if not found
+        IndexType pinIdxByName(IndexType cellIdx, std::string_view pinName) const;
+        /// @brief find a net by its name
+        /// @param the name of the net
+        /// @return the index of the net. INDEX_TYPE_MAX if not found
+        IndexType netIdxByName(std::string_view netName) const;
+        /// @brief mark all the name indices as outdated. The renaming setters of the database and addPinToCell take care of themselves.
+        /// Renaming or attaching pins through Cell/Pin/Net directly is caught by the rebuild on a missed or stale entry
+        void invalidateNameIndices() { _cellNameIdx.isStale = true; _pinNameIdx.isStale = true; _netNameIdx.isStale = true; }
+        /*------------------------------*/ 
         /* Technology-dependent         */
         /*------------------------------*/ 
         /// @brief get the spacing requirement between two cells
@@ -206,6 +221,11 @@ class Database
            }
         }
         bool checkSym();
+        /// @brief count the symmetric pairs and the self-symmetric cells off the symmetric axis. The axis is the one of the first pair, as in checkSym()
+        /// @return the number of violating pairs and cells
+        IndexType numSymViolations() const;
+        /// @brief the bounding box of the placed cells
+        Box<LocType> placementBBox() const;
         /*------------------------------*/ 
         /* Debug functions              */
         /*------------------------------*/ 
@@ -216,6 +236,26 @@ class Database
 #endif //DEBUG_DRAW
 
     private:
+        /// @brief lazily built name to index map, and the state of the database it was built on
+        template<typename MapType>
+        struct LazyNameIndex
+        {
+            /// @brief renaming the objects already indexed makes the map stale. The newly allocated ones are indexed when they are looked up
+            void markRenamed(IndexType idx) { if (idx < size) { isStale = true; } }
+
+            MapType map; ///< The name to index map
+            IndexType size = 0; ///< The number of the objects indexed in the map
+            bool isStale = true; ///< Whether the map needs to be rebuilt
+        };
+        /// @brief rebuild the name indices
+        /// @param whether to rebuild from scratch. Otherwise only index the appended objects
+        void buildCellNameIdx(bool fromScratch) const;
+        void buildPinNameIdx() const;
+        /// @brief rebuild the pin name index of a cell only
+        void buildCellPinNameIdx(IndexType cellIdx) const;
+        void buildNetNameIdx(bool fromScratch) const;
+    private:
+        friend class DatabaseSnapshot;
         std::vector<Cell> _cellArray; ///< The cells of the placement problem
         std::vector<Net> _netArray; ///< The nets of the placement problem
         std::vector<Pin> _pinArray; ///< The pins of the placement problem
@@ -225,6 +265,10 @@ class Database
         std::vector<RelationalConstraint> _relationalConstraints; ///< The horizontal/vertical constraints
         Tech _tech; ///< The tech information
         Parameters _para; ///< The parameters for the placement engine
+        /* Name indices. Lazily maintained in the const look up functions, hence not thread-safe */
+        mutable LazyNameIndex<std::unordered_map<std::string, IndexType>> _cellNameIdx; ///< cell name -> cell index
+        mutable LazyNameIndex<std::vector<std::unordered_map<std::string, IndexType>>> _pinNameIdx; ///< [cell index][pin name] -> pin index
+        mutable LazyNameIndex<std::unordered_map<std::string, IndexType>> _netNameIdx; ///< net name -> net index
 };
 
 inline RealType Database::calculateTotalCellArea() const
@@ -0,0 +1,335 @@
+#include "DatabaseSnapshot.h"
+#include <algorithm>
+#include <fstream>
+#include "util/BinaryStream.h"
+#include "util/MmapTokenizer.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace DatabaseSnapshotDetails
+{
+    constexpr char MAGIC[8] = {'I', 'D', 'E', 'A', 'S', 'N', 'A', 'P'};
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    /// @brief the boolean fields of the cells, packed into one byte per cell
+    enum CellFlag : Byte
+    {
+        CELL_SELF_SYM = 1 << 0,
+        CELL_FLIP     = 1 << 1
+    };
+
+    /// @brief the boolean fields of the nets, packed into one byte per net
+    enum NetFlag : Byte
+    {
+        NET_IO       = 1 << 0,
+        NET_DUMMY    = 1 << 1,
+        NET_LEFT_SYM = 1 << 2,
+        NET_SELF_SYM = 1 << 3,
+        NET_VDD      = 1 << 4,
+        NET_VSS      = 1 << 5
+    };
+
+    inline Byte flag(bool value, Byte mask) { return value ? mask : 0; }
+}
+
+bool DatabaseSnapshot::save(const std::string &filename) const
+{
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.good())
+    {
+        ERR("DatabaseSnapshot::%s cannot open %s for writing \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    if (!write(out))
+    {
+        ERR("DatabaseSnapshot::%s failed writing %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseSnapshot::write(std::ostream &out) const
+{
+    using namespace DatabaseSnapshotDetails;
+    ::klib::BinaryWriter writer(out);
+    /* Header */
+    for (char c : MAGIC)
+    {
+        writer.pod(c);
+    }
+    writer.pod(VERSION);
+    writer.pod(BYTE_ORDER_MARK);
+    writer.pod(static_cast<std::uint32_t>(sizeof(IndexType)));
+    writer.pod(static_cast<std::uint32_t>(sizeof(LocType)));
+    writer.pod(static_cast<std::uint32_t>(sizeof(RealType)));
+    /* Cells */
+    const auto &cells = _db._cellArray;
+    writer.pod(static_cast<std::uint64_t>(cells.size()));
+    writer.strings(cells, [](const Cell &cell) -> const std::string & { return cell._name; });
+    writer.column(cells, [](const Cell &cell) { return cell._loc; });
+    writer.csr(cells, [](const Cell &cell) -> const std::vector<IndexType> & { return cell._pinIdxArray; });
+    writer.csr(cells, [](const Cell &cell) -> const std::vector<Box<LocType>> & { return cell._bboxArray; });
+    writer.column(cells, [](const Cell &cell) { return cell._cellBBox; });
+    writer.column(cells, [](const Cell &cell) { return cell._symNetIdx; });
+    writer.column(cells, [](const Cell &cell) { return static_cast<Byte>(flag(cell._bSelfSym, CELL_SELF_SYM) | flag(cell._flip, CELL_FLIP)); });
+    /* Pins */
+    const auto &pins = _db._pinArray;
+    writer.pod(static_cast<std::uint64_t>(pins.size()));
+    writer.strings(pins, [](const Pin &pin) -> const std::string & { return pin._name; });
+    writer.csr(pins, [](const Pin &pin) -> const std::vector<IndexType> & { return pin._netIdxArray; });
+    writer.column(pins, [](const Pin &pin) { return pin._cellIdx; });
+    writer.column(pins, [](const Pin &pin) { return pin._shape; });
+    writer.column(pins, [](const Pin &pin) { return static_cast<Byte>(pin._isDummy); });
+    /* Nets */
+    const auto &nets = _db._netArray;
+    writer.pod(static_cast<std::uint64_t>(nets.size()));
+    writer.strings(nets, [](const Net &net) -> const std::string & { return net._name; });
+    writer.csr(nets, [](const Net &net) -> const std::vector<IndexType> & { return net._pinIdxArray; });
+    writer.column(nets, [](const Net &net) { return net._weight; });
+    writer.column(nets, [](const Net &net) { return net._virtualPin._loc; });
+    writer.column(nets, [](const Net &net) { return net._virtualPin._netIdx; });
+    writer.column(nets, [](const Net &net) { return static_cast<Byte>(net._virtualPin._dir); });
+    writer.column(nets, [](const Net &net) { return net._symNetIdx; });
+    writer.column(nets, [](const Net &net)
+            {
+                return static_cast<Byte>(flag(net._isIo, NET_IO) | flag(net._isDummy, NET_DUMMY) | flag(net._isLeftSym, NET_LEFT_SYM)
+                        | flag(net._isSelfSym, NET_SELF_SYM) | flag(net._isVdd, NET_VDD) | flag(net._isVss, NET_VSS));
+            });
+    /* Symmetric groups */
+    const auto &symGroups = _db._symGroups;
+    writer.pod(static_cast<std::uint64_t>(symGroups.size()));
+    writer.csr(symGroups, [](const SymGroup &grp) -> const std::vector<SymPair> & { return grp._symPairs; });
+    writer.csr(symGroups, [](const SymGroup &grp) -> const std::vector<IndexType> & { return grp._selfSyms; });
+    /* Proximity groups */
+    const auto &proximityGrps = _db._proximityGrps;
+    writer.pod(static_cast<std::uint64_t>(proximityGrps.size()));
+    writer.csr(proximityGrps, [](const ProximityGroup &grp) -> const std::vector<IndexType> & { return grp._cells; });
+    writer.column(proximityGrps, [](const ProximityGroup &grp) { return grp._weight; });
+    /* Signal paths */
+    const auto &signalPaths = _db._signalPaths;
+    writer.pod(static_cast<std::uint64_t>(signalPaths.size()));
+    writer.csr(signalPaths, [](const SignalPath &path) -> const std::vector<IndexType> & { return path._pinIdxArray; });
+    writer.column(signalPaths, [](const SignalPath &path) { return path._isPower; });
+    /* Relational constraints. The size is given by the columns */
+    const auto &relationalConstraints = _db._relationalConstraints;
+    writer.column(relationalConstraints, [](const RelationalConstraint &con) { return con.llCellIdx(); });
+    writer.column(relationalConstraints, [](const RelationalConstraint &con) { return con.urCellIdx(); });
+    writer.column(relationalConstraints, [](const RelationalConstraint &con) { return static_cast<Byte>(con.relationalType()); });
+    writer.column(relationalConstraints, [](const RelationalConstraint &con) { return con.weight(); });
+    writer.column(relationalConstraints, [](const RelationalConstraint &con) { return static_cast<Byte>(con.compareType()); });
+    /* Tech */
+    const auto &tech = _db._tech;
+    writer.pod(tech._dbu);
+    std::vector<IndexType> gdsLayers, layers;
+    for (const auto &pair : tech._layerIdxMap)
+    {
+        gdsLayers.emplace_back(pair.first);
+    }
+    std::sort(gdsLayers.begin(), gdsLayers.end());
+    for (IndexType gdsLayer : gdsLayers)
+    {
+        layers.emplace_back(tech._layerIdxMap.at(gdsLayer));
+    }
+    writer.vec(gdsLayers);
+    writer.vec(layers);
+    writer.vec(tech._gdsLayerIdxArray);
+    writer.vec(tech._widthRule);
+    writer.vec(tech._areaRule);
+    writer.pod(tech._spacingRule.xSize());
+    writer.pod(tech._spacingRule.ySize());
+    writer.pod(tech._spacingRule.type());
+    writer.vec(std::vector<LocType>(tech._spacingRule.begin(), tech._spacingRule.end()));
+    /* Parameters. The options of a run (threads, checkpoints, resuming and the result cache) are not saved: a loaded snapshot keeps the ones of the loading run */
+    const auto &para = _db._para;
+    writer.pod(para._boundaryConstraint);
+    writer.pod(para._ifUsePinAssignment);
+    writer.pod(para._ifUseGdsStreamReader);
+    writer.pod(para._gridStep);
+    writer.pod(para._virtualBoundaryExtension);
+    writer.pod(para._virtualPinInterval);
+    writer.pod(para._layoutOffset);
+    writer.pod(para._defaultAspectRatio);
+    writer.pod(para._maxWhiteSpace);
+    writer.pod(para._defaultSignalFlowWeight);
+    writer.pod(para._defaultCurrentFlowWeight);
+    writer.pod(para._defaultRelativeRatioOfPowerNet);
+    writer.pod(para._defaultRelationalConstraintWeight);
+    writer.close();
+    return writer.good();
+}
+
+bool DatabaseSnapshot::load(const std::string &filename)
+{
+    using namespace DatabaseSnapshotDetails;
+    ::klib::MmapFile file;
+    if (!file.open(filename))
+    {
+        ERR("DatabaseSnapshot::%s cannot open %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    ::klib::BinaryReader reader(file.content());
+    /* Header */
+    char magic[sizeof(MAGIC)];
+    for (char &c : magic)
+    {
+        reader.pod(c);
+    }
+    if (!reader.ok() || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        ERR("DatabaseSnapshot::%s %s is not a database snapshot \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    std::uint32_t version = 0, byteOrderMark = 0, indexSize = 0, locSize = 0, realSize = 0;
+    reader.pod(version);
+    reader.pod(byteOrderMark);
+    reader.pod(indexSize);
+    reader.pod(locSize);
+    reader.pod(realSize);
+    if (version != VERSION)
+    {
+        ERR("DatabaseSnapshot::%s %s has version %u, expecting version %u \n", __FUNCTION__, filename.c_str(), version, VERSION);
+        return false;
+    }
+    if (byteOrderMark != BYTE_ORDER_MARK || indexSize != sizeof(IndexType) || locSize != sizeof(LocType) || realSize != sizeof(RealType))
+    {
+        ERR("DatabaseSnapshot::%s %s is saved by an incompatible build or machine \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    Database db;
+    /* Cells */
+    auto &cells = db._cellArray;
+    reader.objects(cells);
+    reader.strings(cells, [](Cell &cell) -> std::string & { return cell._name; });
+    reader.column<XY<LocType>>(cells, [](Cell &cell, const XY<LocType> &loc) { cell._loc = loc; });
+    reader.csr(cells, [](Cell &cell) -> std::vector<IndexType> & { return cell._pinIdxArray; });
+    reader.csr(cells, [](Cell &cell) -> std::vector<Box<LocType>> & { return cell._bboxArray; });
+    reader.column<Box<LocType>>(cells, [](Cell &cell, const Box<LocType> &bbox) { cell._cellBBox = bbox; });
+    reader.column<IndexType>(cells, [](Cell &cell, IndexType symNetIdx) { cell._symNetIdx = symNetIdx; });
+    reader.column<Byte>(cells, [](Cell &cell, Byte flags)
+            {
+                cell._bSelfSym = flags & CELL_SELF_SYM;
+                cell._flip = flags & CELL_FLIP;
+            });
+    /* Pins */
+    auto &pins = db._pinArray;
+    reader.objects(pins);
+    reader.strings(pins, [](Pin &pin) -> std::string & { return pin._name; });
+    reader.csr(pins, [](Pin &pin) -> std::vector<IndexType> & { return pin._netIdxArray; });
+    reader.column<IndexType>(pins, [](Pin &pin, IndexType cellIdx) { pin._cellIdx = cellIdx; });
+    reader.column<Box<LocType>>(pins, [](Pin &pin, const Box<LocType> &shape) { pin._shape = shape; });
+    reader.column<Byte>(pins, [](Pin &pin, Byte isDummy) { pin._isDummy = isDummy; });
+    /* Nets */
+    auto &nets = db._netArray;
+    reader.objects(nets);
+    reader.strings(nets, [](Net &net) -> std::string & { return net._name; });
+    reader.csr(nets, [](Net &net) -> std::vector<IndexType> & { return net._pinIdxArray; });
+    reader.column<IntType>(nets, [](Net &net, IntType weight) { net._weight = weight; });
+    reader.column<XY<LocType>>(nets, [](Net &net, const XY<LocType> &loc) { net._virtualPin._loc = loc; });
+    reader.column<IndexType>(nets, [](Net &net, IndexType netIdx) { net._virtualPin._netIdx = netIdx; });
+    reader.column<Byte>(nets, [](Net &net, Byte dir) { net._virtualPin._dir = static_cast<Direction2DType>(dir); });
+    reader.column<IndexType>(nets, [](Net &net, IndexType symNetIdx) { net._symNetIdx = symNetIdx; });
+    reader.column<Byte>(nets, [](Net &net, Byte flags)
+            {
+                net._isIo = flags & NET_IO;
+                net._isDummy = flags & NET_DUMMY;
+                net._isLeftSym = flags & NET_LEFT_SYM;
+                net._isSelfSym = flags & NET_SELF_SYM;
+                net._isVdd = flags & NET_VDD;
+                net._isVss = flags & NET_VSS;
+            });
+    /* Symmetric groups */
+    auto &symGroups = db._symGroups;
+    reader.objects(symGroups);
+    reader.csr(symGroups, [](SymGroup &grp) -> std::vector<SymPair> & { return grp._symPairs; });
+    reader.csr(symGroups, [](SymGroup &grp) -> std::vector<IndexType> & { return grp._selfSyms; });
+    /* Proximity groups */
+    auto &proximityGrps = db._proximityGrps;
+    reader.objects(proximityGrps);
+    reader.csr(proximityGrps, [](ProximityGroup &grp) -> std::vector<IndexType> & { return grp._cells; });
+    reader.column<IntType>(proximityGrps, [](ProximityGroup &grp, IntType weight) { grp._weight = weight; });
+    /* Signal paths */
+    auto &signalPaths = db._signalPaths;
+    reader.objects(signalPaths);
+    reader.csr(signalPaths, [](SignalPath &path) -> std::vector<IndexType> & { return path._pinIdxArray; });
+    reader.column<BoolType>(signalPaths, [](SignalPath &path, BoolType isPower) { path._isPower = isPower; });
+    /* Relational constraints. No default constructor, so the columns are read first */
+    std::vector<IndexType> llCellIdxs, urCellIdxs;
+    std::vector<Byte> relationalTypes, compareTypes;
+    std::vector<IntType> weights;
+    reader.vec(llCellIdxs);
+    reader.vec(urCellIdxs);
+    reader.vec(relationalTypes);
+    reader.vec(weights);
+    reader.vec(compareTypes);
+    const IndexType numRelationalConstraints = llCellIdxs.size();
+    if (urCellIdxs.size() != numRelationalConstraints || relationalTypes.size() != numRelationalConstraints
+            || weights.size() != numRelationalConstraints || compareTypes.size() != numRelationalConstraints)
+    {
+        ERR("DatabaseSnapshot::%s %s is corrupted \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    db._relationalConstraints.reserve(numRelationalConstraints);
+    for (IndexType idx = 0; idx < numRelationalConstraints; ++idx)
+    {
+        db._relationalConstraints.emplace_back(llCellIdxs[idx], urCellIdxs[idx], static_cast<Orient2DType>(relationalTypes[idx]),
+                weights[idx], static_cast<RelationalConstraint::CompareType>(compareTypes[idx]));
+    }
+    /* Tech */
+    auto &tech = db._tech;
+    reader.pod(tech._dbu);
+    std::vector<IndexType> gdsLayers, layers;
+    reader.vec(gdsLayers);
+    reader.vec(layers);
+    if (gdsLayers.size() != layers.size())
+    {
+        ERR("DatabaseSnapshot::%s %s is corrupted \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    for (IndexType idx = 0; idx < gdsLayers.size(); ++idx)
+    {
+        tech._layerIdxMap[gdsLayers[idx]] = layers[idx];
+    }
+    reader.vec(tech._gdsLayerIdxArray);
+    reader.vec(tech._widthRule);
+    reader.vec(tech._areaRule);
+    IndexType spacingXSize = 0, spacingYSize = 0;
+    auto spacingType = Vector2D<LocType>::InitListType::XMajor;
+    std::vector<LocType> spacingRule;
+    reader.pod(spacingXSize);
+    reader.pod(spacingYSize);
+    reader.pod(spacingType);
+    reader.vec(spacingRule);
+    if (static_cast<std::uint64_t>(spacingXSize) * spacingYSize != spacingRule.size())
+    {
+        ERR("DatabaseSnapshot::%s %s is corrupted \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    tech._spacingRule.resize(spacingXSize, spacingYSize);
+    tech._spacingRule.setType(spacingType);
+    std::copy(spacingRule.begin(), spacingRule.end(), tech._spacingRule.begin());
+    /* Parameters */
+    auto &para = db._para;
+    reader.pod(para._boundaryConstraint);
+    reader.pod(para._ifUsePinAssignment);
+    reader.pod(para._ifUseGdsStreamReader);
+    reader.pod(para._gridStep);
+    reader.pod(para._virtualBoundaryExtension);
+    reader.pod(para._virtualPinInterval);
+    reader.pod(para._layoutOffset);
+    reader.pod(para._defaultAspectRatio);
+    reader.pod(para._maxWhiteSpace);
+    reader.pod(para._defaultSignalFlowWeight);
+    reader.pod(para._defaultCurrentFlowWeight);
+    reader.pod(para._defaultRelativeRatioOfPowerNet);
+    reader.pod(para._defaultRelationalConstraintWeight);
+    if (!reader.ok() || !reader.atEnd())
+    {
+        ERR("DatabaseSnapshot::%s %s is corrupted \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    _db = std::move(db);
+    _db.invalidateNameIndices();
+    return true;
+}
+
+PROJECT_NAMESPACE_END
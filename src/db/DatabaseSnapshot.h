@@ -0,0 +1,45 @@
+/**
+ * @file DatabaseSnapshot.h
+ * @brief Versioned binary snapshot of the placement database
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_DATABASE_SNAPSHOT_H_
+#define IDEAPLACE_DATABASE_SNAPSHOT_H_
+
+#include <ostream>
+#include "Database.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class IDEAPLACE::DatabaseSnapshot
+/// @brief save and load the whole database to/from a binary file.
+/// The objects are stored column-wise, so that each field is a single bulk read from the memory-mapped file.
+/// The snapshot is only meant to be read by the same build on the same machine type: the sizes of the basic types and the byte order are checked on loading
+class DatabaseSnapshot
+{
+    public:
+        /// @brief the version of the format. Need to be bumped whenever the layout of the file changes
+        static constexpr std::uint32_t VERSION = 4;
+        /// @brief constructor
+        /// @param the placement database
+        explicit DatabaseSnapshot(Database &db) : _db(db) {}
+        /// @brief save the database into a snapshot
+        /// @param the file name
+        /// @return if successful
+        bool save(const std::string &filename) const;
+        /// @brief write the snapshot into a stream, eg. a string stream for hashing the whole database
+        /// @param the output stream
+        /// @return if successful
+        bool write(std::ostream &out) const;
+        /// @brief load a snapshot into the database. The database is replaced as a whole, and is kept untouched if the loading fails
+        /// @param the file name
+        /// @return if successful
+        bool load(const std::string &filename);
+    private:
+        Database &_db; ///< The placement database
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //IDEAPLACE_DATABASE_SNAPSHOT_H_
@@ -40,6 +40,7 @@ class VirtualPin
             return ss.str();
         }
     private:
+        friend class DatabaseSnapshot;
         XY<LocType> _loc;
         IndexType _netIdx = INDEX_TYPE_MAX;
         Direction2DType _dir; ///< The location on the placement boundary
@@ -65,6 +66,8 @@ class Net
         /// @brief get the virtual pin location
         /// @return the location for the virtual pin
         const XY<LocType> &virtualPinLoc() const { return _virtualPin.loc(); }
+        /// @brief get the virtual pin
+        const VirtualPin & virtualPin() const { return _virtualPin; }
         /// @brief get whether need to consider the virtual pin: If not IO net, or if no vitual pin assigned
         bool isValidVirtualPin() const { return (_isIo or _isVdd or _isVss) && _virtualPin.assigned(); }
         /// @brief get whether this net is a dummy net
@@ -131,6 +134,7 @@ class Net
         IndexType pinIdx(IndexType idx) const { return _pinIdxArray.at(idx); }
         const std::vector<IndexType> & pinIdxArray() const { return _pinIdxArray; }
     private:
+        friend class DatabaseSnapshot;
         std::string _name = ""; ///< The name for the net
         std::vector<IndexType> _pinIdxArray; ///< The index to the pins belonging to the net
         IntType _weight = 1; ///< The weight of this net
@@ -0,0 +1,433 @@
+#include "NetlistGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace NetlistGeneratorDetails
+{
+    enum class PinType
+    {
+        DRAIN = 0,
+        GATE = 1,
+        SOURCE = 2,
+        PLUS = 0,
+        MINUS = 1
+    };
+
+    /// @brief add the cells, pins and nets to the database with the random sizes
+    class Builder
+    {
+        public:
+            explicit Builder(Database &db, std::uint64_t seed) : _db(db), _rng(seed) {}
+            /// @brief uniform real number in [0, 1)
+            RealType uniform() { return std::uniform_real_distribution<RealType>(0.0, 1.0)(_rng); }
+            /// @brief uniform integer in [lo, hi]
+            IntType uniformInt(IntType lo, IntType hi) { return std::uniform_int_distribution<IntType>(lo, hi)(_rng); }
+            /// @brief draw the size of a transistor. The widths spread over an order of magnitude, as sized by the designers
+            std::pair<LocType, LocType> transistorSize()
+            {
+                std::lognormal_distribution<RealType> width(std::log(1500.0), 0.6);
+                std::lognormal_distribution<RealType> height(std::log(1000.0), 0.4);
+                return std::make_pair(roundSize(width(_rng), 400, 10000), roundSize(height(_rng), 300, 5000));
+            }
+            /// @brief add a transistor with the drain, gate and source pins
+            IndexType addTransistor(const std::pair<LocType, LocType> &size)
+            {
+                const LocType w = size.first, h = size.second;
+                IndexType cellIdx = addCell("M", w, h);
+                addPin(cellIdx, "D", Box<LocType>(w - 150, h / 2 - 50, w - 50, h / 2 + 50));
+                addPin(cellIdx, "G", Box<LocType>(w / 2 - 50, h - 150, w / 2 + 50, h - 50));
+                addPin(cellIdx, "S", Box<LocType>(50, h / 2 - 50, 150, h / 2 + 50));
+                return cellIdx;
+            }
+            /// @brief add a capacitor or a resistor with the plus and minus pins
+            IndexType addPassive(bool isCap)
+            {
+                LocType w, h;
+                if (isCap)
+                {
+                    w = h = roundSize(uniformInt(2000, 8000), 2000, 8000);
+                }
+                else
+                {
+                    w = roundSize(uniformInt(800, 1500), 800, 1500);
+                    h = roundSize(uniformInt(2000, 8000), 2000, 8000);
+                }
+                IndexType cellIdx = addCell(isCap ? "C" : "R", w, h);
+                addPin(cellIdx, "PLUS", Box<LocType>(50, h / 2 - 50, 150, h / 2 + 50));
+                addPin(cellIdx, "MINUS", Box<LocType>(w - 150, h / 2 - 50, w - 50, h / 2 + 50));
+                return cellIdx;
+            }
+            /// @brief the pin of a cell
+            IndexType pin(IndexType cellIdx, PinType pinType) const { return _db.cell(cellIdx).pinIdx(static_cast<IndexType>(pinType)); }
+            /// @brief add a net
+            IndexType addNet(const std::string &name = "")
+            {
+                IndexType netIdx = _db.allocateNet();
+                _db.setNetName(netIdx, name == "" ? "net" + std::to_string(netIdx) : name);
+                return netIdx;
+            }
+            /// @brief connect a pin of a cell to a net
+            void connect(IndexType cellIdx, PinType pinType, IndexType netIdx)
+            {
+                IndexType pinIdx = pin(cellIdx, pinType);
+                _db.net(netIdx).addPin(pinIdx);
+                _db.pin(pinIdx).addNetIdx(netIdx);
+            }
+        private:
+            static LocType roundSize(RealType size, LocType lo, LocType hi)
+            {
+                // Multiple of 10, like the drawn layouts
+                return std::max(lo, std::min(hi, static_cast<LocType>(std::round(size / 10.0)) * 10));
+            }
+            IndexType addCell(const std::string &prefix, LocType w, LocType h)
+            {
+                IndexType cellIdx = _db.allocateCell();
+                _db.setCellName(cellIdx, prefix + std::to_string(cellIdx));
+                _db.initCell(cellIdx);
+                auto &cell = _db.cell(cellIdx);
+                // The upper layers are inset horizontally and extended vertically, like the poly and metal over the diffusion
+                for (IndexType layerIdx = 0; layerIdx < _db.tech().numLayers(); ++layerIdx)
+                {
+                    LocType inset = std::min(static_cast<LocType>(layerIdx) * 20, w / 4);
+                    cell.unionBBox(layerIdx, Box<LocType>(inset, -static_cast<LocType>(layerIdx) * 10, w - inset, h + static_cast<LocType>(layerIdx) * 10));
+                }
+                cell.calculateCellBBox();
+                return cellIdx;
+            }
+            void addPin(IndexType cellIdx, const std::string &name, const Box<LocType> &shape)
+            {
+                IndexType pinIdx = _db.allocatePin();
+                _db.setPinName(pinIdx, name);
+                _db.pin(pinIdx).setCellIdx(cellIdx);
+                _db.pin(pinIdx).shape() = shape;
+                _db.addPinToCell(cellIdx, pinIdx);
+            }
+        private:
+            Database &_db; ///< The database being generated
+            std::mt19937_64 _rng; ///< The random numbers
+    };
+
+    /// @brief the building blocks
+    enum class BlockType
+    {
+        DIFF_PAIR, ///< A symmetric pair and its self-symmetric tail source. Outputs a differential signal
+        MIRROR_LOAD, ///< A symmetric pair of PMOS loads on a differential signal. Outputs a single-ended signal
+        PSEUDO_DIFF_GAIN, ///< Two symmetric common-source stages with their loads. Outputs a differential signal
+        GAIN, ///< A common-source stage with its current source load
+        PASSIVE ///< A capacitor or a resistor
+    };
+
+    /// @brief the number of cells of a block
+    inline IndexType blockSize(BlockType type)
+    {
+        switch (type)
+        {
+            case BlockType::DIFF_PAIR: return 3;
+            case BlockType::MIRROR_LOAD: return 2;
+            case BlockType::PSEUDO_DIFF_GAIN: return 4;
+            case BlockType::GAIN: return 2;
+            default: return 1;
+        }
+    }
+}
+
+bool NetlistGenerator::generate(Database &db) const
+{
+    using namespace NetlistGeneratorDetails;
+    if (db.numCells() != 0 or db.numNets() != 0)
+    {
+        ERR("NetlistGenerator::%s the database is not empty \n", __FUNCTION__);
+        return false;
+    }
+    if (_numLayers == 0)
+    {
+        ERR("NetlistGenerator::%s need at least one layer \n", __FUNCTION__);
+        return false;
+    }
+    db.tech().setDbu(1000);
+    for (IndexType layerIdx = 0; layerIdx < _numLayers; ++layerIdx)
+    {
+        db.tech().addGdsLayer(layerIdx + 1);
+    }
+    db.tech().initRuleDataStructure();
+    for (IndexType layerIdx = 0; layerIdx < _numLayers; ++layerIdx)
+    {
+        db.tech().setSpacingRule(layerIdx, 100 + 20 * layerIdx);
+    }
+
+    Builder builder(db, _seed);
+    const IndexType vdd = builder.addNet("VDD");
+    const IndexType vss = builder.addNet("VSS");
+    const IndexType vbn = builder.addNet("VBN");
+    const IndexType vbp = builder.addNet("VBP");
+    db.net(vdd).markAsVdd();
+    db.net(vss).markAsVss();
+
+    auto addSymNetPair = [&](IndexType netIdx1, IndexType netIdx2)
+    {
+        db.net(netIdx1).setSymNet(netIdx2, true);
+        db.net(netIdx2).setSymNet(netIdx1, false);
+    };
+    // The differential input of the circuit
+    std::vector<IndexType> signal = {builder.addNet("INP"), builder.addNet("INN")};
+    db.net(signal[0]).setIsIo(true);
+    db.net(signal[1]).setIsIo(true);
+    addSymNetPair(signal[0], signal[1]);
+
+    IndexType symGrpIdx = INDEX_TYPE_MAX;
+    IndexType numBlocksInSymGrp = 0;
+    auto addSymPair = [&](IndexType cellIdx1, IndexType cellIdx2)
+    {
+        db.symGroup(symGrpIdx).addSymPair(cellIdx1, cellIdx2);
+        db.cell(cellIdx1).setSymNetIdx(cellIdx2);
+        db.cell(cellIdx2).setSymNetIdx(cellIdx1);
+    };
+    auto addSelfSym = [&](IndexType cellIdx)
+    {
+        db.symGroup(symGrpIdx).addSelfSym(cellIdx);
+        db.cell(cellIdx).setSelfSym(true);
+    };
+    IndexType pathIdx = INDEX_TYPE_MAX;
+    IndexType numBlocksInPath = 0;
+    auto addToSignalPath = [&](IndexType cellIdx)
+    {
+        if (pathIdx == INDEX_TYPE_MAX or numBlocksInPath >= _signalPathLength)
+        {
+            pathIdx = db.allocateSignalPath();
+            numBlocksInPath = 0;
+        }
+        db.signalPath(pathIdx).addPinIdx(builder.pin(cellIdx, PinType::GATE));
+        db.signalPath(pathIdx).addPinIdx(builder.pin(cellIdx, PinType::DRAIN));
+        ++numBlocksInPath;
+    };
+    IndexType prevRepCell = INDEX_TYPE_MAX;
+
+    while (db.numCells() < _numCells)
+    {
+        const IndexType remaining = _numCells - db.numCells();
+        const bool isDiff = signal.size() == 2;
+        // Choose the kind of the block, and fall back to the smaller ones at the end
+        const RealType draw = builder.uniform();
+        BlockType type;
+        if (draw < _passiveRatio)
+        {
+            type = BlockType::PASSIVE;
+        }
+        else if (draw < _passiveRatio + _symRatio)
+        {
+            if (isDiff)
+            {
+                const RealType kind = builder.uniform();
+                type = kind < 0.4 ? BlockType::MIRROR_LOAD : (kind < 0.7 ? BlockType::PSEUDO_DIFF_GAIN : BlockType::DIFF_PAIR);
+            }
+            else
+            {
+                type = BlockType::DIFF_PAIR;
+            }
+        }
+        else
+        {
+            type = BlockType::GAIN;
+        }
+        if (blockSize(type) > remaining)
+        {
+            type = remaining >= 2 ? BlockType::GAIN : BlockType::PASSIVE;
+        }
+        const IndexType firstCellIdx = db.numCells();
+        const bool isSymBlock = type == BlockType::DIFF_PAIR or type == BlockType::MIRROR_LOAD or type == BlockType::PSEUDO_DIFF_GAIN;
+        if (isSymBlock)
+        {
+            if (symGrpIdx == INDEX_TYPE_MAX or numBlocksInSymGrp >= _numBlocksPerSymGroup)
+            {
+                symGrpIdx = db.allocateSymGrp();
+                numBlocksInSymGrp = 0;
+            }
+            ++numBlocksInSymGrp;
+        }
+        // The cell for the relational constraints. Not a self-symmetric one
+        IndexType repCell = firstCellIdx;
+        switch (type)
+        {
+            case BlockType::DIFF_PAIR:
+            {
+                const auto size = builder.transistorSize();
+                IndexType m1 = builder.addTransistor(size);
+                IndexType m2 = builder.addTransistor(size);
+                IndexType tail = builder.addTransistor(builder.transistorSize());
+                IndexType inN = isDiff ? signal[1] : builder.addNet();
+                if (not isDiff)
+                {
+                    // The reference input of a single-ended signal
+                    db.net(inN).setIsIo(true);
+                }
+                IndexType tailNet = builder.addNet();
+                IndexType outP = builder.addNet();
+                IndexType outN = builder.addNet();
+                builder.connect(m1, PinType::GATE, signal[0]);
+                builder.connect(m2, PinType::GATE, inN);
+                builder.connect(m1, PinType::SOURCE, tailNet);
+                builder.connect(m2, PinType::SOURCE, tailNet);
+                builder.connect(m1, PinType::DRAIN, outN);
+                builder.connect(m2, PinType::DRAIN, outP);
+                builder.connect(tail, PinType::DRAIN, tailNet);
+                builder.connect(tail, PinType::GATE, vbn);
+                builder.connect(tail, PinType::SOURCE, vss);
+                db.net(tailNet).markSelfSym();
+                addSymNetPair(outP, outN);
+                addSymPair(m1, m2);
+                addSelfSym(tail);
+                addToSignalPath(m1);
+                // The bias current flows from the pair down through the tail
+                IndexType powerPathIdx = db.allocateSignalPath();
+                db.signalPath(powerPathIdx).addPinIdx(builder.pin(m1, PinType::DRAIN));
+                db.signalPath(powerPathIdx).addPinIdx(builder.pin(m1, PinType::SOURCE));
+                db.signalPath(powerPathIdx).addPinIdx(builder.pin(tail, PinType::DRAIN));
+                db.signalPath(powerPathIdx).addPinIdx(builder.pin(tail, PinType::SOURCE));
+                db.signalPath(powerPathIdx).markAsPower();
+                signal = {outP, outN};
+                break;
+            }
+            case BlockType::MIRROR_LOAD:
+            {
+                const auto size = builder.transistorSize();
+                IndexType m1 = builder.addTransistor(size);
+                IndexType m2 = builder.addTransistor(size);
+                // The diode-connected side sets the gates
+                builder.connect(m1, PinType::DRAIN, signal[0]);
+                builder.connect(m1, PinType::GATE, signal[0]);
+                builder.connect(m2, PinType::GATE, signal[0]);
+                builder.connect(m2, PinType::DRAIN, signal[1]);
+                builder.connect(m1, PinType::SOURCE, vdd);
+                builder.connect(m2, PinType::SOURCE, vdd);
+                addSymPair(m1, m2);
+                signal = {signal[1]};
+                break;
+            }
+            case BlockType::PSEUDO_DIFF_GAIN:
+            {
+                const auto driverSize = builder.transistorSize();
+                const auto loadSize = builder.transistorSize();
+                IndexType d1 = builder.addTransistor(driverSize);
+                IndexType d2 = builder.addTransistor(driverSize);
+                IndexType l1 = builder.addTransistor(loadSize);
+                IndexType l2 = builder.addTransistor(loadSize);
+                IndexType outP = builder.addNet();
+                IndexType outN = builder.addNet();
+                builder.connect(d1, PinType::GATE, signal[0]);
+                builder.connect(d2, PinType::GATE, signal[1]);
+                builder.connect(d1, PinType::DRAIN, outN);
+                builder.connect(d2, PinType::DRAIN, outP);
+                builder.connect(d1, PinType::SOURCE, vss);
+                builder.connect(d2, PinType::SOURCE, vss);
+                builder.connect(l1, PinType::DRAIN, outN);
+                builder.connect(l2, PinType::DRAIN, outP);
+                builder.connect(l1, PinType::GATE, vbp);
+                builder.connect(l2, PinType::GATE, vbp);
+                builder.connect(l1, PinType::SOURCE, vdd);
+                builder.connect(l2, PinType::SOURCE, vdd);
+                addSymNetPair(outP, outN);
+                addSymPair(d1, d2);
+                addSymPair(l1, l2);
+                addToSignalPath(d1);
+                signal = {outP, outN};
+                break;
+            }
+            case BlockType::GAIN:
+            {
+                IndexType driver = builder.addTransistor(builder.transistorSize());
+                IndexType load = builder.addTransistor(builder.transistorSize());
+                IndexType out = builder.addNet();
+                builder.connect(driver, PinType::GATE, signal[0]);
+                builder.connect(driver, PinType::DRAIN, out);
+                builder.connect(driver, PinType::SOURCE, vss);
+                builder.connect(load, PinType::DRAIN, out);
+                builder.connect(load, PinType::GATE, vbp);
+                builder.connect(load, PinType::SOURCE, vdd);
+                addToSignalPath(driver);
+                signal = {out};
+                break;
+            }
+            case BlockType::PASSIVE:
+            {
+                const bool isCap = builder.uniform() < 0.6;
+                IndexType passive = builder.addPassive(isCap);
+                builder.connect(passive, PinType::PLUS, signal[0]);
+                if (isCap)
+                {
+                    // A load capacitor, or a compensation capacitor back to an earlier node
+                    IndexType other = builder.uniform() < 0.5 ? vss : builder.uniformInt(4, db.numNets() - 1);
+                    builder.connect(passive, PinType::MINUS, other == signal[0] ? vss : other);
+                }
+                else
+                {
+                    // A series resistor on a single-ended signal, or a load across a differential one
+                    if (signal.size() == 1)
+                    {
+                        IndexType out = builder.addNet();
+                        builder.connect(passive, PinType::MINUS, out);
+                        signal = {out};
+                    }
+                    else
+                    {
+                        builder.connect(passive, PinType::MINUS, signal[1]);
+                    }
+                }
+                break;
+            }
+        }
+        if (db.numCells() - firstCellIdx >= 2 and builder.uniform() < _proximityRatio)
+        {
+            IndexType proximityGrpIdx = db.allocateProximityGroup();
+            for (IndexType cellIdx = firstCellIdx; cellIdx < db.numCells(); ++cellIdx)
+            {
+                db.proximityGrp(proximityGrpIdx).addCell(cellIdx);
+            }
+            db.proximityGrp(proximityGrpIdx).setWeight(1);
+        }
+        if (prevRepCell != INDEX_TYPE_MAX and builder.uniform() < _relationalRatio)
+        {
+            // Along the signal flow: left to right, or bottom to top
+            Orient2DType orient = builder.uniform() < 0.7 ? Orient2DType::HORIZONTAL : Orient2DType::VERTICAL;
+            db.relationalConstraints().emplace_back(RelationalConstraint(prevRepCell, repCell, orient, 1));
+        }
+        prevRepCell = repCell;
+    }
+    for (IndexType netIdx : signal)
+    {
+        db.net(netIdx).setIsIo(true);
+    }
+
+    // The local nets not following the blocks, eg. the bias distribution and the dummies
+    const IndexType numExtraNets = static_cast<IndexType>(_extraNetRatio * db.numCells());
+    constexpr IntType LOCAL_WINDOW = 8;
+    for (IndexType idx = 0; idx < numExtraNets and db.numCells() >= 2; ++idx)
+    {
+        IndexType netIdx = builder.addNet();
+        // Mostly two-pin nets, with a tail of the larger ones
+        IntType degree = 2;
+        while (degree < 6 and builder.uniform() < 0.35)
+        {
+            ++degree;
+        }
+        const IntType center = builder.uniformInt(0, db.numCells() - 1);
+        const IntType lo = std::max(0, center - LOCAL_WINDOW);
+        const IntType hi = std::min(static_cast<IntType>(db.numCells()) - 1, center + LOCAL_WINDOW);
+        for (IntType pinCount = 0; pinCount < degree; ++pinCount)
+        {
+            IndexType cellIdx = builder.uniformInt(lo, hi);
+            IndexType pinIdx = db.cell(cellIdx).pinIdx(builder.uniformInt(0, db.cell(cellIdx).numPinIdx() - 1));
+            db.net(netIdx).addPin(pinIdx);
+            db.pin(pinIdx).addNetIdx(netIdx);
+        }
+    }
+    INF("NetlistGenerator::%s %d cells, %d nets, %d pins, %d symmetric groups, %d proximity groups, %d signal paths, %d relational constraints \n",
+            __FUNCTION__, db.numCells(), db.numNets(), db.numPins(), db.numSymGroups(),
+            static_cast<IndexType>(db.proximityGrps().size()), static_cast<IndexType>(db.vSignalPaths().size()),
+            static_cast<IndexType>(db.relationalConstraints().size()));
+    return true;
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,60 @@
+/**
+ * @file NetlistGenerator.h
+ * @brief Seeded generator of synthetic analog placement problems of any size
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_NETLIST_GENERATOR_H_
+#define IDEAPLACE_NETLIST_GENERATOR_H_
+
+#include "Database.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class IDEAPLACE::NetlistGenerator
+/// @brief build a database from the common analog building blocks: differential pairs with tail sources, mirror loads, gain stages and passives.
+/// The blocks are chained along the signal flow, which gives the symmetric pairs and nets, the proximity groups, the signal and power paths and the relational constraints the real circuits have.
+/// The same settings and seed always give the same database with the same standard library
+class NetlistGenerator
+{
+    public:
+        /// @brief constructor
+        /// @param first: the number of cells
+        /// @param second: the seed of the random numbers
+        explicit NetlistGenerator(IndexType numCells, std::uint64_t seed = 1) : _numCells(numCells), _seed(seed) {}
+        /// @brief set the number of layers of the cell shapes
+        void setNumLayers(IndexType numLayers) { _numLayers = numLayers; }
+        /// @brief set the fraction of the cells in the symmetric blocks, ie. the differential pairs and the mirrors
+        void setSymRatio(RealType symRatio) { _symRatio = symRatio; }
+        /// @brief set the fraction of the cells being passives
+        void setPassiveRatio(RealType passiveRatio) { _passiveRatio = passiveRatio; }
+        /// @brief set the number of symmetric blocks in a symmetric group. A new group is started after
+        void setNumBlocksPerSymGroup(IndexType numBlocks) { _numBlocksPerSymGroup = numBlocks; }
+        /// @brief set the number of the extra local nets per cell, on top of the ones connecting the blocks
+        void setExtraNetRatio(RealType extraNetRatio) { _extraNetRatio = extraNetRatio; }
+        /// @brief set the number of blocks in a signal path
+        void setSignalPathLength(IndexType numBlocks) { _signalPathLength = numBlocks; }
+        /// @brief set the probability of a block to be a proximity group
+        void setProximityRatio(RealType proximityRatio) { _proximityRatio = proximityRatio; }
+        /// @brief set the probability of two consecutive blocks to have a relational constraint
+        void setRelationalRatio(RealType relationalRatio) { _relationalRatio = relationalRatio; }
+        /// @brief generate the problem into an empty database
+        /// @param the database. Need to be empty
+        /// @return if successful
+        bool generate(Database &db) const;
+    private:
+        IndexType _numCells; ///< The number of cells
+        std::uint64_t _seed; ///< The seed of the random numbers
+        IndexType _numLayers = 3; ///< The number of layers
+        RealType _symRatio = 0.5; ///< The fraction of the cells in the symmetric blocks
+        RealType _passiveRatio = 0.1; ///< The fraction of the cells being passives
+        IndexType _numBlocksPerSymGroup = 8; ///< The number of symmetric blocks in a symmetric group
+        RealType _extraNetRatio = 0.3; ///< The number of extra local nets per cell
+        IndexType _signalPathLength = 4; ///< The number of blocks in a signal path
+        RealType _proximityRatio = 0.3; ///< The probability of a block to be a proximity group
+        RealType _relationalRatio = 0.2; ///< The probability of consecutive blocks to have a relational constraint
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //IDEAPLACE_NETLIST_GENERATOR_H_
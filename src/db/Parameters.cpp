@@ -4,7 +4,12 @@ PROJECT_NAMESPACE_BEGIN
 Parameters::Parameters()
 {
     _ifUsePinAssignment = true;
+    _ifUseGdsStreamReader = false;
     _numThreads = 10;
+    _gpCheckpointFile = "";
+    _gpCheckpointInterval = 0;
+    _gpResumeFile = "";
+    _resultCacheDir = "";
     _gridStep = -1;
     _virtualBoundaryExtension = 200; ///< The extension of current virtual boundary to the bounding box of placement
     _virtualPinInterval = 400; ///< The interval between each virtual pin
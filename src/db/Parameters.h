@@ -30,6 +30,10 @@ class Parameters
         void openVirtualPinAssignment() { _ifUsePinAssignment = true; }
         /// @brief close the functionality of virtual pin assignment 
         void closeVirtualPinAssignment() { _ifUsePinAssignment = false; }
+        /// @brief read the gds with the streaming bounding box reader
+        void openGdsStreamReader() { _ifUseGdsStreamReader = true; }
+        /// @brief read the gds by flattening the full gds database
+        void closeGdsStreamReader() { _ifUseGdsStreamReader = false; }
         /// @brief set the number of threads
         void setNumThreads(IndexType numThreads) { _numThreads = numThreads; }
         /// @brief set the grid step constraint
@@ -38,6 +42,20 @@ class Parameters
         void setVirtualBoundaryExtension(LocType virtualBoundaryExtension) { _virtualBoundaryExtension = virtualBoundaryExtension; _layoutOffset = 2 * virtualBoundaryExtension; }
         /// @brief set the pin interval 
         void setVirtualPinInterval(LocType virtualPinInterval) { _virtualPinInterval  = virtualPinInterval; }
+        /// @brief write the global placement checkpoints
+        /// @param first: the checkpoint file. Overwritten by each checkpoint
+        /// @param second: the number of outer iterations between two checkpoints
+        void openGpCheckpoint(const std::string &gpCheckpointFile, IndexType gpCheckpointInterval) { _gpCheckpointFile = gpCheckpointFile; _gpCheckpointInterval = gpCheckpointInterval; }
+        /// @brief stop writing the global placement checkpoints
+        void closeGpCheckpoint() { _gpCheckpointFile = ""; _gpCheckpointInterval = 0; }
+        /// @brief resume the global placement from a checkpoint. If the checkpoint is a finished global placement, go to legalization directly
+        /// @param the checkpoint file
+        void setGpResumeFile(const std::string &gpResumeFile) { _gpResumeFile = gpResumeFile; }
+        /// @brief cache the placement results in a directory, keyed by the hash of the inputs
+        /// @param the cache directory. Created if not existing
+        void openResultCache(const std::string &resultCacheDir) { _resultCacheDir = resultCacheDir; }
+        /// @brief stop using the placement result cache
+        void closeResultCache() { _resultCacheDir = ""; }
         /*------------------------------*/ 
         /* Query the parameters         */
         /*------------------------------*/ 
@@ -49,6 +67,22 @@ class Parameters
         const Box<LocType> & boundaryConstraint() const { return _boundaryConstraint; }
         /// @brief get whether to use the virtual pin assignment functionality
         bool ifUsePinAssignment() const { return _ifUsePinAssignment; }
+        /// @brief get whether to read the gds with the streaming bounding box reader
+        bool ifUseGdsStreamReader() const { return _ifUseGdsStreamReader; }
+        /// @brief get whether to write the global placement checkpoints
+        bool ifWriteGpCheckpoint() const { return _gpCheckpointFile != "" and _gpCheckpointInterval > 0; }
+        /// @brief get the global placement checkpoint file
+        const std::string & gpCheckpointFile() const { return _gpCheckpointFile; }
+        /// @brief get the number of outer iterations between two global placement checkpoints
+        IndexType gpCheckpointInterval() const { return _gpCheckpointInterval; }
+        /// @brief get whether to resume the global placement from a checkpoint
+        bool ifResumeGp() const { return _gpResumeFile != ""; }
+        /// @brief get the checkpoint file to resume the global placement from
+        const std::string & gpResumeFile() const { return _gpResumeFile; }
+        /// @brief get whether to use the placement result cache
+        bool ifUseResultCache() const { return _resultCacheDir != ""; }
+        /// @brief get the placement result cache directory
+        const std::string & resultCacheDir() const { return _resultCacheDir; }
         /// @brief get the number of thread
         IndexType numThreads() const { return _numThreads; }
         /// @brief get the grid step
@@ -74,9 +108,15 @@ class Parameters
         /// @brief get the default weighing factor of the relational constraints
         RealType defaultRelationalConstraintWeight() const { return _defaultRelationalConstraintWeight; }
     private:
+        friend class DatabaseSnapshot;
         Box<LocType> _boundaryConstraint = Box<LocType>(LOC_TYPE_MAX, LOC_TYPE_MAX, LOC_TYPE_MIN, LOC_TYPE_MIN);
         bool _ifUsePinAssignment; ///< If do pin assignment
+        bool _ifUseGdsStreamReader; ///< If read the gds by streaming into bounding boxes
         IndexType _numThreads;
+        std::string _gpCheckpointFile; ///< The file to write the global placement checkpoints
+        IndexType _gpCheckpointInterval; ///< The number of outer iterations between two checkpoints. 0 for no checkpoint
+        std::string _gpResumeFile; ///< The checkpoint to resume the global placement from
+        std::string _resultCacheDir; ///< The directory of the placement result cache. Empty for no cache
         LocType _gridStep;
         LocType _virtualBoundaryExtension; ///< The extension of current virtual boundary to the bounding box of placement
         LocType _virtualPinInterval; ///< The interval between each virtual pin
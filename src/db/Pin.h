@@ -68,6 +68,7 @@ class Pin
         /// @return the middle point location of the pin
         XY<LocType> midLoc() const { return _shape.center(); }
     private:
+        friend class DatabaseSnapshot;
         std::string _name = ""; ///< The name for the pin
         std::vector<IndexType> _netIdxArray; ///< The indices of nets connected to this pin
         IndexType _cellIdx = INDEX_TYPE_MAX; ///< The cell this pin belongs to. Each pin can belong on only one cell
@@ -0,0 +1,166 @@
+#include "ResultCache.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <unistd.h>
+#include "DatabaseSnapshot.h"
+#include "util/BinaryStream.h"
+#include "util/Hash.h"
+#include "util/MmapTokenizer.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace ResultCacheDetails
+{
+    constexpr char MAGIC[8] = {'I', 'D', 'E', 'A', 'C', 'A', 'C', 'H'};
+    constexpr std::uint64_t CHECK_SEED = 0x9E3779B97F4A7C15ULL;
+}
+
+void ResultCache::computeKey(LocType gridStep)
+{
+    // The snapshot leaves out the options of a run (threads, checkpoints, resuming and the cache). Also clear the ones only affecting how the inputs were read
+    Parameters para = _db.parameters();
+    _db.parameters().closeGdsStreamReader();
+    std::ostringstream oss;
+    DatabaseSnapshot(_db).write(oss);
+    _db.parameters() = para;
+    oss.write(reinterpret_cast<const char *>(&gridStep), sizeof(gridStep));
+    const std::string inputs = oss.str();
+    _key = ::klib::hash64(inputs);
+    _checkHash = ::klib::hash64(inputs, ResultCacheDetails::CHECK_SEED);
+    _inputSize = inputs.size();
+}
+
+std::string ResultCache::entryFile() const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.ideacache", static_cast<unsigned long long>(_key));
+    return (std::filesystem::path(_cacheDir) / name).string();
+}
+
+bool ResultCache::load(LocType &symAxis)
+{
+    using namespace ResultCacheDetails;
+    ::klib::MmapFile file;
+    if (!file.open(entryFile()))
+    {
+        return false;
+    }
+    ::klib::BinaryReader reader(file.content());
+    char magic[sizeof(MAGIC)];
+    for (char &c : magic)
+    {
+        reader.pod(c);
+    }
+    std::uint32_t version = 0;
+    std::uint64_t checkHash = 0, inputSize = 0;
+    reader.pod(version);
+    reader.pod(checkHash);
+    reader.pod(inputSize);
+    if (!reader.ok() || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION
+            || checkHash != _checkHash || inputSize != _inputSize)
+    {
+        WRN("ResultCache::%s %s does not match the inputs. Ignored \n", __FUNCTION__, entryFile().c_str());
+        return false;
+    }
+    LocType cachedSymAxis = 0;
+    std::vector<LocType> xLocs, yLocs, pinXs, pinYs;
+    std::vector<IndexType> pinNetIdxs;
+    std::vector<Byte> pinDirs;
+    reader.pod(cachedSymAxis);
+    reader.vec(xLocs);
+    reader.vec(yLocs);
+    reader.vec(pinXs);
+    reader.vec(pinYs);
+    reader.vec(pinNetIdxs);
+    reader.vec(pinDirs);
+    if (!reader.ok() || !reader.atEnd() || xLocs.size() != _db.numCells() || yLocs.size() != _db.numCells()
+            || pinXs.size() != _db.numNets() || pinYs.size() != _db.numNets()
+            || pinNetIdxs.size() != _db.numNets() || pinDirs.size() != _db.numNets())
+    {
+        WRN("ResultCache::%s %s is corrupted. Ignored \n", __FUNCTION__, entryFile().c_str());
+        return false;
+    }
+    for (IndexType cellIdx = 0; cellIdx < _db.numCells(); ++cellIdx)
+    {
+        _db.cell(cellIdx).setXLoc(xLocs[cellIdx]);
+        _db.cell(cellIdx).setYLoc(yLocs[cellIdx]);
+    }
+    for (IndexType netIdx = 0; netIdx < _db.numNets(); ++netIdx)
+    {
+        VirtualPin pin(XY<LocType>(pinXs[netIdx], pinYs[netIdx]));
+        if (pinNetIdxs[netIdx] != INDEX_TYPE_MAX)
+        {
+            pin.assign(pinNetIdxs[netIdx]);
+        }
+        pin.setDirection(static_cast<Direction2DType>(pinDirs[netIdx]));
+        _db.net(netIdx).setVirtualPin(pin);
+    }
+    symAxis = cachedSymAxis;
+    return true;
+}
+
+bool ResultCache::save(LocType symAxis) const
+{
+    using namespace ResultCacheDetails;
+    std::error_code ec;
+    std::filesystem::create_directories(_cacheDir, ec);
+    if (ec)
+    {
+        ERR("ResultCache::%s cannot create the cache directory %s \n", __FUNCTION__, _cacheDir.c_str());
+        return false;
+    }
+    std::vector<LocType> xLocs, yLocs, pinXs, pinYs;
+    std::vector<IndexType> pinNetIdxs;
+    std::vector<Byte> pinDirs;
+    for (IndexType cellIdx = 0; cellIdx < _db.numCells(); ++cellIdx)
+    {
+        xLocs.emplace_back(_db.cell(cellIdx).xLoc());
+        yLocs.emplace_back(_db.cell(cellIdx).yLoc());
+    }
+    for (IndexType netIdx = 0; netIdx < _db.numNets(); ++netIdx)
+    {
+        const auto &pin = _db.net(netIdx).virtualPin();
+        pinXs.emplace_back(pin.x());
+        pinYs.emplace_back(pin.y());
+        pinNetIdxs.emplace_back(pin.netIdx());
+        pinDirs.emplace_back(static_cast<Byte>(pin.direction()));
+    }
+    // Write into a temporary file and rename, so that a concurrent reader never sees a partial entry
+    const std::string filename = entryFile();
+    const std::string tempFilename = filename + ".tmp" + std::to_string(::getpid()) + "_" + std::to_string(reinterpret_cast<std::uintptr_t>(this));
+    {
+        ::klib::BinaryWriter writer(tempFilename);
+        for (char c : MAGIC)
+        {
+            writer.pod(c);
+        }
+        writer.pod(VERSION);
+        writer.pod(_checkHash);
+        writer.pod(_inputSize);
+        writer.pod(symAxis);
+        writer.vec(xLocs);
+        writer.vec(yLocs);
+        writer.vec(pinXs);
+        writer.vec(pinYs);
+        writer.vec(pinNetIdxs);
+        writer.vec(pinDirs);
+        writer.close();
+        if (!writer.good())
+        {
+            ERR("ResultCache::%s failed writing %s \n", __FUNCTION__, tempFilename.c_str());
+            std::remove(tempFilename.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tempFilename.c_str(), filename.c_str()) != 0)
+    {
+        ERR("ResultCache::%s failed renaming %s to %s \n", __FUNCTION__, tempFilename.c_str(), filename.c_str());
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+    return true;
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,53 @@
+/**
+ * @file ResultCache.h
+ * @brief On-disk cache of the placement results keyed by the hash of the inputs
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_RESULT_CACHE_H_
+#define IDEAPLACE_RESULT_CACHE_H_
+
+#include "Database.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class IDEAPLACE::ResultCache
+/// @brief cache the final cell locations, the io pins and the symmetric axis of a solving.
+/// The key is the hash of the database snapshot before solving, with the options not affecting the result (eg. the number of threads) cleared, plus the grid step.
+/// A second hash with a different seed is stored in the entry and checked on loading, so that a collision of the keys is not taken as a hit
+class ResultCache
+{
+    public:
+        /// @brief the version of the entry format. Need to be bumped whenever the layout of the entry or the placement algorithm changes
+        static constexpr std::uint32_t VERSION = 3;
+        /// @brief constructor
+        /// @param first: the placement database
+        /// @param second: the cache directory
+        explicit ResultCache(Database &db, const std::string &cacheDir) : _db(db), _cacheDir(cacheDir) {}
+        /// @brief compute the key from the current database. Need to be called before the solving changes the database
+        /// @param the grid step given to the solving
+        void computeKey(LocType gridStep);
+        /// @brief the key of the inputs
+        std::uint64_t key() const { return _key; }
+        /// @brief look up the cache, and write the cached results into the database if hit
+        /// @param output the symmetric axis
+        /// @return whether hit
+        bool load(LocType &symAxis);
+        /// @brief save the results in the database into the cache
+        /// @param the symmetric axis
+        /// @return if successful
+        bool save(LocType symAxis) const;
+    private:
+        /// @brief the file of the entry
+        std::string entryFile() const;
+    private:
+        Database &_db; ///< The placement database
+        std::string _cacheDir; ///< The cache directory
+        std::uint64_t _key = 0; ///< The hash of the inputs
+        std::uint64_t _checkHash = 0; ///< The hash of the inputs with a different seed
+        std::uint64_t _inputSize = 0; ///< The size of the hashed inputs
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //IDEAPLACE_RESULT_CACHE_H_
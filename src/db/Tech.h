@@ -137,6 +137,7 @@ class Tech
         /// @return the map from gds techlayer to IDEAPLACE layer
         std::unordered_map<IndexType, IndexType> & layerIdxMap() { return _layerIdxMap; }
     private:
+        friend class DatabaseSnapshot;
         LocType _dbu = 1000; ///< 1 um = _dbu database units
         std::unordered_map<IndexType, IndexType> _layerIdxMap; ///< A map from gds layer to IDEAPLACE layer. _layerIdxMap[techlayer] = layer index
         std::vector<IndexType> _gdsLayerIdxArray; ///< The tech layer in GDS. _gdsLayerIdx[idx of layer] = techlayer in GDS
@@ -28,4 +28,22 @@
 
 #define IDEAPLACE_DEFAULT_MAX_NUM_CELLS 100
 
+// Replace the global operator new/delete to count the allocations by stages. The counting is off until enabled at run time
+#define IDEAPLACE_TRACK_ALLOCATIONS
+
+// Build the hot numerical kernels for several x86-64 levels. The loader picks the clone for the host (cpuid) through ifunc, so one binary uses AVX2/FMA and AVX-512 where available
+// Only put it on the plain loops that vectorize. A loop calling std::exp or a std::function stays scalar, so its clones only add code
+#define IDEAPLACE_CPU_DISPATCH
+
+#if defined(IDEAPLACE_CPU_DISPATCH) && defined(__x86_64__) && defined(__linux__) && defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#define IDEAPLACE_MULTIVERSION __attribute__((target_clones("default", "arch=x86-64-v3", "arch=x86-64-v4")))
+#else
+#define IDEAPLACE_MULTIVERSION
+#endif
+
+// The messages less severe than the level are compiled out. 0: DBG, 1: INF, 2: WRN, 3: ERR
+#ifndef IDEAPLACE_MSG_MIN_LEVEL
+#define IDEAPLACE_MSG_MIN_LEVEL 0
+#endif
+
 #endif /// IDEAPLACE_DEFINE_H
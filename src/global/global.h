@@ -20,15 +20,25 @@
 
 PROJECT_NAMESPACE_BEGIN
 
+// Message printing. Macros instead of function aliases, so that the arguments of a filtered message are never evaluated
+#define IDEAPLACE_MSG(msgType, ...) \
+    do { \
+        if (::PROJECT_NAMESPACE::msgTypeLevel(msgType) >= IDEAPLACE_MSG_MIN_LEVEL && ::PROJECT_NAMESPACE::MsgPrinter::isEnabled(msgType)) \
+        { \
+            ::PROJECT_NAMESPACE::MsgPrinter::log(msgType, __VA_ARGS__); \
+        } \
+    } while (false)
+#define INF(...) IDEAPLACE_MSG(::PROJECT_NAMESPACE::MsgType::INF, __VA_ARGS__)
+#define WRN(...) IDEAPLACE_MSG(::PROJECT_NAMESPACE::MsgType::WRN, __VA_ARGS__)
+#define ERR(...) IDEAPLACE_MSG(::PROJECT_NAMESPACE::MsgType::ERR, __VA_ARGS__)
+#define DBG(...) IDEAPLACE_MSG(::PROJECT_NAMESPACE::MsgType::DBG, __VA_ARGS__)
+
 // Function aliases
-static const auto &INF = MsgPrinter::inf;
-static const auto &WRN = MsgPrinter::wrn;
-static const auto &ERR = MsgPrinter::err;
-static const auto &DBG = MsgPrinter::dbg;
 static const auto &WATCH_QUICK_START = klib::StopWatchMgr::quickStart;
 static const auto &WATCH_QUICK_END = klib::StopWatchMgr::quickEnd;
 static const auto &WATCH_CREATE_NEW = klib::StopWatchMgr::createNewStopWatch;;
 static const auto &WATCH_LOOK_RECORD_TIME = klib::StopWatchMgr::time;
+#define WATCH_SCOPE(name) KLIB_WATCH_SCOPE(name)
 
 PROJECT_NAMESPACE_END
 
@@ -0,0 +1,142 @@
+#include "BatchPlacer.h"
+#include <algorithm>
+#include <numeric>
+#include "util/WorkStealingPool.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+IndexType BatchPlacer::addJob(IdeaPlaceEx &placer, LocType gridStep, IndexType numThreads)
+{
+    Job job;
+    job.placer = &placer;
+    job.gridStep = gridStep;
+    job.numThreads = numThreads;
+    _jobs.emplace_back(job);
+    return _jobs.size() - 1;
+}
+
+IndexType BatchPlacer::threadBudget(const Job &job) const
+{
+    IndexType numThreads = job.numThreads;
+    if (numThreads == 0)
+    {
+        // The small blocks barely benefit from more threads. Give them to the large ones
+        numThreads = job.placer->numCells() / _numCellsPerThread;
+    }
+    return std::min(std::max(numThreads, static_cast<IndexType>(1)), _numThreads);
+}
+
+bool BatchPlacer::run()
+{
+    auto batchStart = std::chrono::steady_clock::now();
+    _isCancelled.store(false);
+    _numAvailableThreads = _numThreads;
+    for (auto &job : _jobs)
+    {
+        job.result = BatchJobResult();
+        job.result.numThreads = threadBudget(job);
+    }
+    // Largest first, so that the long jobs do not start last
+    std::vector<IndexType> order(_jobs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](IndexType lhs, IndexType rhs)
+            {
+                return _jobs[lhs].placer->numCells() > _jobs[rhs].placer->numCells();
+            });
+    INF("BatchPlacer::%s place %d circuits with %d threads \n", __FUNCTION__, static_cast<IndexType>(_jobs.size()), _numThreads);
+    {
+        ::klib::WorkStealingPool pool(std::min(_numThreads, static_cast<IndexType>(_jobs.size())));
+        for (IndexType jobIdx : order)
+        {
+            pool.submit([this, jobIdx, batchStart](IndexType workerIdx)
+                    {
+                        this->runJob(_jobs[jobIdx], workerIdx, batchStart);
+                    });
+        }
+        pool.wait();
+    }
+    _runtime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - batchStart).count();
+    bool allFinished = std::all_of(_jobs.begin(), _jobs.end(), [](const Job &job) { return job.result.isFinished; });
+    INF("BatchPlacer::%s finished in %lu us \n", __FUNCTION__, _runtime);
+    return allFinished;
+}
+
+void BatchPlacer::runJob(Job &job, IndexType workerIdx, std::chrono::steady_clock::time_point batchStart)
+{
+    auto &result = job.result;
+    result.workerIdx = workerIdx;
+    if (!acquireThreads(result.numThreads))
+    {
+        result.isCancelled = true;
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_threadMutex);
+        if (_isCancelled.load())
+        {
+            _numAvailableThreads += result.numThreads;
+            result.isCancelled = true;
+            return;
+        }
+        // Reset before registering, so that a cancel() from now on is not cleared by the solving
+        job.placer->_monitor.reset();
+        _runningPlacers.emplace_back(job.placer);
+    }
+    auto jobStart = std::chrono::steady_clock::now();
+    result.waitTime = std::chrono::duration_cast<std::chrono::microseconds>(jobStart - batchStart).count();
+    try
+    {
+        // The OpenMP setting is per thread. Set it on the worker
+        job.placer->setNumThreads(result.numThreads);
+        result.symAxis = job.placer->runSolve(job.gridStep, false, "");
+        job.placer->writeRunOutputs();
+        result.isFinished = true;
+    }
+    catch (const std::exception &e)
+    {
+        ERR("BatchPlacer::%s job failed: %s \n", __FUNCTION__, e.what());
+    }
+    result.runtime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - jobStart).count();
+    result.isCancelled = job.placer->isSolveCancelled();
+    {
+        std::lock_guard<std::mutex> lock(_threadMutex);
+        _runningPlacers.erase(std::find(_runningPlacers.begin(), _runningPlacers.end(), job.placer));
+    }
+    releaseThreads(result.numThreads);
+}
+
+bool BatchPlacer::acquireThreads(IndexType numThreads)
+{
+    std::unique_lock<std::mutex> lock(_threadMutex);
+    _threadReleased.wait(lock, [&]() { return _isCancelled.load() || _numAvailableThreads >= numThreads; });
+    if (_isCancelled.load())
+    {
+        return false;
+    }
+    _numAvailableThreads -= numThreads;
+    return true;
+}
+
+void BatchPlacer::releaseThreads(IndexType numThreads)
+{
+    {
+        std::lock_guard<std::mutex> lock(_threadMutex);
+        _numAvailableThreads += numThreads;
+    }
+    _threadReleased.notify_all();
+}
+
+void BatchPlacer::cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(_threadMutex);
+        _isCancelled.store(true);
+        for (auto placer : _runningPlacers)
+        {
+            placer->cancelSolve();
+        }
+    }
+    _threadReleased.notify_all();
+}
+
+PROJECT_NAMESPACE_END
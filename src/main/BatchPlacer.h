@@ -0,0 +1,93 @@
+/**
+ * @file BatchPlacer.h
+ * @brief Place a number of independent circuits on a shared thread pool
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_BATCH_PLACER_H_
+#define IDEAPLACE_BATCH_PLACER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include "IdeaPlaceEx.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief the result of one placement job in the batch
+struct BatchJobResult
+{
+    BoolType isFinished = false; ///< Whether the job has run to the end without error. A cancelled job is still finished with its partial placement
+    BoolType isCancelled = false; ///< Whether the job was cancelled
+    LocType symAxis = 0; ///< The return value of IdeaPlaceEx::solve()
+    IndexType numThreads = 0; ///< The number of threads used by the job
+    IndexType workerIdx = INDEX_TYPE_MAX; ///< The worker running the job
+    std::uint64_t waitTime = 0; ///< The time from the start of the batch to the start of the job. In us
+    std::uint64_t runtime = 0; ///< The runtime of the job. In us
+};
+
+/// @class IDEAPLACE::BatchPlacer
+/// @brief place the circuits each described by a prepared IdeaPlaceEx.
+/// The jobs are scheduled largest first onto a work-stealing pool. Each job gets a thread budget for its own OpenMP regions and LP solvers, and the running jobs never use more threads than the total in sum
+class BatchPlacer
+{
+    public:
+        /// @brief default constructor
+        explicit BatchPlacer() = default;
+        /// @brief add a job
+        /// @param first: the placer with the problem read in. Must outlive the batch and must not be used elsewhere during run()
+        /// @param second: the grid step passed to solve()
+        /// @param third: the number of threads for the job. 0 to decide by the number of cells
+        /// @return the index of the job
+        IndexType addJob(IdeaPlaceEx &placer, LocType gridStep = -1, IndexType numThreads = 0);
+        /// @brief set the total number of threads shared by the jobs
+        void setNumThreads(IndexType numThreads) { _numThreads = std::max(numThreads, static_cast<IndexType>(1)); }
+        /// @brief set the number of cells given one thread when deciding the thread budgets
+        void setNumCellsPerThread(IndexType numCellsPerThread) { _numCellsPerThread = std::max(numCellsPerThread, static_cast<IndexType>(1)); }
+        /// @brief run all the jobs and block until they are finished
+        /// @return whether all the jobs are finished
+        bool run();
+        /// @brief cancel the batch from another thread. The running jobs keep their partial placements, and the waiting jobs are skipped
+        void cancel();
+        /// @brief get the number of jobs
+        IndexType numJobs() const { return _jobs.size(); }
+        /// @brief get the result of a job
+        /// @param the index of the job
+        const BatchJobResult & result(IndexType jobIdx) const { return _jobs.at(jobIdx).result; }
+        /// @brief get the runtime of the last run(). In us
+        std::uint64_t runtime() const { return _runtime; }
+    private:
+        /// @brief a placement job
+        struct Job
+        {
+            IdeaPlaceEx *placer = nullptr; ///< The placer. Not owned
+            LocType gridStep = -1; ///< The grid step
+            IndexType numThreads = 0; ///< The requested number of threads. 0 for auto
+            BatchJobResult result; ///< The result
+        };
+        /// @brief decide the number of threads for a job
+        IndexType threadBudget(const Job &job) const;
+        /// @brief run one job on a worker
+        void runJob(Job &job, IndexType workerIdx, std::chrono::steady_clock::time_point batchStart);
+        /// @brief wait until the number of threads is available, and take them
+        /// @return false if the batch is cancelled while waiting
+        bool acquireThreads(IndexType numThreads);
+        /// @brief give back the threads
+        void releaseThreads(IndexType numThreads);
+    private:
+        std::vector<Job> _jobs; ///< The jobs
+        IndexType _numThreads = 1; ///< The total number of threads
+        IndexType _numCellsPerThread = 16; ///< The number of cells given one thread
+        std::uint64_t _runtime = 0; ///< The runtime of the last run
+        /* Sharing the threads among the running jobs */
+        std::mutex _threadMutex; ///< Protecting the number of available threads and the running jobs
+        std::condition_variable _threadReleased; ///< Notified when threads are given back or the batch is cancelled
+        IndexType _numAvailableThreads = 0; ///< The number of threads not used by the running jobs
+        std::atomic<bool> _isCancelled{false}; ///< Whether the batch is cancelled
+        std::vector<IdeaPlaceEx *> _runningPlacers; ///< The placers being solved
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //IDEAPLACE_BATCH_PLACER_H_
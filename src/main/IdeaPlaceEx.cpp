@@ -9,12 +9,15 @@
 #include "parser/ParserSymFile.h"
 #include "parser/ParserSymNet.h"
 #include "parser/ParserSignalPath.h"
+#include "db/DatabaseSnapshot.h"
+#include "db/ResultCache.h"
 /* Placement */
 #include "pinassign/VirtualPinAssigner.h"
-#include "place/ProximityMgr.h"
 /* Post-Processing */
 #include "place/alignGrid.h"
 #include <omp.h>
+#include <sstream>
+#include "util/MemoryTracker.h"
 
 PROJECT_NAMESPACE_BEGIN
 
@@ -59,6 +62,11 @@ void IdeaPlaceEx::readGdsLayout(const std::string &gdsFile, IndexType cellIdx)
     WRN("Ideaplace: Using file parser %s. This is designed for internal debugging only and may not be kept maintained \n", __FUNCTION__);
     ParserCellGds(_db).parseCellGds(gdsFile, cellIdx);
 }
+bool IdeaPlaceEx::readGdsLayouts(const std::vector<std::string> &gdsFiles, const std::vector<IndexType> &cellIdxs)
+{
+    WRN("Ideaplace: Using file parser %s. This is designed for internal debugging only and may not be kept maintained \n", __FUNCTION__);
+    return ParserCellGdsDetails::parseAllGdsFiles(_db, gdsFiles, cellIdxs);
+}
 void IdeaPlaceEx::readSymNetFile(const std::string &symnetFile)
 {
     WRN("Ideaplace: Using file parser %s. This is designed for internal debugging only and may not be kept maintained \n", __FUNCTION__);
@@ -77,6 +85,19 @@ bool IdeaPlaceEx::parseFileBased(int argc, char **argv)
     // Start message printer timer
     MsgPrinter::startTimer();
 
+    if (_args.snapshotFileIsSet())
+    {
+        // The snapshot contains everything. Skip the other files
+        INF("IdeaPlaceEx::%s Read in the database snapshot ... \n", __FUNCTION__);
+        if (!loadSnapshot(_args.snapshotFile()))
+        {
+            return false;
+        }
+        // The snapshot does not save the options of a run, so the checkpoint, cache and thread options are only from this run
+        applyRunArgs(_args);
+        return true;
+    }
+    applyRunArgs(_args);
     if (!_args.techsimpleFileIsSet())
     {
         ERR("IdeaPlaceEx::%s no techsimple file is given! \n", __FUNCTION__);
@@ -138,6 +159,15 @@ bool IdeaPlaceEx::parseFileBased(int argc, char **argv)
     
     // Parsing the gds files...
     ParserCellGdsDetails::parseAllGdsFiles(_db, _args.gdsFiles());
+
+    if (_args.saveSnapshotFileIsSet())
+    {
+        INF("IdeaPlaceEx::%s Save the database snapshot ... \n", __FUNCTION__);
+        if (!saveSnapshot(_args.saveSnapshotFile()))
+        {
+            return false;
+        }
+    }
     return true;
 }
 
@@ -163,13 +193,96 @@ void IdeaPlaceEx::writeConstraint(CGLegalizer & legalizer, std::string fileName)
     }
 }
 
+IdeaPlaceEx::~IdeaPlaceEx()
+{
+    if (_solveFuture.valid())
+    {
+        // The callback may refer to the objects destroyed together
+        _monitor.setCallback(nullptr);
+        _monitor.cancel();
+        _solveFuture.wait();
+    }
+}
+
 LocType IdeaPlaceEx::solve(LocType gridStep, bool writeConst, std::string fileName)
+{
+    _monitor.reset();
+    LocType symAxis = runSolve(gridStep, writeConst, fileName);
+    writeRunOutputs();
+    return symAxis;
+}
+
+void IdeaPlaceEx::writeRunOutputs()
+{
+    if (_traceFile != "")
+    {
+        writeTrace(_traceFile);
+    }
+    if (_isPerfReportOn)
+    {
+        INF("IdeaPlaceEx:: hardware counters \n%s", perfReport().c_str());
+    }
+    if (_isMemoryReportOn)
+    {
+        INF("IdeaPlaceEx:: memory usage \n%s", memoryReport().c_str());
+    }
+    if (_convergenceTraceFile != "")
+    {
+        writeConvergenceTrace(_convergenceTraceFile);
+    }
+}
+
+std::shared_future<LocType> IdeaPlaceEx::solveAsync(LocType gridStep, bool writeConst, std::string fileName)
+{
+    if (_solveFuture.valid() && !isSolveDone())
+    {
+        WRN("IdeaPlaceEx::%s the previous solving is still running \n", __FUNCTION__);
+        return _solveFuture;
+    }
+    // Reset here instead of in the new thread, so that a cancellation right after returning is not lost
+    _monitor.reset();
+    auto run = [this, gridStep, writeConst, fileName]()
+    {
+        LocType symAxis = runSolve(gridStep, writeConst, fileName);
+        writeRunOutputs();
+        return symAxis;
+    };
+    _solveFuture = std::async(std::launch::async, run).share();
+    return _solveFuture;
+}
+
+LocType IdeaPlaceEx::waitSolve()
+{
+    if (!_solveFuture.valid())
+    {
+        ERR("IdeaPlaceEx::%s no asynchronous solving was started \n", __FUNCTION__);
+        return 0;
+    }
+    return _solveFuture.get();
+}
+
+bool IdeaPlaceEx::isSolveDone() const
+{
+    return !_solveFuture.valid() || _solveFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+LocType IdeaPlaceEx::runSolve(LocType gridStep, bool writeConst, std::string fileName)
 {
     auto stopWatch = WATCH_CREATE_NEW("IdeaPlaceEx");
     stopWatch->start();
+    ::klib::MemoryStageRecorder memoryRecorder(_memoryStats);
+    memoryRecorder.beginStage("initialization");
+    _convergenceTrace.clear();
     omp_set_num_threads(_db.parameters().numThreads());
     // Start message printer timer
     MsgPrinter::startTimer();
+    // The key need to be from the inputs, before anything is changed by the solving
+    const bool useResultCache = _db.parameters().ifUseResultCache();
+    ResultCache resultCache(_db, _db.parameters().resultCacheDir());
+    if (useResultCache)
+    {
+        resultCache.computeKey(gridStep);
+    }
     // Solve cleaning up tasks for safe...
     for (IndexType cellIdx = 0; cellIdx < _db.numCells(); ++cellIdx)
     {
@@ -185,35 +298,57 @@ LocType IdeaPlaceEx::solve(LocType gridStep, bool writeConst, std::string fileNa
         _db.expandCellToGridSize(gridStep);
     }
 
-    // Set proximity group
-    ProximityMgr proximityMgr(_db);
-    proximityMgr.applyProximityWithDummyNets();
+    // The constraints can only be written from a legalizer, so a cached result is not used then
+    if (useResultCache and not writeConst)
+    {
+        LocType cachedSymAxis = 0;
+        if (resultCache.load(cachedSymAxis))
+        {
+            INF("Ideaplace: Reuse the cached placement %016llx \n", static_cast<unsigned long long>(resultCache.key()));
+            _db.splitSignalPathsBySymPairs();
+            stopWatch->stop();
+            _monitor.reportStage(SolveStageType::FINISHED);
+            return cachedSymAxis;
+        }
+    }
 
     // Clean up the signal path
     _db.splitSignalPathsBySymPairs();
 
     INF("Ideaplace: Entering global placement...\n");
 
+    _monitor.reportStage(SolveStageType::GLOBAL_PLACEMENT);
+    memoryRecorder.beginStage("globalPlacement");
     NlpGPlacerFirstOrder<nlp::nlp_default_settings> placer(_db);
+    placer.setMonitor(&_monitor);
+    placer.setConvergenceTrace(_isConvergenceTraceOn ? &_convergenceTrace : nullptr);
     placer.solve();
 #ifdef DEBUG_GR
 #ifdef DEBUG_DRAW
     _db.drawCellBlocks("./debug/after_gr.gds");
 #endif //DEBUG_DRAW
 #endif
-    INF("Ideaplace: Entering legalization and detailed placement...\n");
+    memoryRecorder.beginStage("legalization");
     CGLegalizer legalizer(_db);
-    bool legalizeResult = legalizer.legalize();
-    INF("Ideaplace: Assigning IO pin...\n");
-    VirtualPinAssigner pinAssigner(_db);
-    pinAssigner.solveFromDB();
+    legalizer.setMonitor(&_monitor);
+    if (!_monitor.isCancelRequested())
+    {
+        INF("Ideaplace: Entering legalization and detailed placement...\n");
+        legalizer.legalize();
+    }
+    memoryRecorder.beginStage("pinAssignment");
+    if (!_monitor.reportStage(SolveStageType::PIN_ASSIGNMENT))
+    {
+        WATCH_SCOPE("pinAssignment");
+        INF("Ideaplace: Assigning IO pin...\n");
+        VirtualPinAssigner pinAssigner(_db);
+        pinAssigner.solveFromDB();
+    }
+    memoryRecorder.beginStage("finalization");
     INF("IdeaPlaceEx:: HPWL %d \n", _db.hpwl());
     INF("IdeaPlaceEx:: HPWL with virtual pin: %d \n",  _db.hpwlWithVitualPins());
     LocType symAxis(0);
 
-    // Restore proxmity group
-    proximityMgr.restore();
-
     // stats for sigpath current path
     LocType sigHpwl = 0;
     LocType crfOverflow = 0;
@@ -251,14 +386,17 @@ LocType IdeaPlaceEx::solve(LocType gridStep, bool writeConst, std::string fileNa
 
     _db.checkSym();
 
-    if (gridStep > 0)
     {
-        INF("Ideaplace: Aligning the placement to grid...\n");
-        symAxis = alignToGrid(gridStep);
-    }
-    else
-    {
-        symAxis = alignToGrid(1);
+        WATCH_SCOPE("alignToGrid");
+        if (gridStep > 0)
+        {
+            INF("Ideaplace: Aligning the placement to grid...\n");
+            symAxis = alignToGrid(gridStep);
+        }
+        else
+        {
+            symAxis = alignToGrid(1);
+        }
     }
 
 #ifdef DEBUG_GR
@@ -268,10 +406,24 @@ LocType IdeaPlaceEx::solve(LocType gridStep, bool writeConst, std::string fileNa
 #endif
 
     stopWatch->stop();
+    memoryRecorder.endStage();
 
     if (writeConst)
         writeConstraint(legalizer, fileName);
 
+    if (_monitor.isCancelRequested())
+    {
+        WRN("Ideaplace: cancelled. Output the best partial placement \n");
+        _monitor.reportStage(SolveStageType::CANCELLED);
+    }
+    else
+    {
+        if (useResultCache)
+        {
+            resultCache.save(symAxis);
+        }
+        _monitor.reportStage(SolveStageType::FINISHED);
+    }
 
     return symAxis;
 }
@@ -281,18 +433,134 @@ bool IdeaPlaceEx::outputFileBased(int , char **)
     return true;
 }
 
-IndexType IdeaPlaceEx::cellIdxName(const std::string name)
+void IdeaPlaceEx::applyRunArgs(const ProgArgs &args)
 {
-    IndexType cellIdx = INDEX_TYPE_MAX;
-    for (IndexType idx = 0; idx < _db.numCells(); ++idx)
+    if (args.gpCheckpointFileIsSet())
     {
-        if (_db.cell(idx).name() == name)
-        {
-            cellIdx = idx;
-            break;
-        }
+        openGpCheckpoint(args.gpCheckpointFile(), args.gpCheckpointInterval());
+    }
+    if (args.gpResumeFileIsSet())
+    {
+        setGpResumeFile(args.gpResumeFile());
+    }
+    if (args.resultCacheDirIsSet())
+    {
+        openResultCache(args.resultCacheDir());
+    }
+    if (args.traceFileIsSet())
+    {
+        enableTrace();
+        _traceFile = args.traceFile();
+    }
+    if (args.perfCounters())
+    {
+        _isPerfReportOn = enablePerfCounters();
+    }
+    if (args.asyncLog())
+    {
+        startAsyncLog();
+    }
+    if (args.memReport())
+    {
+        enableMemoryTracking();
+        _isMemoryReportOn = true;
+    }
+    if (args.convergenceTraceFileIsSet())
+    {
+        enableConvergenceTrace();
+        _convergenceTraceFile = args.convergenceTraceFile();
+    }
+}
+
+bool IdeaPlaceEx::writeConvergenceTrace(const std::string &filename) const
+{
+    const std::string csvExt = ".csv";
+    bool isCsv = filename.size() >= csvExt.size() && filename.compare(filename.size() - csvExt.size(), csvExt.size(), csvExt) == 0;
+    if (!(isCsv ? _convergenceTrace.writeCsv(filename) : _convergenceTrace.writeBinary(filename)))
+    {
+        ERR("IdeaPlaceEx::%s cannot write the convergence trace into %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    INF("IdeaPlaceEx::%s write %d iterations into %s \n", __FUNCTION__, _convergenceTrace.numRows(), filename.c_str());
+    return true;
+}
+
+void IdeaPlaceEx::enableMemoryTracking()
+{
+    if (!::klib::MemoryTracker::isAllocationTrackingAvailable())
+    {
+        WRN("IdeaPlaceEx::%s built without IDEAPLACE_TRACK_ALLOCATIONS. Only the resident memory is reported \n", __FUNCTION__);
     }
-    return cellIdx;
+    ::klib::MemoryTracker::enable();
+}
+
+std::string IdeaPlaceEx::memoryReport() const
+{
+    auto mb = [](double bytes) { return bytes / (1024.0 * 1024.0); };
+    std::string report;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-18s %12s %12s %12s %12s %10s %10s\n",
+            "stage", "allocs", "alloc(MB)", "peakHeap(MB)", "netHeap(MB)", "rss(MB)", "peakRss(MB)");
+    report += line;
+    for (const auto &stats : _memoryStats)
+    {
+        std::snprintf(line, sizeof(line), "%-18s %12lu %12.2f %12.2f %12.2f %10.2f %10.2f\n",
+                stats.stage.c_str(), static_cast<unsigned long>(stats.numAllocs), mb(stats.allocBytes),
+                mb(stats.peakHeapBytes), mb(stats.netHeapBytes), mb(stats.rssBytes), mb(stats.peakRssBytes));
+        report += line;
+    }
+    return report;
+}
+
+bool IdeaPlaceEx::writeTrace(const std::string &filename)
+{
+    if (!::klib::StopWatchMgr::writeChromeTrace(filename))
+    {
+        ERR("IdeaPlaceEx::%s cannot write the trace into %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    INF("IdeaPlaceEx::%s write the trace into %s \n", __FUNCTION__, filename.c_str());
+    return true;
+}
+
+bool IdeaPlaceEx::enablePerfCounters()
+{
+    if (!::klib::PerfCounters::enable())
+    {
+        WRN("IdeaPlaceEx::%s hardware counters are not available (no PMU or restricted by perf_event_paranoid). Only the time is measured \n", __FUNCTION__);
+        ::klib::PerfCounters::disable();
+        return false;
+    }
+    return true;
+}
+
+std::string IdeaPlaceEx::perfReport()
+{
+    std::ostringstream oss;
+    ::klib::StopWatchMgr::writePerfReport(oss);
+    return oss.str();
+}
+
+std::string IdeaPlaceEx::profileReport()
+{
+    std::ostringstream oss;
+    ::klib::StopWatchMgr::writeProfile(oss);
+    return oss.str();
+}
+
+bool IdeaPlaceEx::saveSnapshot(const std::string &snapshotFile)
+{
+    return DatabaseSnapshot(_db).save(snapshotFile);
+}
+
+bool IdeaPlaceEx::loadSnapshot(const std::string &snapshotFile)
+{
+    return DatabaseSnapshot(_db).load(snapshotFile);
+}
+
+IndexType IdeaPlaceEx::cellIdxName(const std::string name)
+{
+    return _db.cellIdxByName(name);
 }
 
 LocType IdeaPlaceEx::alignToGrid(LocType gridStepSize)
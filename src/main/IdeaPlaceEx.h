@@ -8,22 +8,32 @@
 #ifndef IDEAPLACE_IDEAPLACEEX_H_
 #define IDEAPLACE_IDEAPLACEEX_H_
 
+#include <future>
 #include <string>
 #include "db/Database.h"
+#include "db/NetlistGenerator.h"
 /* Solver */
 #include "place/CGLegalizer.h"
 #include "place/NlpGPlacer.h"
+#include "place/SolveMonitor.h"
+#include "place/ConvergenceTrace.h"
+#include "util/MemoryTracker.h"
 
 PROJECT_NAMESPACE_BEGIN
 
+class ProgArgs;
 
 /// @class IDEAPLACE::IdeaPlaceEx
 /// @brief the main wrapper for the placement engine
 class IdeaPlaceEx
 {
+    friend class BatchPlacer;
+    friend class PlacementBenchmark;
     public:
         /// @brief default constructor
         explicit IdeaPlaceEx() = default;
+        /// @brief destructor. Cancel and wait for the asynchronous solving if it is running
+        ~IdeaPlaceEx();
         /// @brief the file-based input
         /// @param the system arguments
         /// @return if the parsing is successful
@@ -31,6 +41,23 @@ class IdeaPlaceEx
         /// @brief run the placement algorithm
         /// @return whether the placement is successful
         LocType solve(LocType gridSize = -1, bool writeConst=false, std::string filename="");
+        /// @brief run the placement algorithm in a new thread. The database must not be accessed until the solving finishes
+        /// @return the future of the result of solve()
+        std::shared_future<LocType> solveAsync(LocType gridSize = -1, bool writeConst=false, std::string filename="");
+        /// @brief wait for the asynchronous solving
+        /// @return the result of solve()
+        LocType waitSolve();
+        /// @brief whether the asynchronous solving has finished
+        bool isSolveDone() const;
+        /// @brief request the running solving to stop at the next outer iteration or LP. The best partial placement is kept
+        void cancelSolve() { _monitor.cancel(); }
+        /// @brief whether the last solving was cancelled
+        bool isSolveCancelled() const { return _monitor.isCancelRequested(); }
+        /// @brief get the latest progress of the solving
+        SolveProgress solveProgress() const { return _monitor.progress(); }
+        /// @brief set the callback for the progress events. It is called from the thread running the placement
+        /// @param the callback. Empty to remove
+        void setProgressCallback(SolveMonitor::callback_type callback) { _monitor.setCallback(std::move(callback)); }
         void writeConstraint(CGLegalizer & legalizer, std::string fileName="");
         /// @brief the file-based output
         /// @param the system arguments
@@ -61,12 +88,30 @@ class IdeaPlaceEx
         /// @param first: the filename for gds layout file
         /// @param second: the cell index. if INDEX_TYPE_MAX, then will try to match the gds cellname
         void readGdsLayout(const std::string &gdsFile, IndexType cellIdx=INDEX_TYPE_MAX);
+        /// @brief read the gds for a number of cells. The files are parsed in parallel
+        /// @param first: the filenames for gds layout files
+        /// @param second: the cell indices, one for each file. If empty, then will try to match the gds cellnames
+        /// @return if successful
+        bool readGdsLayouts(const std::vector<std::string> &gdsFiles, const std::vector<IndexType> &cellIdxs);
         /// @brief read the symnet file
         /// @param the filename for the symnet file
         void readSymNetFile(const std::string &symnetFile);
         /// @brief read the sigpath file
         /// @param the filename for the sigpath file
         void readSigpathFile(const std::string &sigpathFile);
+        /// @brief save the whole database into a binary snapshot
+        /// @param the filename for the snapshot
+        /// @return if successful
+        bool saveSnapshot(const std::string &snapshotFile);
+        /// @brief load the whole database from a binary snapshot. Replace everything read or added before
+        /// @param the filename for the snapshot
+        /// @return if successful
+        bool loadSnapshot(const std::string &snapshotFile);
+        /// @brief generate a synthetic problem from the common analog building blocks, for the scaling experiments. Need an empty placer
+        /// @param first: the number of cells
+        /// @param second: the seed of the random numbers. The same seed gives the same problem
+        /// @return if successful
+        bool generateSyntheticNetlist(IndexType numCells, std::uint64_t seed = 1) { return NetlistGenerator(numCells, seed).generate(_db); }
         /*------------------------------*/ 
         /* paramters                    */
         /*------------------------------*/ 
@@ -106,7 +151,7 @@ class IdeaPlaceEx
         {
             auto pinIdx =  _db.allocatePin();
             _db.pin(pinIdx).setCellIdx(cellIdx);
-            _db.cell(cellIdx).addPin(pinIdx);
+            _db.addPinToCell(cellIdx, pinIdx);
             return pinIdx;
         }
         /// @brief set the name of a pin
@@ -114,7 +159,7 @@ class IdeaPlaceEx
         /// @param the name of the pin
         void setPinName(IndexType pinIdx, const std::string &name)
         {
-            _db.pin(pinIdx).setName(name);
+            _db.setPinName(pinIdx, name);
         }
         /// @brief add pin shape for a pin
         /// @param the index of the pin
@@ -135,7 +180,7 @@ class IdeaPlaceEx
         /// @brief set the name of a net
         /// @param first: the index of the net
         /// @param second: the net name
-        void setNetName(IndexType netIdx, const std::string &netName) { _db.net(netIdx).setName(netName); }
+        void setNetName(IndexType netIdx, const std::string &netName) { _db.setNetName(netIdx, netName); }
         /// @brief add pin to net
         /// @param first: the pin index
         /// @param second: the net index
@@ -240,6 +285,24 @@ class IdeaPlaceEx
         void openVirtualPinAssignment() { _db.parameters().openVirtualPinAssignment(); }
         /// @brief close the functionality of virtual pin assignment 
         void closeVirtualPinAssignment() { _db.parameters().closeVirtualPinAssignment(); }
+        /// @brief read the gds layouts by streaming the shapes into the bounding boxes, without building the gds database
+        void openGdsStreamReader() { _db.parameters().openGdsStreamReader(); }
+        /// @brief read the gds layouts by flattening the full gds database
+        void closeGdsStreamReader() { _db.parameters().closeGdsStreamReader(); }
+        /// @brief write the global placement checkpoints between the outer iterations
+        /// @param first: the checkpoint file. Overwritten by each checkpoint
+        /// @param second: the number of outer iterations between two checkpoints
+        void openGpCheckpoint(const std::string &file, IndexType interval) { _db.parameters().openGpCheckpoint(file, interval); }
+        /// @brief stop writing the global placement checkpoints
+        void closeGpCheckpoint() { _db.parameters().closeGpCheckpoint(); }
+        /// @brief resume the global placement from a checkpoint. Empty to start from scratch
+        /// @param the checkpoint file
+        void setGpResumeFile(const std::string &file) { _db.parameters().setGpResumeFile(file); }
+        /// @brief cache the placement results in a directory. A solving with the same inputs returns the cached results directly
+        /// @param the cache directory
+        void openResultCache(const std::string &cacheDir) { _db.parameters().openResultCache(cacheDir); }
+        /// @brief stop using the placement result cache
+        void closeResultCache() { _db.parameters().closeResultCache(); }
         /// @brief set net to be io pin
         void markAsIoNet(IndexType netIdx) { _db.net(netIdx).setIsIo(true); }
         /// @brief remove io net mark
@@ -367,11 +430,81 @@ class IdeaPlaceEx
         {
             return WATCH_LOOK_RECORD_TIME("detailedPlacement");
         }
+        /// @brief start recording the timing intervals of all the threads for the trace. Off by default
+        void enableTrace() { ::klib::StopWatchMgr::enableTrace(); }
+        /// @brief stop recording the timing intervals. The recorded ones are kept
+        void disableTrace() { ::klib::StopWatchMgr::disableTrace(); }
+        /// @brief drop the recorded timing intervals
+        void clearTrace() { ::klib::StopWatchMgr::clearTrace(); }
+        /// @brief write the recorded timing intervals in the Chrome trace_event format
+        /// @param the file name
+        /// @return if successful
+        bool writeTrace(const std::string &filename);
+        /// @brief get the recorded timing intervals summarized as a tree of the nested scopes
+        std::string profileReport();
+        /// @brief count the hardware events (cycles, instructions, cache misses, branch misses) in the timed stages. Off by default.
+        /// Only the thread starting and stopping a stage is counted, not the OpenMP workers
+        /// @return false if the counters are not available. The timing is not affected then
+        bool enablePerfCounters();
+        /// @brief stop counting the hardware events
+        void disablePerfCounters() { ::klib::PerfCounters::disable(); }
+        /// @brief get the hardware counts of the timed stages
+        /// @param the name of the stage, eg. "GP_calculate_obj", "legalization"
+        /// @return cycles, instructions, cache misses, branch misses
+        std::array<std::uint64_t, 4> perfCounters(const std::string &stage) { return ::klib::StopWatchMgr::perfCounters(stage).values; }
+        /// @brief get the hardware counts of the timed stages with the derived ratios
+        std::string perfReport();
+        /* Memory */
+        /// @brief count the heap allocations by the stages of solve(). Off by default. The resident memory is recorded regardless
+        void enableMemoryTracking();
+        /// @brief stop counting the heap allocations
+        void disableMemoryTracking() { ::klib::MemoryTracker::disable(); }
+        /// @brief get the memory usage of each stage in the last solve()
+        const std::vector<::klib::MemoryStats> & memoryStats() const { return _memoryStats; }
+        /// @brief get the memory usage of each stage in the last solve() as a table
+        std::string memoryReport() const;
+        /* Convergence trace */
+        /// @brief record the objectives, gradient norm, step size, multipliers and alpha of each global placement iteration. Off by default.
+        /// Evaluates the objectives once more per iteration
+        void enableConvergenceTrace() { _isConvergenceTraceOn = true; }
+        /// @brief stop recording the global placement iterations
+        void disableConvergenceTrace() { _isConvergenceTraceOn = false; }
+        /// @brief get the global placement iterations recorded in the last solve()
+        const ConvergenceTrace & convergenceTrace() const { return _convergenceTrace; }
+        /// @brief write the recorded global placement iterations
+        /// @param the file name. Comma-separated values if ending with .csv, otherwise the binary columns
+        /// @return if successful
+        bool writeConvergenceTrace(const std::string &filename) const;
+        /* Messages */
+        /// @brief only print the messages at least as severe as the type. The filtered messages cost nearly nothing
+        void setMinMsgType(MsgType msgType) { MsgPrinter::setMinMsgType(msgType); }
+        /// @brief format and write the messages (except the errors) in a background thread. Shared by all the placers
+        /// @param the size of the message buffer of each thread, in bytes
+        void startAsyncLog(IndexType bufferSize = 1 << 18) { MsgPrinter::startAsync(bufferSize); }
+        /// @brief write the pending messages and go back to writing them at once
+        void stopAsyncLog() { MsgPrinter::stopAsync(); }
 
         LocType hpwl() { return _db.hpwlWithVitualPins(); }
 
+    protected:
+        /// @brief run the placement algorithm with the current monitor
+        LocType runSolve(LocType gridSize, bool writeConst, std::string filename);
+        /// @brief write the outputs requested for after each solving: the trace, the hardware counters, the memory usage and the convergence trace
+        void writeRunOutputs();
+        /// @brief set the options only for this run (checkpoint, result cache) from the program arguments
+        /// @param the program arguments
+        void applyRunArgs(const ProgArgs &args);
     protected:
         Database _db; ///< The placement engine database 
+        SolveMonitor _monitor; ///< The progress and cancellation of the solving
+        std::shared_future<LocType> _solveFuture; ///< The result of the asynchronous solving
+        std::string _traceFile = ""; ///< The file to write the trace after each solving. Empty for not writing
+        bool _isPerfReportOn = false; ///< Whether to print the hardware counts after each solving
+        std::vector<::klib::MemoryStats> _memoryStats; ///< The memory usage of each stage in the last solving
+        bool _isMemoryReportOn = false; ///< Whether to print the memory usage after each solving
+        ConvergenceTrace _convergenceTrace; ///< The global placement iterations of the last solving
+        bool _isConvergenceTraceOn = false; ///< Whether to record the global placement iterations
+        std::string _convergenceTraceFile = ""; ///< The file to write the global placement iterations after each solving. Empty for not writing
 };
 
 PROJECT_NAMESPACE_END
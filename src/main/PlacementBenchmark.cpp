@@ -0,0 +1,305 @@
+#include "PlacementBenchmark.h"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace PlacementBenchmarkDetails
+{
+    /// @brief the reported stages and the stop watches timing them
+    const std::vector<std::pair<std::string, std::string>> STAGES = {
+        {"globalPlacement", "NlpGPlacer"},
+        {"constraintGeneration", "constraintGeneration"},
+        {"lpLegalization", "lpLegalization"},
+        {"detailedPlacement", "detailedPlacement"},
+        {"pinAssignment", "pinAssignment"},
+        {"gridAlignment", "alignToGrid"},
+        {"total", "IdeaPlaceEx"}
+    };
+    constexpr std::uint32_t VERSION = 1;
+
+    /// @brief quote a string for JSON
+    inline std::string quote(const std::string &str)
+    {
+        std::string quoted = "\"";
+        for (char c : str)
+        {
+            if (c == '"' or c == '\\')
+            {
+                quoted += '\\';
+            }
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    /// @brief write a JSON object of numbers
+    inline void writeObject(std::ostream &os, const std::map<std::string, RealType> &values)
+    {
+        os << "{";
+        bool isFirst = true;
+        for (const auto &pair : values)
+        {
+            os << (isFirst ? "" : ", ") << quote(pair.first) << ": " << pair.second;
+            isFirst = false;
+        }
+        os << "}";
+    }
+}
+
+void PlacementBenchmark::addGeneratedCase(const std::string &name, IndexType numCells, std::uint64_t seed)
+{
+    PlacementBenchmarkCase benchCase;
+    benchCase.name = name;
+    benchCase.numCells = numCells;
+    benchCase.seed = seed;
+    addCase(benchCase);
+}
+
+void PlacementBenchmark::addDefaultCorpus()
+{
+    // The global placer keeps the partials of an operator in arrays of IDEAPLACE_DEFAULT_MAX_NUM_CELLS
+    addGeneratedCase("gen20", 20, 1);
+    addGeneratedCase("gen50", 50, 2);
+    addGeneratedCase("gen80", 80, 3);
+}
+
+bool PlacementBenchmark::readCorpus(const std::string &filename)
+{
+    std::ifstream in(filename);
+    if (!in.good())
+    {
+        ERR("PlacementBenchmark::%s cannot open %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    std::string line;
+    IndexType lineIdx = 0;
+    while (std::getline(in, line))
+    {
+        ++lineIdx;
+        line = line.substr(0, line.find('#'));
+        std::istringstream iss(line);
+        std::vector<std::string> words;
+        std::string word;
+        while (iss >> word)
+        {
+            words.emplace_back(word);
+        }
+        if (words.empty())
+        {
+            continue;
+        }
+        if (words.size() < 2)
+        {
+            ERR("PlacementBenchmark::%s %s:%d no problem is given for %s \n", __FUNCTION__, filename.c_str(), lineIdx, words[0].c_str());
+            return false;
+        }
+        if (words[1] == "generate")
+        {
+            IntType numCells = 0;
+            std::uint64_t seed = 1;
+            std::istringstream numbers(line.substr(line.find("generate") + 8));
+            if (!(numbers >> numCells) or numCells <= 0)
+            {
+                ERR("PlacementBenchmark::%s %s:%d expect the number of cells of %s \n", __FUNCTION__, filename.c_str(), lineIdx, words[0].c_str());
+                return false;
+            }
+            numbers >> seed;
+            addGeneratedCase(words[0], numCells, seed);
+        }
+        else
+        {
+            PlacementBenchmarkCase benchCase;
+            benchCase.name = words[0];
+            benchCase.args.assign(words.begin() + 1, words.end());
+            addCase(benchCase);
+        }
+    }
+    return true;
+}
+
+bool PlacementBenchmark::run()
+{
+    using namespace PlacementBenchmarkDetails;
+    _results.clear();
+    bool success = true;
+    for (const auto &benchCase : _cases)
+    {
+        PlacementBenchmarkResult result;
+        result.name = benchCase.name;
+        bool isRead = true;
+        for (IndexType repeatIdx = 0; repeatIdx < _numRepeats and isRead; ++repeatIdx)
+        {
+            isRead = runCase(benchCase, result);
+        }
+        if (!isRead)
+        {
+            ERR("PlacementBenchmark::%s cannot read %s. Skipped \n", __FUNCTION__, benchCase.name.c_str());
+            success = false;
+            continue;
+        }
+        INF("PlacementBenchmark::%s %s: %d cells, %.3f s, HPWL %.0f \n", __FUNCTION__, result.name.c_str(), result.numCells,
+                result.stageSeconds["total"], result.metrics["hpwl"]);
+        _results.emplace_back(result);
+    }
+    return success;
+}
+
+bool PlacementBenchmark::runCase(const PlacementBenchmarkCase &benchCase, PlacementBenchmarkResult &result)
+{
+    using namespace PlacementBenchmarkDetails;
+    IdeaPlaceEx placer;
+    if (benchCase.args.empty())
+    {
+        if (!placer.generateSyntheticNetlist(benchCase.numCells, benchCase.seed))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        std::vector<std::string> args = {benchCase.name};
+        args.insert(args.end(), benchCase.args.begin(), benchCase.args.end());
+        std::vector<char *> argv;
+        for (auto &arg : args)
+        {
+            argv.emplace_back(&arg[0]);
+        }
+        if (!placer.parseFileBased(static_cast<int>(argv.size()), argv.data()))
+        {
+            return false;
+        }
+    }
+    placer.setNumThreads(_numThreads);
+    // The scoped stages add up. Only count this solving
+    ::klib::StopWatchMgr::clearTimes();
+    placer.solve(benchCase.gridStep);
+    for (const auto &stage : STAGES)
+    {
+        std::uint64_t time = 0;
+        if (!::klib::StopWatchMgr::findTime(stage.second, time))
+        {
+            continue;
+        }
+        RealType seconds = time / 1e6;
+        auto findIter = result.stageSeconds.find(stage.first);
+        if (findIter == result.stageSeconds.end() or seconds < findIter->second)
+        {
+            result.stageSeconds[stage.first] = seconds;
+        }
+    }
+    const auto &db = placer._db;
+    const auto bbox = db.placementBBox();
+    result.numCells = db.numCells();
+    result.metrics["hpwl"] = db.hpwl();
+    result.metrics["area"] = static_cast<RealType>(bbox.xLen()) * static_cast<RealType>(bbox.yLen());
+    result.metrics["symViolations"] = db.numSymViolations();
+    return true;
+}
+
+bool PlacementBenchmark::writeJson(const std::string &filename) const
+{
+    using namespace PlacementBenchmarkDetails;
+    std::ofstream out(filename);
+    if (!out.good())
+    {
+        ERR("PlacementBenchmark::%s cannot open %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    out << std::setprecision(10);
+    out << "{\n  \"version\": " << VERSION << ",\n  \"cases\": [";
+    for (IndexType resultIdx = 0; resultIdx < _results.size(); ++resultIdx)
+    {
+        const auto &result = _results[resultIdx];
+        out << (resultIdx == 0 ? "\n" : ",\n");
+        out << "    {\"name\": " << quote(result.name) << ", \"numCells\": " << result.numCells << ",\n";
+        out << "     \"stageSeconds\": ";
+        writeObject(out, result.stageSeconds);
+        out << ",\n     \"metrics\": ";
+        writeObject(out, result.metrics);
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+    return out.good();
+}
+
+bool PlacementBenchmark::compareBaseline(const std::string &filename, IndexType &numRegressions) const
+{
+    using namespace PlacementBenchmarkDetails;
+    numRegressions = 0;
+    std::map<std::string, PlacementBenchmarkResult> baseline;
+    try
+    {
+        boost::property_tree::ptree tree;
+        boost::property_tree::read_json(filename, tree);
+        if (tree.get<std::uint32_t>("version") != VERSION)
+        {
+            ERR("PlacementBenchmark::%s %s is of another version \n", __FUNCTION__, filename.c_str());
+            return false;
+        }
+        for (const auto &caseNode : tree.get_child("cases"))
+        {
+            PlacementBenchmarkResult result;
+            result.name = caseNode.second.get<std::string>("name");
+            for (const auto &stage : caseNode.second.get_child("stageSeconds"))
+            {
+                result.stageSeconds[stage.first] = stage.second.get_value<RealType>();
+            }
+            for (const auto &metric : caseNode.second.get_child("metrics"))
+            {
+                result.metrics[metric.first] = metric.second.get_value<RealType>();
+            }
+            baseline[result.name] = result;
+        }
+    }
+    catch (const boost::property_tree::ptree_error &error)
+    {
+        ERR("PlacementBenchmark::%s cannot read %s: %s \n", __FUNCTION__, filename.c_str(), error.what());
+        return false;
+    }
+    for (const auto &result : _results)
+    {
+        auto findIter = baseline.find(result.name);
+        if (findIter == baseline.end())
+        {
+            WRN("PlacementBenchmark::%s %s is not in the baseline \n", __FUNCTION__, result.name.c_str());
+            continue;
+        }
+        const auto &base = findIter->second;
+        for (const auto &stage : result.stageSeconds)
+        {
+            auto baseIter = base.stageSeconds.find(stage.first);
+            if (baseIter == base.stageSeconds.end())
+            {
+                continue;
+            }
+            const RealType baseSeconds = baseIter->second;
+            if (stage.second > baseSeconds * (1 + _timeTolerance) and stage.second - baseSeconds > _minTimeDelta)
+            {
+                WRN("PlacementBenchmark:: %s %s time regressed: %.3f s -> %.3f s \n", result.name.c_str(), stage.first.c_str(), baseSeconds, stage.second);
+                ++numRegressions;
+            }
+        }
+        for (const auto &metric : result.metrics)
+        {
+            auto baseIter = base.metrics.find(metric.first);
+            if (baseIter == base.metrics.end())
+            {
+                continue;
+            }
+            const RealType baseValue = baseIter->second;
+            if (metric.second > baseValue + std::abs(baseValue) * _qualityTolerance)
+            {
+                WRN("PlacementBenchmark:: %s %s regressed: %.0f -> %.0f \n", result.name.c_str(), metric.first.c_str(), baseValue, metric.second);
+                ++numRegressions;
+            }
+        }
+    }
+    INF("PlacementBenchmark::%s %d regressions against %s \n", __FUNCTION__, numRegressions, filename.c_str());
+    return true;
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,94 @@
+/**
+ * @file PlacementBenchmark.h
+ * @brief Run the placement on a fixed corpus, and compare the runtime and quality against a baseline
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_PLACEMENT_BENCHMARK_H_
+#define IDEAPLACE_PLACEMENT_BENCHMARK_H_
+
+#include <map>
+#include "IdeaPlaceEx.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief a problem of the benchmark corpus. Either read by the file-based flow, or generated by NetlistGenerator
+struct PlacementBenchmarkCase
+{
+    std::string name; ///< The name. Used to match the baseline
+    std::vector<std::string> args; ///< The arguments of the file-based flow, eg. "--snapshot" "a.snapshot". Empty for a generated problem
+    IndexType numCells = 0; ///< The number of cells of a generated problem
+    std::uint64_t seed = 1; ///< The seed of a generated problem
+    LocType gridStep = -1; ///< The grid step passed to solve()
+};
+
+/// @brief the measurements on a problem
+struct PlacementBenchmarkResult
+{
+    std::string name; ///< The name of the problem
+    IndexType numCells = 0; ///< The number of cells
+    std::map<std::string, RealType> stageSeconds; ///< The wall time of each stage. The minimum over the repeats
+    std::map<std::string, RealType> metrics; ///< The quality of the placement: hpwl, area and symViolations
+};
+
+/// @class IDEAPLACE::PlacementBenchmark
+/// @brief solve each problem of the corpus with a new IdeaPlaceEx and record the time of the stages and the quality.
+/// A stage or metric regresses if it is worse than the baseline by more than the tolerance. The times also need to be worse by more than an absolute amount, so that the noise on the short stages is not reported
+class PlacementBenchmark
+{
+    public:
+        /// @brief default constructor
+        explicit PlacementBenchmark() = default;
+        /// @brief add a problem
+        void addCase(const PlacementBenchmarkCase &benchCase) { _cases.emplace_back(benchCase); }
+        /// @brief add a generated problem
+        /// @param first: the name
+        /// @param second: the number of cells
+        /// @param third: the seed
+        void addGeneratedCase(const std::string &name, IndexType numCells, std::uint64_t seed);
+        /// @brief add the default corpus: generated problems of a few sizes
+        void addDefaultCorpus();
+        /// @brief read the problems from a corpus file. One problem per line, "#" starts a comment.
+        /// "<name> generate <number of cells> [seed]" for a generated problem, or "<name> <arguments of the file-based flow>", eg. "ota --snapshot ota.snapshot"
+        /// @return if successful
+        bool readCorpus(const std::string &filename);
+        /// @brief set the number of times each problem is solved. The time of a stage is the minimum
+        void setNumRepeats(IndexType numRepeats) { _numRepeats = std::max(numRepeats, static_cast<IndexType>(1)); }
+        /// @brief set the number of threads of the solving
+        void setNumThreads(IndexType numThreads) { _numThreads = numThreads; }
+        /// @brief set the allowed relative increase of a stage time
+        void setTimeTolerance(RealType tolerance) { _timeTolerance = tolerance; }
+        /// @brief set the increase of a stage time, in seconds, always allowed
+        void setMinTimeDelta(RealType seconds) { _minTimeDelta = seconds; }
+        /// @brief set the allowed relative increase of a quality metric
+        void setQualityTolerance(RealType tolerance) { _qualityTolerance = tolerance; }
+        /// @brief solve all the problems
+        /// @return false if a problem cannot be read. The others are still solved
+        bool run();
+        /// @brief get the results of the last run()
+        const std::vector<PlacementBenchmarkResult> & results() const { return _results; }
+        /// @brief write the results as JSON. The file can be used as the baseline
+        /// @return if successful
+        bool writeJson(const std::string &filename) const;
+        /// @brief compare the results with a baseline written by writeJson, and report each regression
+        /// @param first: the baseline file
+        /// @param second: the number of regressions
+        /// @return false if the baseline cannot be read
+        bool compareBaseline(const std::string &filename, IndexType &numRegressions) const;
+    private:
+        /// @brief solve a problem once
+        /// @return false if the problem cannot be read
+        bool runCase(const PlacementBenchmarkCase &benchCase, PlacementBenchmarkResult &result);
+    private:
+        std::vector<PlacementBenchmarkCase> _cases; ///< The corpus
+        std::vector<PlacementBenchmarkResult> _results; ///< The results of the last run
+        IndexType _numRepeats = 1; ///< The number of solvings of each problem
+        IndexType _numThreads = 1; ///< The number of threads
+        RealType _timeTolerance = 0.2; ///< The allowed relative increase of a stage time
+        RealType _minTimeDelta = 0.05; ///< The increase of a stage time always allowed. In seconds
+        RealType _qualityTolerance = 0.02; ///< The allowed relative increase of a quality metric
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //IDEAPLACE_PLACEMENT_BENCHMARK_H_
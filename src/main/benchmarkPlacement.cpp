@@ -0,0 +1,57 @@
+/**
+ * @file benchmarkPlacement.cpp
+ * @brief Command line driver of the end-to-end placement benchmark. Exit with 1 on a regression against the baseline, and 2 on an error
+ * @date 10/17/2026
+ */
+
+#include "main/PlacementBenchmark.h"
+#include "util/thirdparty/cmdline.h"
+
+int main(int argc, char* argv[])
+{
+    using namespace PROJECT_NAMESPACE;
+    cmdline::parser parser;
+    parser.add <std::string> ("corpus", '\0', "corpus file. One problem per line: \"<name> generate <cells> [seed]\" or \"<name> <placer arguments>\"", false, "");
+    parser.add ("no_default_corpus", '\0', "only run the problems in --corpus");
+    parser.add <std::string> ("baseline", '\0', "baseline JSON to compare with", false, "");
+    parser.add <std::string> ("output", '\0', "JSON file to write the results. Can be the next baseline", false, "");
+    parser.add <IntType> ("repeat", '\0', "number of solvings of each problem. The time is the minimum", false, 1, cmdline::range(1, 1000));
+    parser.add <IntType> ("threads", '\0', "number of threads", false, 1, cmdline::range(1, 1024));
+    parser.add <RealType> ("time_tolerance", '\0', "allowed relative increase of a stage time", false, 0.2);
+    parser.add <RealType> ("min_time_delta", '\0', "increase of a stage time in seconds always allowed", false, 0.05);
+    parser.add <RealType> ("quality_tolerance", '\0', "allowed relative increase of HPWL, area and symmetry violations", false, 0.02);
+    parser.parse_check(argc, argv);
+
+    PlacementBenchmark bench;
+    if (!parser.exist("no_default_corpus"))
+    {
+        bench.addDefaultCorpus();
+    }
+    if (parser.get<std::string>("corpus") != "" and !bench.readCorpus(parser.get<std::string>("corpus")))
+    {
+        return 2;
+    }
+    bench.setNumRepeats(parser.get<IntType>("repeat"));
+    bench.setNumThreads(parser.get<IntType>("threads"));
+    bench.setTimeTolerance(parser.get<RealType>("time_tolerance"));
+    bench.setMinTimeDelta(parser.get<RealType>("min_time_delta"));
+    bench.setQualityTolerance(parser.get<RealType>("quality_tolerance"));
+    if (!bench.run())
+    {
+        return 2;
+    }
+    if (parser.get<std::string>("output") != "" and !bench.writeJson(parser.get<std::string>("output")))
+    {
+        return 2;
+    }
+    if (parser.get<std::string>("baseline") != "")
+    {
+        IndexType numRegressions = 0;
+        if (!bench.compareBaseline(parser.get<std::string>("baseline"), numRegressions))
+        {
+            return 2;
+        }
+        return numRegressions > 0 ? 1 : 0;
+    }
+    return 0;
+}
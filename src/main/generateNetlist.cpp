@@ -0,0 +1,40 @@
+/**
+ * @file generateNetlist.cpp
+ * @brief Command line generator of the synthetic placement problems. The snapshot is the --snapshot input of the placer
+ * @date 10/17/2026
+ */
+
+#include "db/NetlistGenerator.h"
+#include "db/DatabaseSnapshot.h"
+#include "util/thirdparty/cmdline.h"
+
+int main(int argc, char* argv[])
+{
+    using namespace PROJECT_NAMESPACE;
+    cmdline::parser parser;
+    parser.add <IntType> ("cells", '\0', "number of cells", true, 0, cmdline::range(1, 10000000));
+    parser.add <std::string> ("output", '\0', "database snapshot file to write", true);
+    parser.add <IntType> ("seed", '\0', "seed of the random numbers", false, 1);
+    parser.add <IntType> ("layers", '\0', "number of layers of the cell shapes", false, 3, cmdline::range(1, 64));
+    parser.add <RealType> ("sym_ratio", '\0', "fraction of the cells in the symmetric blocks", false, 0.5);
+    parser.add <RealType> ("passive_ratio", '\0', "fraction of the cells being passives", false, 0.1);
+    parser.add <RealType> ("extra_net_ratio", '\0', "number of the extra local nets per cell", false, 0.3);
+    parser.parse_check(argc, argv);
+
+    NetlistGenerator generator(parser.get<IntType>("cells"), parser.get<IntType>("seed"));
+    generator.setNumLayers(parser.get<IntType>("layers"));
+    generator.setSymRatio(parser.get<RealType>("sym_ratio"));
+    generator.setPassiveRatio(parser.get<RealType>("passive_ratio"));
+    generator.setExtraNetRatio(parser.get<RealType>("extra_net_ratio"));
+    Database db;
+    if (!generator.generate(db))
+    {
+        return 1;
+    }
+    if (!DatabaseSnapshot(db).save(parser.get<std::string>("output")))
+    {
+        ERR("generateNetlist:: cannot write %s \n", parser.get<std::string>("output").c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -1,41 +1,39 @@
 #include "ParserConnection.h"
+#include "util/MmapTokenizer.h"
 
 PROJECT_NAMESPACE_BEGIN
 
 bool ParserConnection::read(const std::string &filename)
 {
-    std::ifstream inf(filename.c_str());
-    if (!inf.is_open()) 
+    ::klib::MmapFile file;
+    if (!file.open(filename)) 
     {
         ERR("ParserConnection::%s: cannot open file: %s \n", __FUNCTION__ , filename.c_str());
         Assert(false);
         return false;
     }
     // Read in the file
-    std::string line;
-    while (std::getline(inf, line))
+    ::klib::LineTokenizer tokenizer(file.content());
+    std::vector<std::string_view> cells; 
+    std::vector<std::string_view> pins;
+    while (tokenizer.nextLine())
     {
         // Split the line into words
-        std::vector<std::string> words;
-        std::istringstream iss(line);
-        for (std::string str; iss >> str; )
-        {
-            words.emplace_back(str);
-        }
+        const auto &words = tokenizer.fields();
         if (words.size() == 0)
         {
-            ERR("ParserConnection::%s: unexpected syntax %s \n", __FUNCTION__, line.c_str());
+            ERR("ParserConnection::%s: unexpected syntax %s \n", __FUNCTION__, std::string(tokenizer.line()).c_str());
             Assert(false);
             return false;
         }
         IndexType netIdx = _db.allocateNet();
-        _db.net(netIdx).setName(words.at(0));
-        std::vector<std::string> cells; 
-        std::vector<std::string> pins;
+        _db.setNetName(netIdx, std::string(words.at(0)));
+        cells.clear();
+        pins.clear();
         for (IndexType idx = 0; idx < (words.size() - 1)/2; ++idx)
         {
-            std::string cellName = words.at(1 + idx * 2);
-            std::string pinName = words.at(1 + idx * 2 + 1);
+            std::string_view cellName = words.at(1 + idx * 2);
+            std::string_view pinName = words.at(1 + idx * 2 + 1);
             if (pinName == "B" || pinName == "BULK")
             {
                 WRN("ParserConnection::%s: ignore the bulk connection \n", __FUNCTION__);
@@ -49,33 +47,15 @@ bool ParserConnection::read(const std::string &filename)
         {
             const auto &cellName = cells.at(cellsIdx);
             const auto &pinName = pins.at(cellsIdx);
-            IndexType cellIdx = INDEX_TYPE_MAX;
-            for (IndexType idx = 0; idx < _db.numCells(); ++idx)
-            {
-                if (_db.cell(idx).name() == cellName)
-                {
-                    cellIdx = idx;
-                    break;
-                }
-            }
+            IndexType cellIdx = _db.cellIdxByName(cellName);
             if (cellIdx == INDEX_TYPE_MAX)
             {
                 // Did not find the cell
-                ERR("ParserConnection::%s: cannot find the cell %s \n", __FUNCTION__, cellName.c_str());
+                ERR("ParserConnection::%s: cannot find the cell %s \n", __FUNCTION__, std::string(cellName).c_str());
                 Assert(false);
                 return false;
             }
-            const auto &cell = _db.cell(cellIdx);
-            IndexType pinIdx = INDEX_TYPE_MAX;
-            for (IndexType idx = 0; idx < cell.numPinIdx(); ++idx)
-            {
-                const auto & name = _db.pin(cell.pinIdx(idx)).name();
-                if (pinName == name)
-                {
-                    pinIdx = cell.pinIdx(idx);
-                    break;
-                }
-            }
+            IndexType pinIdx = _db.pinIdxByName(cellIdx, pinName);
             if (pinIdx == INDEX_TYPE_MAX)
             {
                 // Did not find the pin
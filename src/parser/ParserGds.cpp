@@ -1,29 +1,43 @@
 #include "ParserGds.h"
-#include "util/Polygon2Rect.h"
+#include "ParserGdsStream.h"
 
 PROJECT_NAMESPACE_BEGIN
 
 bool ParserCellGds::parseCellGds(const std::string &filename, IndexType cellIdx)
 {
+    if (!this->readCellGds(filename))
+    {
+        return false;
+    }
+    return this->mergeToDb(cellIdx);
+}
+
+bool ParserCellGds::readCellGds(const std::string &filename)
+{
+    if (_db.parameters().ifUseGdsStreamReader())
+    {
+        return this->readCellGdsStream(filename);
+    }
+    _isStreamed = false;
     // Flaten the gds by the last cell
     ::GdsParser::GdsDB::GdsDB unflatenDb;
     ::GdsParser::GdsDB::GdsReader reader(unflatenDb);
     if (!reader(filename))
     {
         ERR("Placement Gds Parser: cannot open file %s! \n", filename.c_str());
+        return false;
     }
     // Set the gds unit based on precision
     _gdsDBU = ::klib::autoRound<IntType>(1e-6 / unflatenDb.precision());
 
 
     // Flaten the gds
-    std::string topCellName = ::klib::topCell(unflatenDb);
-    auto flatCell = unflatenDb.extractCell(topCellName);
-    ::GdsParser::GdsDB::GdsDB _gdsDb;
-    _gdsDb.addCell(flatCell);
+    _topCellName = ::klib::topCell(unflatenDb);
+    auto flatCell = unflatenDb.extractCell(_topCellName);
 
 
     // Process the shapes in the gds
+    _polygons.clear();
     for (const auto &object : flatCell.objects())
     {
         ::GdsParser::GdsDB::GdsObjectHelpers()(object.first, object.second, ExtractShapeLayerAction(_db.tech().layerIdxMap(), _polygons));
@@ -31,20 +45,55 @@ bool ParserCellGds::parseCellGds(const std::string &filename, IndexType cellIdx)
 
     // Scale the shapes to the placer database unit
     this->scaleDesign();
+    return true;
+}
 
+bool ParserCellGds::readCellGdsStream(const std::string &filename)
+{
+    _isStreamed = true;
+    _polygons.clear();
+    GdsBBoxStreamReader reader(_db.tech().layerIdxMap(), _db.tech().numLayers());
+    if (!reader.read(filename))
+    {
+        return false;
+    }
+    _gdsDBU = reader.gdsDBU();
+    _topCellName = reader.topCellName();
+    if (_topCellName == "")
+    {
+        ERR("Placement Gds Parser: cannot find top cell in %s! \n", filename.c_str());
+        return false;
+    }
+    std::vector<Box<RealType>> bboxes;
+    if (!reader.resolveBBoxes(_topCellName, bboxes))
+    {
+        return false;
+    }
+    // Scale the boxes to the placer database unit in the same way as scaleDesign()
+    auto dbDBU = _db.tech().dbu();
+    RealType scale = std::round(static_cast<RealType>(dbDBU) / static_cast<RealType>(_gdsDBU));
+    _layerBBoxes.assign(bboxes.size(), Box<LocType>(LOC_TYPE_MAX, LOC_TYPE_MAX, LOC_TYPE_MIN, LOC_TYPE_MIN));
+    for (IndexType layerIdx = 0; layerIdx < bboxes.size(); ++layerIdx)
+    {
+        const auto &bbox = bboxes.at(layerIdx);
+        if (!bbox.valid())
+        {
+            continue;
+        }
+        _layerBBoxes.at(layerIdx).set(::klib::autoRound<LocType>(bbox.xLo() * scale), ::klib::autoRound<LocType>(bbox.yLo() * scale),
+                ::klib::autoRound<LocType>(bbox.xHi() * scale), ::klib::autoRound<LocType>(bbox.yHi() * scale));
+    }
+    return true;
+}
+
+bool ParserCellGds::mergeToDb(IndexType cellIdx)
+{
     // Find the cell index if not given
     if (cellIdx == INDEX_TYPE_MAX)
     {
         // Check the cell name with the top cell name
-        for (IndexType idx = 0; idx < _db.numCells(); ++idx)
-        {
-            if (topCellName == _db.cell(idx).name())
-            {
-                cellIdx = idx;
-                break;
-            }
-        }
-        AssertMsg(cellIdx != INDEX_TYPE_MAX, "ParserCellGds::%s cannot locate the cell %s in database \n", __FUNCTION__, topCellName.c_str());
+        cellIdx = _db.cellIdxByName(_topCellName);
+        AssertMsg(cellIdx != INDEX_TYPE_MAX, "ParserCellGds::%s cannot locate the cell %s in database \n", __FUNCTION__, _topCellName.c_str());
     }
 
     // Write the read shapes into the database
@@ -66,17 +115,59 @@ void ParserCellGds::scaleDesign()
 void ParserCellGds::dumpToDb(IndexType cellIdx)
 {
     auto &cell = _db.cell(cellIdx);
-    for (const auto &poly : _polygons)
+    if (!_isStreamed)
     {
-        IndexType placerLayer = poly.layer;
-        std::vector<Box<LocType>> shapes;
-        ::klib::convertPolygon2Rects<LocType>(poly.pts, shapes);
-        for (const auto &shape : shapes)
+        // Only the layer bounding boxes are kept in the cell, so fold the polygons directly instead of decomposing them into rectangles
+        _layerBBoxes.assign(_db.tech().numLayers(), Box<LocType>(LOC_TYPE_MAX, LOC_TYPE_MAX, LOC_TYPE_MIN, LOC_TYPE_MIN));
+        ParserCellGdsDetails::foldPolygonBBoxes(_polygons, _layerBBoxes);
+    }
+    for (IndexType layerIdx = 0; layerIdx < _layerBBoxes.size(); ++layerIdx)
+    {
+        if (_layerBBoxes.at(layerIdx).valid())
         {
-            cell.unionBBox(placerLayer, shape);
+            cell.unionBBox(layerIdx, _layerBBoxes.at(layerIdx));
         }
     }
     cell.calculateCellBBox();
 }
 
+namespace ParserCellGdsDetails
+{
+    bool parseAllGdsFiles(Database &db, const std::vector<std::string> &gdsFiles, const std::vector<IndexType> &cellIdxs)
+    {
+        AssertMsg(cellIdxs.empty() || cellIdxs.size() == gdsFiles.size(), "%s: %lu cell indices for %lu gds files \n", __FUNCTION__, cellIdxs.size(), gdsFiles.size());
+        const IntType numFiles = static_cast<IntType>(gdsFiles.size());
+        // One parser, hence one shape buffer, for each file
+        std::vector<ParserCellGds> parsers;
+        parsers.reserve(gdsFiles.size());
+        for (IntType fileIdx = 0; fileIdx < numFiles; ++fileIdx)
+        {
+            parsers.emplace_back(ParserCellGds(db));
+        }
+        std::vector<IntType> success(gdsFiles.size(), 0); // Avoid std::vector<bool> for concurrent writes
+        // The heavy part: read, flatten and scale the gds. Each thread only writes into its own buffer
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(db.parameters().numThreads())
+        for (IntType fileIdx = 0; fileIdx < numFiles; ++fileIdx)
+        {
+            success[fileIdx] = parsers[fileIdx].readCellGds(gdsFiles[fileIdx]) ? 1 : 0;
+        }
+        // Merge into the database sequentially in the order of the files, so the results do not depend on the scheduling
+        for (IntType fileIdx = 0; fileIdx < numFiles; ++fileIdx)
+        {
+            if (!success[fileIdx])
+            {
+                ERR("%s: parse %s failed! \n", __FUNCTION__, gdsFiles[fileIdx].c_str());
+                return false;
+            }
+            IndexType cellIdx = cellIdxs.empty() ? INDEX_TYPE_MAX : cellIdxs[fileIdx];
+            if (!parsers[fileIdx].mergeToDb(cellIdx))
+            {
+                ERR("%s: parse %s failed! \n", __FUNCTION__, gdsFiles[fileIdx].c_str());
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
 PROJECT_NAMESPACE_END
@@ -49,6 +49,18 @@ class ParserCellGds
                 }
             }
 
+            /// @brief get the bounding box of the polygon
+            /// @return the point-wise min and max of the polygon
+            Box<LocType> bbox() const
+            {
+                Box<LocType> box(LOC_TYPE_MAX, LOC_TYPE_MAX, LOC_TYPE_MIN, LOC_TYPE_MIN);
+                for (const auto &pt : pts)
+                {
+                    box.join(pt);
+                }
+                return box;
+            }
+
             ///Members
             std::vector<XY<LocType>> pts; ///< The points of the polygon
             IndexType layer = INDEX_TYPE_MAX; ///< The layer of the polygon
@@ -63,35 +75,63 @@ class ParserCellGds
         /// @param second: the cell index. If given INDEX_TYPE_MAX or ungiven, search the cell by name
         /// @return if the parsing is successful
         bool parseCellGds(const std::string &filename, IndexType cellIdx = INDEX_TYPE_MAX);
+        /// @brief read the shapes of a gds file into the local shape buffer without touching the cells in the database
+        /// @param the gds file name
+        /// @return if the reading is successful
+        /// Only reads the technology in the database, so different parsers could call this concurrently
+        bool readCellGds(const std::string &filename);
+        /// @brief read the shapes of a gds file with the streaming reader. Only the per-layer bounding boxes are kept
+        /// @param the gds file name
+        /// @return if the reading is successful
+        bool readCellGdsStream(const std::string &filename);
+        /// @brief merge the shapes in the local buffer into a cell of the database
+        /// @param the cell index. If given INDEX_TYPE_MAX or ungiven, search the cell by the top cell name of the gds
+        /// @return if successful
+        bool mergeToDb(IndexType cellIdx = INDEX_TYPE_MAX);
         /// @brief scale the design based on the router precision
         void scaleDesign();
         /// @brief dump the read gds shapes to the database
         /// @param the cell index
         void dumpToDb(IndexType cellIdx);
+        /// @brief get the polygons read from the gds. Not available with the streaming reader
+        /// @return the polygons in the placer database unit
+        const std::vector<PolygonLayer> & polygons() const { return _polygons; }
+        /// @brief get the name of the top cell in the read gds
+        /// @return the name of the top cell in the read gds
+        const std::string & topCellName() const { return _topCellName; }
     private:
         Database &_db; ///< The database for the placement engine
         IntType _gdsDBU; ///< Based on the gds, x database units per um
+        std::string _topCellName; ///< The name of the top cell in the read gds
         std::vector<PolygonLayer> _polygons; ///< The polygons read from the gds
+        bool _isStreamed = false; ///< Whether the shapes were read by the streaming reader, and hence only _layerBBoxes are valid
+        std::vector<Box<LocType>> _layerBBoxes; ///< The per-layer bounding boxes of the read shapes
 };
 
 namespace ParserCellGdsDetails
 {
-    /// @brief parsing all the gds files
-    /// @param first: the placement database
-    /// @param second: a vector of gds file names
-    /// @return if successful
-    inline bool parseAllGdsFiles(Database &db, const std::vector<std::string> &gdsFiles)
+    /// @brief fold the polygons into per-layer bounding boxes. The placer only needs the layer bounding boxes, so the polygons are not decomposed
+    /// @param first: the polygons
+    /// @param second: the per-layer bounding boxes to union into. Need to be sized to the number of layers
+    inline void foldPolygonBBoxes(const std::vector<ParserCellGds::PolygonLayer> &polygons, std::vector<Box<LocType>> &bboxes)
     {
-        for (const auto &gds : gdsFiles)
+        for (const auto &poly : polygons)
         {
-            if (!ParserCellGds(db).parseCellGds(gds))
+            // Same as the rectangle decomposition, degenerated polygons contribute nothing
+            if (poly.pts.size() < 3)
             {
-                ERR("%s: parse %s failed! \n", __FUNCTION__, gds.c_str());
-                return false;
+                continue;
             }
+            bboxes.at(poly.layer).unionBox(poly.bbox());
         }
-        return true;
     }
+    /// @brief parsing all the gds files
+    /// @param first: the placement database
+    /// @param second: a vector of gds file names
+    /// @param third: a vector of cell indices, one for each gds file. Empty or INDEX_TYPE_MAX means searching the cell by name
+    /// @return if successful
+    /// The files are read concurrently into per-file shape buffers, and then merged into the database in the order of the files
+    bool parseAllGdsFiles(Database &db, const std::vector<std::string> &gdsFiles, const std::vector<IndexType> &cellIdxs = std::vector<IndexType>());
 }
 
 
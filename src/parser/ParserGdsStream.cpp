@@ -0,0 +1,427 @@
+#include "ParserGdsStream.h"
+#include <cmath>
+
+PROJECT_NAMESPACE_BEGIN
+
+bool GdsBBoxStreamReader::read(const std::string &filename)
+{
+    _structs.clear();
+    _structIdxMap.clear();
+    _resolved.clear();
+    _resolveStatus.clear();
+    _curStruct = INDEX_TYPE_MAX;
+    this->resetElement();
+    if (!::GdsParser::read(*this, filename))
+    {
+        ERR("GdsBBoxStreamReader::%s: cannot open file %s! \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::string GdsBBoxStreamReader::topCellName() const
+{
+    // Whether each cell is found as the subcell of the other. Ordered as klib::topCell
+    std::map<std::string, bool> nameFound;
+    for (const auto &st : _structs)
+    {
+        nameFound[st.name] = false;
+    }
+    for (const auto &st : _structs)
+    {
+        for (const auto &ref : st.refs)
+        {
+            nameFound[ref.name] = true;
+        }
+    }
+    for (const auto &pair : nameFound)
+    {
+        if (pair.first != "" && !pair.second)
+        {
+            return pair.first;
+        }
+    }
+    return "";
+}
+
+bool GdsBBoxStreamReader::resolveBBoxes(const std::string &structName, std::vector<Box<RealType>> &bboxes)
+{
+    const auto findIter = _structIdxMap.find(structName);
+    if (findIter == _structIdxMap.end())
+    {
+        ERR("GdsBBoxStreamReader::%s: cannot find structure %s \n", __FUNCTION__, structName.c_str());
+        return false;
+    }
+    _resolved.resize(_structs.size());
+    _resolveStatus.resize(_structs.size(), 0);
+    if (!this->resolveStructure(findIter->second))
+    {
+        return false;
+    }
+    bboxes = _resolved.at(findIter->second);
+    return true;
+}
+
+bool GdsBBoxStreamReader::resolveStructure(IndexType structIdx)
+{
+    if (_resolveStatus.at(structIdx) == 2)
+    {
+        return true;
+    }
+    if (_resolveStatus.at(structIdx) == 1)
+    {
+        ERR("GdsBBoxStreamReader::%s: cyclic reference of structure %s \n", __FUNCTION__, _structs.at(structIdx).name.c_str());
+        return false;
+    }
+    _resolveStatus.at(structIdx) = 1;
+    auto bboxes = _structs.at(structIdx).bboxes;
+    for (const auto &ref : _structs.at(structIdx).refs)
+    {
+        const auto findIter = _structIdxMap.find(ref.name);
+        if (findIter == _structIdxMap.end())
+        {
+            WRN("GdsBBoxStreamReader::%s: structure %s refers to undefined structure %s. Ignored \n", __FUNCTION__, _structs.at(structIdx).name.c_str(), ref.name.c_str());
+            continue;
+        }
+        if (!this->resolveStructure(findIter->second))
+        {
+            return false;
+        }
+        const auto &childBBoxes = _resolved.at(findIter->second);
+        // The instances of an array are translations of each other. The extreme ones are at the corners of the array
+        const XY<RealType> lastCol = ref.colStep * static_cast<RealType>(ref.numCols - 1);
+        const XY<RealType> lastRow = ref.rowStep * static_cast<RealType>(ref.numRows - 1);
+        for (IndexType layerIdx = 0; layerIdx < _numLayers; ++layerIdx)
+        {
+            if (!childBBoxes.at(layerIdx).valid())
+            {
+                continue;
+            }
+            Box<RealType> box = transformBox(ref, childBBoxes.at(layerIdx));
+            Box<RealType> arrayBox = box;
+            arrayBox.unionBox(box.offsetBox(lastCol));
+            arrayBox.unionBox(box.offsetBox(lastRow));
+            arrayBox.unionBox(box.offsetBox(lastCol + lastRow));
+            bboxes.at(layerIdx).unionBox(arrayBox);
+        }
+    }
+    _resolved.at(structIdx) = std::move(bboxes);
+    _resolveStatus.at(structIdx) = 2;
+    return true;
+}
+
+Box<RealType> GdsBBoxStreamReader::transformBox(const StructRef &ref, const Box<RealType> &box)
+{
+    const RealType rad = ref.angle * M_PI / 180.0;
+    const RealType cosA = std::cos(rad);
+    const RealType sinA = std::sin(rad);
+    Box<RealType> result = invalidBox();
+    auto transformPt = [&](RealType x, RealType y)
+    {
+        // Reflection about x axis, then magnification, then rotation, at last translation
+        if (ref.reflect)
+        {
+            y = -y;
+        }
+        x *= ref.mag;
+        y *= ref.mag;
+        result.join(XY<RealType>(x * cosA - y * sinA + ref.origin.x(), x * sinA + y * cosA + ref.origin.y()));
+    };
+    transformPt(box.xLo(), box.yLo());
+    transformPt(box.xLo(), box.yHi());
+    transformPt(box.xHi(), box.yLo());
+    transformPt(box.xHi(), box.yHi());
+    return result;
+}
+
+void GdsBBoxStreamReader::resetElement()
+{
+    _elementType = ElementType::NONE;
+    _gdsLayer = -1;
+    _pts.clear();
+    _pathType = 0;
+    _width = 0;
+    _bgnExtn = 0;
+    _endExtn = 0;
+    _ref = StructRef();
+}
+
+void GdsBBoxStreamReader::finishElement()
+{
+    if (_curStruct == INDEX_TYPE_MAX)
+    {
+        return;
+    }
+    auto &st = _structs.at(_curStruct);
+    if (_elementType == ElementType::BOUNDARY || _elementType == ElementType::PATH)
+    {
+        const auto findIter = _layerIdxMap.find(static_cast<IndexType>(_gdsLayer));
+        if (_gdsLayer < 0 || findIter == _layerIdxMap.end())
+        {
+            return;
+        }
+        // Same as foldPolygonBBoxes of the GdsDB reader, degenerated polygons contribute nothing.
+        // A path is a polygon of at least four points once it has a segment
+        const IndexType minNumPts = _elementType == ElementType::BOUNDARY ? 3 : 2;
+        if (_pts.size() < minNumPts)
+        {
+            return;
+        }
+        auto &bbox = st.bboxes.at(findIter->second);
+        if (_elementType == ElementType::BOUNDARY)
+        {
+            for (const auto &pt : _pts)
+            {
+                bbox.join(pt);
+            }
+        }
+        else
+        {
+            this->foldPath(bbox);
+        }
+    }
+    else if (_elementType == ElementType::SREF || _elementType == ElementType::AREF)
+    {
+        if (_elementType == ElementType::AREF && _pts.size() >= 3 && _ref.numCols > 0 && _ref.numRows > 0)
+        {
+            _ref.colStep = (_pts.at(1) - _pts.at(0)) / static_cast<RealType>(_ref.numCols);
+            _ref.rowStep = (_pts.at(2) - _pts.at(0)) / static_cast<RealType>(_ref.numRows);
+        }
+        else
+        {
+            _ref.numCols = 1;
+            _ref.numRows = 1;
+        }
+        if (!_pts.empty())
+        {
+            _ref.origin = _pts.front();
+        }
+        st.refs.emplace_back(_ref);
+    }
+}
+
+void GdsBBoxStreamReader::foldPath(Box<RealType> &bbox) const
+{
+    const RealType halfWidth = std::abs(_width) / 2;
+    // The extension at the two ends of the path
+    RealType bgnExtn = 0;
+    RealType endExtn = 0;
+    if (_pathType == 1 || _pathType == 2)
+    {
+        bgnExtn = halfWidth;
+        endExtn = halfWidth;
+    }
+    else if (_pathType == 4)
+    {
+        bgnExtn = _bgnExtn;
+        endExtn = _endExtn;
+    }
+    for (IndexType ptIdx = 0; ptIdx + 1 < _pts.size(); ++ptIdx)
+    {
+        XY<RealType> from = _pts.at(ptIdx);
+        XY<RealType> to = _pts.at(ptIdx + 1);
+        const XY<RealType> dir = to - from;
+        const RealType len = std::hypot(dir.x(), dir.y());
+        if (len == 0)
+        {
+            continue;
+        }
+        // Extend the ends of the whole path
+        if (ptIdx == 0)
+        {
+            from = from - dir * (bgnExtn / len);
+        }
+        if (ptIdx + 2 == _pts.size())
+        {
+            to = to + dir * (endExtn / len);
+        }
+        // The four corners of the segment rectangle
+        const XY<RealType> normal = XY<RealType>(-dir.y(), dir.x()) * (halfWidth / len);
+        bbox.join(from + normal);
+        bbox.join(from - normal);
+        bbox.join(to + normal);
+        bbox.join(to - normal);
+    }
+}
+
+void GdsBBoxStreamReader::bit_array_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::vector<int> &vBitArray)
+{
+    if (recordType == ::GdsParser::GdsRecords::STRANS && !vBitArray.empty())
+    {
+        // Either unpacked bits with the most significant one first, or the packed 16-bit word
+        if (vBitArray.size() > 1)
+        {
+            _ref.reflect = vBitArray.front() != 0;
+        }
+        else
+        {
+            _ref.reflect = (vBitArray.front() & 0x8000) != 0;
+        }
+    }
+}
+
+void GdsBBoxStreamReader::integer_2_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::vector<int> &vInteger)
+{
+    switch (recordType)
+    {
+        case ::GdsParser::GdsRecords::BGNSTR:
+        {
+            _structs.emplace_back(Structure());
+            _structs.back().bboxes.resize(_numLayers, invalidBox());
+            _curStruct = _structs.size() - 1;
+            break;
+        }
+        case ::GdsParser::GdsRecords::LAYER:
+        {
+            _gdsLayer = vInteger.front();
+            break;
+        }
+        case ::GdsParser::GdsRecords::PATHTYPE:
+        {
+            _pathType = vInteger.front();
+            break;
+        }
+        case ::GdsParser::GdsRecords::COLROW:
+        {
+            _ref.numCols = vInteger.at(0);
+            _ref.numRows = vInteger.at(1);
+            break;
+        }
+        default: break;
+    }
+}
+
+void GdsBBoxStreamReader::integer_4_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::vector<int> &vInteger)
+{
+    switch (recordType)
+    {
+        case ::GdsParser::GdsRecords::XY:
+        {
+            _pts.clear();
+            for (IndexType idx = 0; idx + 1 < vInteger.size(); idx += 2)
+            {
+                _pts.emplace_back(XY<RealType>(vInteger[idx], vInteger[idx + 1]));
+            }
+            break;
+        }
+        case ::GdsParser::GdsRecords::WIDTH:
+        {
+            _width = vInteger.front();
+            break;
+        }
+        case ::GdsParser::GdsRecords::BGNEXTN:
+        {
+            _bgnExtn = vInteger.front();
+            break;
+        }
+        case ::GdsParser::GdsRecords::ENDEXTN:
+        {
+            _endExtn = vInteger.front();
+            break;
+        }
+        default: break;
+    }
+}
+
+void GdsBBoxStreamReader::real_4_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::vector<double> &vFloat)
+{
+    this->real_8_cbk(recordType, dataType, vFloat);
+}
+
+void GdsBBoxStreamReader::real_8_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::vector<double> &vFloat)
+{
+    switch (recordType)
+    {
+        case ::GdsParser::GdsRecords::UNITS:
+        {
+            _precision = vFloat.at(1);
+            break;
+        }
+        case ::GdsParser::GdsRecords::MAG:
+        {
+            _ref.mag = vFloat.front();
+            break;
+        }
+        case ::GdsParser::GdsRecords::ANGLE:
+        {
+            _ref.angle = vFloat.front();
+            break;
+        }
+        default: break;
+    }
+}
+
+void GdsBBoxStreamReader::string_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::string &str)
+{
+    switch (recordType)
+    {
+        case ::GdsParser::GdsRecords::STRNAME:
+        {
+            if (_curStruct != INDEX_TYPE_MAX)
+            {
+                _structs.at(_curStruct).name = str;
+                _structIdxMap[str] = _curStruct;
+            }
+            break;
+        }
+        case ::GdsParser::GdsRecords::SNAME:
+        {
+            _ref.name = str;
+            break;
+        }
+        default: break;
+    }
+}
+
+void GdsBBoxStreamReader::begin_end_cbk(::GdsParser::GdsRecords::EnumType recordType)
+{
+    switch (recordType)
+    {
+        case ::GdsParser::GdsRecords::BOUNDARY:
+        case ::GdsParser::GdsRecords::BOX:
+        {
+            this->resetElement();
+            _elementType = ElementType::BOUNDARY;
+            break;
+        }
+        case ::GdsParser::GdsRecords::PATH:
+        {
+            this->resetElement();
+            _elementType = ElementType::PATH;
+            break;
+        }
+        case ::GdsParser::GdsRecords::SREF:
+        {
+            this->resetElement();
+            _elementType = ElementType::SREF;
+            break;
+        }
+        case ::GdsParser::GdsRecords::AREF:
+        {
+            this->resetElement();
+            _elementType = ElementType::AREF;
+            break;
+        }
+        case ::GdsParser::GdsRecords::TEXT:
+        case ::GdsParser::GdsRecords::NODE:
+        {
+            this->resetElement();
+            _elementType = ElementType::OTHER;
+            break;
+        }
+        case ::GdsParser::GdsRecords::ENDEL:
+        {
+            this->finishElement();
+            this->resetElement();
+            break;
+        }
+        case ::GdsParser::GdsRecords::ENDSTR:
+        {
+            _curStruct = INDEX_TYPE_MAX;
+            break;
+        }
+        default: break;
+    }
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,119 @@
+/**
+ * @file ParserGdsStream.h
+ * @brief Streaming gds reader that only keeps the per-layer bounding boxes
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_PARSER_GDS_STREAM_H_
+#define IDEAPLACE_PARSER_GDS_STREAM_H_
+
+#include <limbo/parsers/gdsii/stream/GdsReader.h>
+#include "global/global.h"
+#include "util/Box.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class IDEAPLACE::GdsBBoxStreamReader
+/// @brief Read a gds through the limbo callback api and fold the shapes into per-layer bounding boxes.
+/// Each structure only keeps the bounding boxes of its own shapes and its references to the other structures.
+/// The hierarchy is resolved with the transforms after the stream is finished, so neither the full gds database nor the polygons are kept in memory
+class GdsBBoxStreamReader : public ::GdsParser::GdsDataBase
+{
+    public:
+        /// @brief a reference to the other structure. SREF is seen as AREF with one column and one row
+        struct StructRef
+        {
+            std::string name = ""; ///< The name of the referred structure
+            bool reflect = false; ///< Reflect about x axis before rotation
+            RealType mag = 1.0; ///< The magnification
+            RealType angle = 0.0; ///< The rotation angle in degree
+            XY<RealType> origin = XY<RealType>(0, 0); ///< The origin of the (first) instance
+            XY<RealType> colStep = XY<RealType>(0, 0); ///< The displacement between two columns
+            XY<RealType> rowStep = XY<RealType>(0, 0); ///< The displacement between two rows
+            IntType numCols = 1; ///< The number of columns
+            IntType numRows = 1; ///< The number of rows
+        };
+        /// @brief the summary of a gds structure
+        struct Structure
+        {
+            std::string name = ""; ///< The name of the structure
+            std::vector<Box<RealType>> bboxes; ///< The bounding boxes of the shapes in this structure on each placer layer
+            std::vector<StructRef> refs; ///< The references to the other structures
+        };
+        /// @brief constructor
+        /// @param first: the map from gds layer to placer layer. Only shapes on the layers within this map are considered
+        /// @param second: the number of placer layers
+        explicit GdsBBoxStreamReader(const std::unordered_map<IndexType, IndexType> &layerIdxMap, IndexType numLayers)
+            : _layerIdxMap(layerIdxMap), _numLayers(numLayers) {}
+        /// @brief read a gds file
+        /// @param the gds file name
+        /// @return if successful
+        bool read(const std::string &filename);
+        /// @brief get the name of the top cell. The first name in the lexical order not being referred by the other structures, same as klib::topCell
+        /// @return the name of the top cell. Empty if there is no valid top cell
+        std::string topCellName() const;
+        /// @brief get the database unit of the gds
+        /// @return x gds database units per um
+        IntType gdsDBU() const { return ::klib::autoRound<IntType>(1e-6 / _precision); }
+        /// @brief resolve the bounding boxes of a structure, including the ones of its instances
+        /// @param first: the name of the structure
+        /// @param second: the per-layer bounding boxes in gds unit. Invalid boxes for the empty layers
+        /// @return if successful
+        bool resolveBBoxes(const std::string &structName, std::vector<Box<RealType>> &bboxes);
+        /*------------------------------*/
+        /* Callbacks of limbo           */
+        /*------------------------------*/
+        virtual void bit_array_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::vector<int> &vBitArray) override;
+        virtual void integer_2_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::vector<int> &vInteger) override;
+        virtual void integer_4_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::vector<int> &vInteger) override;
+        virtual void real_4_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::vector<double> &vFloat) override;
+        virtual void real_8_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::vector<double> &vFloat) override;
+        virtual void string_cbk(::GdsParser::GdsRecords::EnumType recordType, ::GdsParser::GdsData::EnumType dataType, const std::string &str) override;
+        virtual void begin_end_cbk(::GdsParser::GdsRecords::EnumType recordType) override;
+    private:
+        /// @brief the elements the reader cares about
+        enum class ElementType
+        {
+            NONE,
+            BOUNDARY,
+            PATH,
+            SREF,
+            AREF,
+            OTHER
+        };
+        /// @brief clear the states of the current element
+        void resetElement();
+        /// @brief fold the current element into the current structure
+        void finishElement();
+        /// @brief fold a path into the bounding box
+        void foldPath(Box<RealType> &bbox) const;
+        /// @brief the recursive kernel of resolving the bounding boxes. Memorized in _resolved
+        bool resolveStructure(IndexType structIdx);
+        /// @brief compute the bounding box of a transformed box
+        static Box<RealType> transformBox(const StructRef &ref, const Box<RealType> &box);
+        /// @brief get an empty bounding box
+        static Box<RealType> invalidBox() { return Box<RealType>(REAL_TYPE_MAX, REAL_TYPE_MAX, REAL_TYPE_MIN, REAL_TYPE_MIN); }
+
+        const std::unordered_map<IndexType, IndexType> &_layerIdxMap; ///< A map from gds layer to IDEAPLACE layer
+        IndexType _numLayers; ///< The number of placer layers
+        RealType _precision = 1e-9; ///< The size of gds database unit in meter
+        std::vector<Structure> _structs; ///< The summaries of structures
+        std::unordered_map<std::string, IndexType> _structIdxMap; ///< The map from structure name to index
+        IndexType _curStruct = INDEX_TYPE_MAX; ///< The structure being read
+        /* The current element */
+        ElementType _elementType = ElementType::NONE; ///< The type of the current element
+        IntType _gdsLayer = -1; ///< The gds layer of the current element
+        std::vector<XY<RealType>> _pts; ///< The points of the current element
+        IntType _pathType = 0; ///< The path type of the current path
+        RealType _width = 0; ///< The width of the current path
+        RealType _bgnExtn = 0; ///< The begin extension of the current path. Only for path type 4
+        RealType _endExtn = 0; ///< The end extension of the current path. Only for path type 4
+        StructRef _ref; ///< The current reference
+        /* The resolving of hierarchy */
+        std::vector<std::vector<Box<RealType>>> _resolved; ///< The memorized bounding boxes including the instances
+        std::vector<IntType> _resolveStatus; ///< 0: not visited, 1: visiting, 2: resolved
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //IDEAPLACE_PARSER_GDS_STREAM_H_
@@ -10,6 +10,7 @@
 
 #include "db/Database.h"
 #include <unordered_map>
+#include "util/MmapTokenizer.h"
 
 PROJECT_NAMESPACE_BEGIN
 
@@ -31,38 +32,29 @@ class ParserNetwgt
 
 inline bool ParserNetwgt::read(const std::string &filename)
 {
-    std::ifstream inf(filename.c_str());
-    if (!inf.is_open()) 
+    ::klib::MmapFile file;
+    if (!file.open(filename)) 
     {
         ERR("ParserNetwgt::%s: cannot open file: %s \n", __FUNCTION__ , filename.c_str());
         Assert(false);
         return false;
     }
-    // Make a map of the net names
-    std::unordered_map<std::string, IndexType> netNameMap;
-    for (IndexType netIdx = 0; netIdx < _db.numNets(); ++netIdx)
-    {
-        netNameMap[_db.net(netIdx).name()] = netIdx;
-    }
     // Read in the file
-    std::string line;
-    while (std::getline(inf, line))
+    ::klib::LineTokenizer tokenizer(file.content());
+    while (tokenizer.nextLine())
     {
-        std::istringstream iss(line);
-        std::string netName;
-        iss >> netName;
-        IntType netWgt;
-        iss >> netWgt;
-        auto mapIter = netNameMap.find(netName);
-        if (mapIter == netNameMap.end())
+        const auto &words = tokenizer.fields();
+        std::string_view netName = words.size() > 0 ? words.at(0) : std::string_view();
+        IntType netWgt = words.size() > 1 ? ::klib::toNumber<IntType>(words.at(1)) : 0;
+        IndexType netIdx = _db.netIdxByName(netName);
+        if (netIdx == INDEX_TYPE_MAX)
         {
-            ERR("ParserNetwgt::%s: Net %s is not found in the placement database \n", __FUNCTION__, netName.c_str());
+            ERR("ParserNetwgt::%s: Net %s is not found in the placement database \n", __FUNCTION__, std::string(netName).c_str());
             Assert(false);
             return false;
         }
         else
         {
-            IndexType netIdx = mapIter->second;
             _db.net(netIdx).setWeight(netWgt);
         }
     }
@@ -1,61 +1,56 @@
 #include "ParserPin.h"
-#include <iostream>
+#include "util/MmapTokenizer.h"
 
 PROJECT_NAMESPACE_BEGIN
 
-RealType stripShape(std::string word)
+/// @brief strip the parentheses around a coordinate, e.g. "(1.2," -> 1.2
+RealType stripShape(std::string_view word)
 {
-    auto pos = word.rfind(')');
-    while (pos != std::string::npos)
+    auto pos = word.find(')');
+    if (pos != std::string_view::npos)
     {
         word = word.substr(0, pos);
-        pos = word.rfind(')');
     }
-    pos = word.find('(');
-    while (pos != std::string::npos)
+    pos = word.rfind('(');
+    if (pos != std::string_view::npos)
     {
-        word = word.substr(pos+1);
-        pos = word.find('(');
+        word = word.substr(pos + 1);
     }
-    return ::atof(word.c_str());
+    return ::klib::toNumber<RealType>(word);
 }
 
 bool ParserPin::read(const std::string &filename)
 {
-    std::ifstream inf(filename.c_str());
-    if (!inf.is_open()) 
+    ::klib::MmapFile file;
+    if (!file.open(filename)) 
     {
         ERR("ParserPin::%s: cannot open file: %s \n", __FUNCTION__ , filename.c_str());
         Assert(false);
         return false;
     }
     // Read in the file
-    std::string line;
+    ::klib::LineTokenizer tokenizer(file.content());
     IndexType cellIdx = INDEX_TYPE_MAX; 
     IndexType numShapes = INDEX_TYPE_MAX;
     IndexType pinIdx = INDEX_TYPE_MAX;
-    while (std::getline(inf, line))
+    const RealType dbu = _db.tech().dbu();
+    while (tokenizer.nextLine())
     {
         // Split the line into words
-        std::vector<std::string> words;
-        std::istringstream iss(line);
-        for (std::string str; iss >> str; )
-        {
-            words.emplace_back(str);
-        }
+        const auto &words = tokenizer.fields();
         if (words.size() == 1)
         {
             // Create a new cell
             cellIdx = _db.allocateCell();
-            _db.cell(cellIdx).setName(words.at(0));
+            _db.setCellName(cellIdx, std::string(words.at(0)));
         }
         else if (words.size() == 2)
         {
             Assert(cellIdx !=  INDEX_TYPE_MAX);
             pinIdx = _db.allocatePin();
-            _db.pin(pinIdx).setName(words.at(0));
-            _db.cell(cellIdx).addPin(pinIdx); // Add pin to the cell
-            numShapes = ::atoi(words.at(1).c_str()); // The second one denotes how many shapes there is in the pin
+            _db.setPinName(pinIdx, std::string(words.at(0)));
+            _db.addPinToCell(cellIdx, pinIdx); // Add pin to the cell
+            numShapes = ::klib::toNumber<IndexType>(words.at(1)); // The second one denotes how many shapes there is in the pin
         }
         else if (words.size() > 2)
         {
@@ -65,15 +60,11 @@ bool ParserPin::read(const std::string &filename)
             // Shapes are always rectagnles
             for (IndexType idx = 0; idx < numShapes; ++idx)
             {
-                //IndexType gdsLayer = ::atoi(words.at(idx * 5).c_str());
-                RealType real = stripShape(words.at(idx *5 + 1)) * _db.tech().dbu();
-                LocType xLo = ::klib::autoRound<LocType>(real);
-                real = stripShape(words.at(idx *5 + 2)) * _db.tech().dbu();
-                LocType yLo = ::klib::autoRound<LocType>(real);
-                real = stripShape(words.at(idx *5 + 3)) * _db.tech().dbu();
-                LocType xHi = ::klib::autoRound<LocType>(real);
-                real = stripShape(words.at(idx *5 + 4)) * _db.tech().dbu();
-                LocType yHi = ::klib::autoRound<LocType>(real);
+                //IndexType gdsLayer = ::klib::toNumber<IndexType>(words.at(idx * 5));
+                LocType xLo = ::klib::autoRound<LocType>(stripShape(words.at(idx *5 + 1)) * dbu);
+                LocType yLo = ::klib::autoRound<LocType>(stripShape(words.at(idx *5 + 2)) * dbu);
+                LocType xHi = ::klib::autoRound<LocType>(stripShape(words.at(idx *5 + 3)) * dbu);
+                LocType yHi = ::klib::autoRound<LocType>(stripShape(words.at(idx *5 + 4)) * dbu);
                 pin.shape().unionBox(Box<LocType>(xLo, yLo, xHi, yHi));
             }
         }
@@ -1,28 +1,24 @@
 #include "ParserSignalPath.h"
+#include "util/MmapTokenizer.h"
 
 PROJECT_NAMESPACE_BEGIN
 
 
 bool ParserSignalPath::read(const std::string &filename)
 {
-    std::ifstream inf(filename.c_str());
-    if (!inf.is_open()) 
+    ::klib::MmapFile file;
+    if (!file.open(filename)) 
     {
         ERR("ParserPin::%s: cannot open file: %s \n", __FUNCTION__ , filename.c_str());
         Assert(false);
         return false;
     }
     // Read in the file
-    std::string line;
-    while (std::getline(inf, line))
+    ::klib::LineTokenizer tokenizer(file.content());
+    while (tokenizer.nextLine())
     {
         // Split the line into words
-        std::vector<std::string> words;
-        std::istringstream iss(line);
-        for (std::string str; iss >> str; )
-        {
-            words.emplace_back(str);
-        }
+        const auto &words = tokenizer.fields();
         if (words.size() <= 1)
         {
             continue;
@@ -33,24 +29,12 @@ bool ParserSignalPath::read(const std::string &filename)
             auto & cellName = words.at(idx);
             auto & pinName = words.at(idx + 1);
             IndexType pinIdx = INDEX_TYPE_MAX;
-            for (IndexType idx = 0; idx < _db.numCells(); ++idx)
+            IndexType cellIdx = _db.cellIdxByName(cellName);
+            if (cellIdx != INDEX_TYPE_MAX)
             {
-                const auto & cell = _db.cell(idx);
-                if (cell.name() == cellName)
-                {
-                    for (IndexType jdx = 0; jdx < cell.numPinIdx(); ++jdx)
-                    {
-                        const auto &pin = _db.pin(cell.pinIdx(jdx));
-                        if (pin.name() == pinName)
-                        {
-                            pinIdx = cell.pinIdx(jdx);
-                            break;
-                        }
-                    }
-                    break;
-                }
+                pinIdx = _db.pinIdxByName(cellIdx, pinName);
             }
-            AssertMsg(pinIdx != INDEX_TYPE_MAX, "Unknown pin! cellname: %s, pinname %s \n", cellName.c_str(), pinName.c_str());
+            AssertMsg(pinIdx != INDEX_TYPE_MAX, "Unknown pin! cellname: %s, pinname %s \n", std::string(cellName).c_str(), std::string(pinName).c_str());
             sig.addPinIdx(pinIdx);
         }
     }
@@ -1,43 +1,30 @@
 #include "ParserSymFile.h"
+#include "util/MmapTokenizer.h"
 
 PROJECT_NAMESPACE_BEGIN
 
-IndexType ParserSymFile::cellIdx(const std::string &cellName)
+IndexType ParserSymFile::cellIdx(std::string_view cellName)
 {
-    IndexType findIdx = INDEX_TYPE_MAX;
-    for (IndexType idx = 0; idx < _db.numCells(); ++idx)
-    {
-        if (_db.cell(idx).name() == cellName)
-        {
-            findIdx = idx;
-            break;
-        }
-    }
-    return findIdx;
+    return _db.cellIdxByName(cellName);
 }
 
 bool ParserSymFile::read(const std::string &filename)
 {
-    std::ifstream inf(filename.c_str());
-    if (!inf.is_open()) 
+    ::klib::MmapFile file;
+    if (!file.open(filename)) 
     {
         ERR("ParserConnection::%s: cannot open file: %s \n", __FUNCTION__ , filename.c_str());
         Assert(false);
         return false;
     }
     // Read in the file
-    std::string line;
+    ::klib::LineTokenizer tokenizer(file.content());
 
     IntType idx = -1;
-    while (std::getline(inf, line))
+    while (tokenizer.nextLine())
     {
         // Split the line into words
-        std::vector<std::string> words;
-        std::istringstream iss(line);
-        for (std::string str; iss >> str; )
-        {
-            words.emplace_back(str);
-        }
+        const auto &words = tokenizer.fields();
         if (idx == -1 && words.size() != 0)
         {
             idx = _db.allocateSymGrp();
@@ -48,20 +35,19 @@ bool ParserSymFile::read(const std::string &filename)
         }
         if (words.size() == 2)
         {
-            std::string cellName1 = words.at(0);
-            std::string cellName2 = words.at(1);
-            // Low efficency implementation
+            std::string_view cellName1 = words.at(0);
+            std::string_view cellName2 = words.at(1);
             IndexType cellIdx1 = cellIdx(cellName1);
             IndexType cellIdx2 = cellIdx(cellName2);
             if (cellIdx1 == INDEX_TYPE_MAX)
             {
-                ERR("ParserSymFile: cannot find cell %s \n", cellName1.c_str());
+                ERR("ParserSymFile: cannot find cell %s \n", std::string(cellName1).c_str());
                 Assert(false);
                 return false;
             }
             if (cellIdx2 == INDEX_TYPE_MAX)
             {
-                ERR("ParserSymFile: cannot find cell %s \n", cellName2.c_str());
+                ERR("ParserSymFile: cannot find cell %s \n", std::string(cellName2).c_str());
                 Assert(false);
                 return false;
             }
@@ -71,12 +57,11 @@ bool ParserSymFile::read(const std::string &filename)
         }
         if (words.size() == 1)
         {
-            std::string cellName = words.at(0);
-            // Low efficency implementation
+            std::string_view cellName = words.at(0);
             IndexType cellId = cellIdx(cellName);
             if (cellId == INDEX_TYPE_MAX)
             {
-                ERR("ParserSymFile: cannot find cell %s \n", cellName.c_str());
+                ERR("ParserSymFile: cannot find cell %s \n", std::string(cellName).c_str());
                 Assert(false);
                 return false;
             }
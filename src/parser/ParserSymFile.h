@@ -26,7 +26,7 @@ class ParserSymFile
         bool read(const std::string &filename);
     private:
         /// @brief find cell index from name
-        IndexType cellIdx(const std::string &cellName);
+        IndexType cellIdx(std::string_view cellName);
     private:
         Database &_db; ///< The placement engine database
 };
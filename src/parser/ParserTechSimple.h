@@ -9,6 +9,7 @@
 #define IDEAPLACE_PARSER_TECHSIMPLE_H_
 
 #include "db/Database.h"
+#include "util/MmapTokenizer.h"
 
 PROJECT_NAMESPACE_BEGIN
 
@@ -30,24 +31,25 @@ class ParserTechSimple
 
 inline bool ParserTechSimple::read(const std::string &filename)
 {
-    std::ifstream inf(filename.c_str());
-    if (!inf.is_open()) 
+    ::klib::MmapFile file;
+    if (!file.open(filename)) 
     {
         ERR("ParserTechSimple::%s: cannot open file: %s \n", __FUNCTION__ , filename.c_str());
         Assert(false);
         return false;
     }
     // Read in the file
-    std::string line;
-    while (std::getline(inf, line))
+    ::klib::LineTokenizer tokenizer(file.content());
+    while (tokenizer.nextLine())
     {
-        // Split the line into words
-        std::vector<std::string> words;
-        std::istringstream iss(line);
-        std::string layerName;
+        // Split the line into words: layer name and gds layer
+        // As the stream extraction before: a line without the gds layer still adds a layer of INDEX_TYPE_MAX, and a gds layer that is not a number is 0
+        const auto &words = tokenizer.fields();
         IndexType gdsLayer = INDEX_TYPE_MAX;
-        iss >> layerName;
-        iss >> gdsLayer;
+        if (words.size() >= 2)
+        {
+            gdsLayer = ::klib::toNumber<IndexType>(words.at(1));
+        }
         // Add to the database
         _db.tech().addGdsLayer(gdsLayer);
     }
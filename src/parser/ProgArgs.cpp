@@ -26,10 +26,21 @@ CommandLineOptions::CommandLineOptions(int argc, char** argv)
     _parser.add <std::string> ("sym", '\0', ".sym file", false);
     _parser.add <std::string> ("symnet", '\0', ".symnet file", false);
     _parser.add <std::string> ("sigpath", '\0', ".sigpath file", false);
+    _parser.add <std::string> ("snapshot", '\0', "database snapshot file. Other input files are ignored if set", false);
+    _parser.add <std::string> ("save_snapshot", '\0', "save the parsed database into a snapshot file", false);
+    _parser.add <std::string> ("gp_checkpoint", '\0', "write the global placement checkpoints into the file", false);
+    _parser.add <IntType> ("gp_checkpoint_interval", '\0', "number of outer iterations between two global placement checkpoints", false, 1, cmdline::range(1, 65535));
+    _parser.add <std::string> ("gp_resume", '\0', "resume the global placement from the checkpoint file", false);
+    _parser.add <std::string> ("result_cache", '\0', "directory caching the placement results for the same inputs", false);
+    _parser.add <std::string> ("trace", '\0', "write the timing trace in the Chrome trace_event format into the file", false);
     _parser.add <std::string> ("log", '\0', "log file", false, "");
 
     // boolean options don't need template
     //_parser.add               ("mute", '\0', "mute screen output");
+    _parser.add               ("perf_counters", '\0', "count the cycles, instructions, cache and branch misses of the timed stages");
+    _parser.add               ("async_log", '\0', "format and write the messages in a background thread");
+    _parser.add               ("mem_report", '\0', "report the heap allocations and the resident memory of each stage");
+    _parser.add <std::string> ("convergence_trace", '\0', "write the state of each global placement iteration into the file. CSV if ending with .csv", false);
 
     // Parse and check command line
     // It returns only if command line arguments are valid.
@@ -53,6 +64,17 @@ void CommandLineOptions::populateAndCheckOptions()
     symFile = _parser.get<std::string>("sym");
     symnetFile = _parser.get<std::string>("symnet");
     sigpathFile = _parser.get<std::string>("sigpath");
+    snapshotFile = _parser.get<std::string>("snapshot");
+    saveSnapshotFile = _parser.get<std::string>("save_snapshot");
+    gpCheckpointFile = _parser.get<std::string>("gp_checkpoint");
+    gpCheckpointInterval = _parser.get<IntType>("gp_checkpoint_interval");
+    gpResumeFile = _parser.get<std::string>("gp_resume");
+    resultCacheDir = _parser.get<std::string>("result_cache");
+    traceFile = _parser.get<std::string>("trace");
+    perfCounters = _parser.exist("perf_counters");
+    asyncLog = _parser.exist("async_log");
+    memReport = _parser.exist("mem_report");
+    convergenceTraceFile = _parser.get<std::string>("convergence_trace");
     log            = _parser.get<std::string>("log");
     for (const auto &rest : _parser.rest())
     {
@@ -75,6 +97,17 @@ namespace ProgArgsDetails
         progArgs.setSymFile(opt.symFile);
         progArgs.setSymnetFile(opt.symnetFile);
         progArgs.setSigpathFile(opt.sigpathFile);
+        progArgs.setSnapshotFile(opt.snapshotFile);
+        progArgs.setSaveSnapshotFile(opt.saveSnapshotFile);
+        progArgs.setGpCheckpointFile(opt.gpCheckpointFile);
+        progArgs.setGpCheckpointInterval(opt.gpCheckpointInterval);
+        progArgs.setGpResumeFile(opt.gpResumeFile);
+        progArgs.setResultCacheDir(opt.resultCacheDir);
+        progArgs.setTraceFile(opt.traceFile);
+        progArgs.setPerfCounters(opt.perfCounters);
+        progArgs.setAsyncLog(opt.asyncLog);
+        progArgs.setMemReport(opt.memReport);
+        progArgs.setConvergenceTraceFile(opt.convergenceTraceFile);
         progArgs.gdsFiles() = opt.gdsFiles;
 
         return progArgs;
@@ -32,6 +32,17 @@ public:
     std::string symFile = "";
     std::string symnetFile = "";
     std::string sigpathFile = "";
+    std::string snapshotFile = "";
+    std::string saveSnapshotFile = "";
+    std::string gpCheckpointFile = "";
+    IntType gpCheckpointInterval = 1;
+    std::string gpResumeFile = "";
+    std::string resultCacheDir = "";
+    std::string traceFile = "";
+    bool perfCounters = false;
+    bool asyncLog = false;
+    bool memReport = false;
+    std::string convergenceTraceFile = "";
     std::string log = "";
     std::vector<std::string> gdsFiles;
 
@@ -91,6 +102,60 @@ class ProgArgs
         /// @brief determine whether the techsimple file is set
         /// @return whether techsimple file is set
         bool techsimpleFileIsSet() const { return _techsimpleFile != ""; }
+        /// @brief get the database snapshot file to load
+        /// @return the database snapshot file to load
+        const std::string snapshotFile() const { Assert(this->snapshotFileIsSet()); return _snapshotFile; }
+        /// @brief determine whether the database snapshot file to load is set
+        /// @return whether the database snapshot file to load is set
+        bool snapshotFileIsSet() const { return _snapshotFile != ""; }
+        /// @brief get the file to save the database snapshot
+        /// @return the file to save the database snapshot
+        const std::string saveSnapshotFile() const { Assert(this->saveSnapshotFileIsSet()); return _saveSnapshotFile; }
+        /// @brief determine whether the file to save the database snapshot is set
+        /// @return whether the file to save the database snapshot is set
+        bool saveSnapshotFileIsSet() const { return _saveSnapshotFile != ""; }
+        /// @brief get the file to write the global placement checkpoints
+        /// @return the file to write the global placement checkpoints
+        const std::string gpCheckpointFile() const { Assert(this->gpCheckpointFileIsSet()); return _gpCheckpointFile; }
+        /// @brief determine whether the file to write the global placement checkpoints is set
+        /// @return whether the file to write the global placement checkpoints is set
+        bool gpCheckpointFileIsSet() const { return _gpCheckpointFile != ""; }
+        /// @brief get the number of outer iterations between two global placement checkpoints
+        /// @return the number of outer iterations between two global placement checkpoints
+        IndexType gpCheckpointInterval() const { return _gpCheckpointInterval; }
+        /// @brief get the global placement checkpoint to resume from
+        /// @return the global placement checkpoint to resume from
+        const std::string gpResumeFile() const { Assert(this->gpResumeFileIsSet()); return _gpResumeFile; }
+        /// @brief determine whether the global placement checkpoint to resume from is set
+        /// @return whether the global placement checkpoint to resume from is set
+        bool gpResumeFileIsSet() const { return _gpResumeFile != ""; }
+        /// @brief get the directory of the placement result cache
+        /// @return the directory of the placement result cache
+        const std::string resultCacheDir() const { Assert(this->resultCacheDirIsSet()); return _resultCacheDir; }
+        /// @brief determine whether the directory of the placement result cache is set
+        /// @return whether the directory of the placement result cache is set
+        bool resultCacheDirIsSet() const { return _resultCacheDir != ""; }
+        /// @brief get the file to write the timing trace
+        /// @return the file to write the timing trace
+        const std::string traceFile() const { Assert(this->traceFileIsSet()); return _traceFile; }
+        /// @brief determine whether the file to write the timing trace is set
+        /// @return whether the file to write the timing trace is set
+        bool traceFileIsSet() const { return _traceFile != ""; }
+        /// @brief determine whether to count the hardware events of the timed stages
+        /// @return whether to count the hardware events of the timed stages
+        bool perfCounters() const { return _perfCounters; }
+        /// @brief determine whether to write the messages in a background thread
+        /// @return whether to write the messages in a background thread
+        bool asyncLog() const { return _asyncLog; }
+        /// @brief determine whether to report the memory usage of each stage
+        /// @return whether to report the memory usage of each stage
+        bool memReport() const { return _memReport; }
+        /// @brief get the file to write the global placement iterations
+        /// @return the file to write the global placement iterations
+        const std::string convergenceTraceFile() const { Assert(this->convergenceTraceFileIsSet()); return _convergenceTraceFile; }
+        /// @brief determine whether the file to write the global placement iterations is set
+        /// @return whether the file to write the global placement iterations is set
+        bool convergenceTraceFileIsSet() const { return _convergenceTraceFile != ""; }
         /// @brief get the gds files given from the arguments
         /// @return the gds files
         const std::vector<std::string> & gdsFiles() const { return _gdsFiles; }
@@ -121,6 +186,39 @@ class ProgArgs
         /// @brief set the sigpath file
         /// @param the sigpath file file name
         void setSigpathFile(const std::string &sigpathFile) { _sigpathFile = sigpathFile; }
+        /// @brief set the database snapshot file to load
+        /// @param the database snapshot file name
+        void setSnapshotFile(const std::string &snapshotFile) { _snapshotFile = snapshotFile; }
+        /// @brief set the file to save the database snapshot
+        /// @param the database snapshot file name
+        void setSaveSnapshotFile(const std::string &saveSnapshotFile) { _saveSnapshotFile = saveSnapshotFile; }
+        /// @brief set the file to write the global placement checkpoints
+        /// @param the checkpoint file name
+        void setGpCheckpointFile(const std::string &gpCheckpointFile) { _gpCheckpointFile = gpCheckpointFile; }
+        /// @brief set the number of outer iterations between two global placement checkpoints
+        /// @param the number of outer iterations
+        void setGpCheckpointInterval(IndexType gpCheckpointInterval) { _gpCheckpointInterval = gpCheckpointInterval; }
+        /// @brief set the global placement checkpoint to resume from
+        /// @param the checkpoint file name
+        void setGpResumeFile(const std::string &gpResumeFile) { _gpResumeFile = gpResumeFile; }
+        /// @brief set the directory of the placement result cache
+        /// @param the cache directory
+        void setResultCacheDir(const std::string &resultCacheDir) { _resultCacheDir = resultCacheDir; }
+        /// @brief set the file to write the timing trace
+        /// @param the trace file name
+        void setTraceFile(const std::string &traceFile) { _traceFile = traceFile; }
+        /// @brief set whether to count the hardware events of the timed stages
+        /// @param whether to count
+        void setPerfCounters(bool perfCounters) { _perfCounters = perfCounters; }
+        /// @brief set whether to write the messages in a background thread
+        /// @param whether to write asynchronously
+        void setAsyncLog(bool asyncLog) { _asyncLog = asyncLog; }
+        /// @brief set whether to report the memory usage of each stage
+        /// @param whether to report
+        void setMemReport(bool memReport) { _memReport = memReport; }
+        /// @brief set the file to write the global placement iterations
+        /// @param the file name
+        void setConvergenceTraceFile(const std::string &convergenceTraceFile) { _convergenceTraceFile = convergenceTraceFile; }
     private:
         std::string _pinFile = ""; ///< .pin file
         std::string _netwgtFile = ""; ///< .netwgt file
@@ -129,6 +227,17 @@ class ProgArgs
         std::string _symFile = ""; ///< The .sym file
         std::string _symnetFile = ""; ///< The .symnet file
         std::string _sigpathFile = ""; ///< The .sigpath file
+        std::string _snapshotFile = ""; ///< The database snapshot to load
+        std::string _saveSnapshotFile = ""; ///< The file to save the database snapshot after parsing
+        std::string _gpCheckpointFile = ""; ///< The file to write the global placement checkpoints
+        IndexType _gpCheckpointInterval = 1; ///< The number of outer iterations between two global placement checkpoints
+        std::string _gpResumeFile = ""; ///< The global placement checkpoint to resume from
+        std::string _resultCacheDir = ""; ///< The directory of the placement result cache
+        std::string _traceFile = ""; ///< The file to write the timing trace
+        bool _perfCounters = false; ///< Whether to count the hardware events of the timed stages
+        bool _asyncLog = false; ///< Whether to write the messages in a background thread
+        bool _memReport = false; ///< Whether to report the memory usage of each stage
+        std::string _convergenceTraceFile = ""; ///< The file to write the global placement iterations
         std::vector<std::string> _gdsFiles; ///< The gds files for read
 };
 
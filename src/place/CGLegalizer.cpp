@@ -16,8 +16,20 @@ bool CGLegalizer::legalize()
     auto legalizationStopWath = WATCH_CREATE_NEW("legalization");
     legalizationStopWath->start();
 
+    if (reportStage(SolveStageType::LEGALIZATION))
+    {
+        INF("CG Legalizer: cancelled before legalization \n");
+        legalizationStopWath->stop();
+        return false;
+    }
     this->generateHorConstraints();
     _wStar = lpLegalization(true);
+    if (cancelRequested())
+    {
+        INF("CG Legalizer: cancelled after horizontal legalization \n");
+        legalizationStopWath->stop();
+        return false;
+    }
     this->generateVerConstraints();
     _hStar = lpLegalization(false);
     legalizationStopWath->stop();
@@ -40,6 +52,13 @@ bool CGLegalizer::legalize()
     
     auto dpStopWatch =  WATCH_CREATE_NEW("detailedPlacement");
     dpStopWatch->start();
+    // The placement is legal from here. A cancellation keeps the best legal placement so far
+    if (reportStage(SolveStageType::DETAILED_PLACEMENT))
+    {
+        INF("CG Legalizer: cancelled before detailed placement. Directly output legalization output. \n");
+        dpStopWatch->stop();
+        return true;
+    }
     if (_db.parameters().ifUsePinAssignment())
     {
         pinAssigner.solveFromDB();
@@ -50,6 +69,12 @@ bool CGLegalizer::legalize()
         dpStopWatch->stop();
         return true;
     }
+    if (cancelRequested())
+    {
+        INF("CG Legalizer: cancelled after the first detailed placement pass \n");
+        dpStopWatch->stop();
+        return true;
+    }
     if (!lpDetailedPlacement())
     {
         INF("CG Legalizer: detailed placement fine tunning failed. Directly output legalization output. \n");
@@ -153,6 +178,7 @@ IntType minOverlappingDirection(const Box<LocType> &box1, const Box<LocType> &bo
 
 void CGLegalizer::generateHorConstraints()
 {
+    WATCH_SCOPE("constraintGeneration");
 
     _hCG.clear();
     _vCG.clear();
@@ -178,6 +204,7 @@ void CGLegalizer::generateHorConstraints()
 }
 void CGLegalizer::generateVerConstraints()
 {
+    WATCH_SCOPE("constraintGeneration");
     _hCG.clear();
     _vCG.clear();
     _hConstraints.clear();
@@ -1120,6 +1147,7 @@ void CGLegalizer::initIrredundantEdgesDelete(bool isHor, std::vector<IndexType>
 
 RealType CGLegalizer::lpLegalization(bool isHor)
 {
+    WATCH_SCOPE("lpLegalization");
     RealType obj;
     if (isHor)
     {
@@ -1180,6 +1208,11 @@ bool CGLegalizer::lpDetailedPlacement()
     {
         return false;
     }
+    if (cancelRequested())
+    {
+        // The horizontal solution is still legal with the vertical one from before
+        return true;
+    }
 
 
     // Vertical
@@ -10,6 +10,7 @@
 
 #include "ConstraintGraph.h"
 #include "db/Database.h"
+#include "place/SolveMonitor.h"
 #include "util/linear_programming.h"
 
 PROJECT_NAMESPACE_BEGIN
@@ -115,6 +116,7 @@ class Constraints
 /// @brief The LP solver for legalization
 class LpLegalizeSolver
 {
+        friend class LegalizationKernels; ///< The benchmarks of the model construction
         typedef ::klib::lp::LpModel lp_solver_type;
         typedef ::klib::lp::LpTrait lp_trait;
         typedef lp_trait::variable_type lp_variable_type;
@@ -145,6 +147,8 @@ class LpLegalizeSolver
         void addLocVars();
         /// @brief add wirelegth variables
         void addWirelengthVars();
+        /// @brief add the variables of the extremes of the proximity groups
+        void addProximityVars();
         /// @brief add area variables
         void addAreaVars();
         /// @brief add sym group varibales
@@ -171,6 +175,8 @@ class LpLegalizeSolver
         void addSymmetryConstraintsRex();
         /// @brief add hpwl constraints
         void addHpwlConstraints();
+        /// @brief add the constraints bounding the cell centers of the proximity groups
+        void addProximityConstraints();
         /// @brief add current flow constraint
         void addCurrentFlowConstraints();
     private:
@@ -186,6 +192,8 @@ class LpLegalizeSolver
         std::vector<lp_variable_type> _locs; ///< The location variables of the ILP model
         std::vector<lp_variable_type> _wlL; ///< The left wirelength variables of the ILP model
         std::vector<lp_variable_type> _wlR; ///< The right wirelength variables of the ILP model
+        std::vector<lp_variable_type> _proxL; ///< The left extremes of the cell centers of the proximity groups
+        std::vector<lp_variable_type> _proxR; ///< The right extremes of the cell centers of the proximity groups
         lp_variable_type _dim; ///< The variable for area optimization
         RealType _wStar = 0; ///< The optimal W found in legalization step
         std::vector<lp_variable_type> _symLocs; ///< The variable for symmetric group axises
@@ -206,6 +214,7 @@ class LpLegalizeSolver
 
 class CGLegalizer
 {
+    friend class LegalizationKernels; ///< The benchmarks of the individual kernels
     private:
         class BoxEdge
         {
@@ -254,7 +263,11 @@ class CGLegalizer
         /// @param The database of IdeaPlaceEx
         explicit CGLegalizer(Database &db) : _db(db) {}
         /// @brief legalize the design
+        /// @return false if the legalization is cancelled before finishing
         bool legalize();
+        /// @brief set the monitor for reporting the progress and checking the cancellation between the LPs
+        /// @param the monitor. nullptr to disable
+        void setMonitor(SolveMonitor *monitor) { _monitor = monitor; }
         /// @brief return a copy of vertical constraint edges. 
         std::set<ConstraintEdge> vConstraint() { return _vConstraints.edges(); }
         /// @brief return a copy of horizontal constraint edges. 
@@ -322,6 +335,11 @@ class CGLegalizer
         /// @brief dagfy one graph
         /// @return if the graph was acyclic
         bool dagfyOneConstraintGraph(ConstraintGraph &cg);
+        /// @brief report entering a stage to the monitor
+        /// @return whether the cancellation has been requested
+        bool reportStage(SolveStageType stage) { return _monitor != nullptr && _monitor->reportStage(stage); }
+        /// @brief whether the cancellation has been requested
+        bool cancelRequested() const { return _monitor != nullptr && _monitor->isCancelRequested(); }
     private:
         Database &_db; ///< The database of IdeaPlaceEx
         ConstraintGraph _hCG; ///< The horizontal constraint graph
@@ -330,6 +348,7 @@ class CGLegalizer
         Constraints _vConstraints; ///< The vertical constraint edges
         RealType _wStar; ///< The width from the objective function of the first LP
         RealType _hStar; ///< The width from the objective function of the first LP
+        SolveMonitor *_monitor = nullptr; ///< The monitor for reporting the progress. Not owned
 };
 
 
@@ -0,0 +1,155 @@
+#include "ConvergenceTrace.h"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include "util/BinaryStream.h"
+#include "util/MmapTokenizer.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace ConvergenceTraceDetails
+{
+    constexpr char MAGIC[8] = {'I', 'D', 'E', 'A', 'C', 'V', 'T', 'R'};
+    constexpr std::uint32_t VERSION = 1;
+}
+
+void ConvergenceTrace::begin(const std::vector<std::string> &names)
+{
+    _names = names;
+    _columns.assign(names.size(), std::vector<RealType>());
+    _start = std::chrono::steady_clock::now();
+}
+
+void ConvergenceTrace::addRow(const std::vector<RealType> &values)
+{
+    Assert(values.size() == _columns.size());
+    for (IndexType colIdx = 0; colIdx < _columns.size(); ++colIdx)
+    {
+        _columns[colIdx].emplace_back(values[colIdx]);
+    }
+}
+
+IndexType ConvergenceTrace::columnIdx(const std::string &name) const
+{
+    for (IndexType colIdx = 0; colIdx < _names.size(); ++colIdx)
+    {
+        if (_names[colIdx] == name)
+        {
+            return colIdx;
+        }
+    }
+    return INDEX_TYPE_MAX;
+}
+
+std::vector<RealType> ConvergenceTrace::rowMajor() const
+{
+    const IndexType numCols = numColumns();
+    std::vector<RealType> values(numRows() * numCols);
+    for (IndexType colIdx = 0; colIdx < numCols; ++colIdx)
+    {
+        const auto &column = _columns[colIdx];
+        for (IndexType rowIdx = 0; rowIdx < column.size(); ++rowIdx)
+        {
+            values[rowIdx * numCols + colIdx] = column[rowIdx];
+        }
+    }
+    return values;
+}
+
+bool ConvergenceTrace::writeCsv(const std::string &filename) const
+{
+    std::ofstream out(filename);
+    if (!out.good())
+    {
+        return false;
+    }
+    for (IndexType colIdx = 0; colIdx < _names.size(); ++colIdx)
+    {
+        out << (colIdx == 0 ? "" : ",") << _names[colIdx];
+    }
+    out << "\n" << std::setprecision(10);
+    for (IndexType rowIdx = 0; rowIdx < numRows(); ++rowIdx)
+    {
+        for (IndexType colIdx = 0; colIdx < _columns.size(); ++colIdx)
+        {
+            out << (colIdx == 0 ? "" : ",") << _columns[colIdx][rowIdx];
+        }
+        out << "\n";
+    }
+    return out.good();
+}
+
+bool ConvergenceTrace::writeBinary(const std::string &filename) const
+{
+    using namespace ConvergenceTraceDetails;
+    ::klib::BinaryWriter writer(filename);
+    for (char c : MAGIC)
+    {
+        writer.pod(c);
+    }
+    writer.pod(VERSION);
+    writer.pod(static_cast<std::uint32_t>(sizeof(RealType)));
+    writer.pod(static_cast<std::uint64_t>(_names.size()));
+    for (const auto &name : _names)
+    {
+        writer.str(name);
+    }
+    for (const auto &column : _columns)
+    {
+        writer.vec(column);
+    }
+    writer.close();
+    return writer.good();
+}
+
+bool ConvergenceTrace::readBinary(const std::string &filename)
+{
+    using namespace ConvergenceTraceDetails;
+    clear();
+    ::klib::MmapFile file;
+    if (!file.open(filename))
+    {
+        ERR("ConvergenceTrace::%s cannot open %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    ::klib::BinaryReader reader(file.content());
+    char magic[sizeof(MAGIC)];
+    for (char &c : magic)
+    {
+        reader.pod(c);
+    }
+    std::uint32_t version = 0, numericalSize = 0;
+    std::uint64_t numCols = 0;
+    reader.pod(version);
+    reader.pod(numericalSize);
+    reader.pod(numCols);
+    // Each column takes at least its name length and its array length
+    if (!reader.ok() || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+            || version != VERSION || numericalSize != sizeof(RealType) || numCols > file.content().size())
+    {
+        ERR("ConvergenceTrace::%s %s is not a compatible convergence trace \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    std::vector<std::string> names(numCols);
+    std::vector<std::vector<RealType>> columns(numCols);
+    for (auto &name : names)
+    {
+        reader.str(name);
+    }
+    bool isRectangular = true;
+    for (auto &column : columns)
+    {
+        reader.vec(column);
+        isRectangular = isRectangular && column.size() == columns.front().size();
+    }
+    if (!reader.ok() || !reader.atEnd() || !isRectangular)
+    {
+        ERR("ConvergenceTrace::%s %s is corrupted \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    _names = std::move(names);
+    _columns = std::move(columns);
+    return true;
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,67 @@
+/**
+ * @file ConvergenceTrace.h
+ * @brief The per-iteration record of the global placement optimization
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_CONVERGENCE_TRACE_H_
+#define IDEAPLACE_CONVERGENCE_TRACE_H_
+
+#include <chrono>
+#include "global/global.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class IDEAPLACE::ConvergenceTrace
+/// @brief a table of the optimization state, one row per iteration. The values are kept by columns.
+/// The columns are set by the optimizer at the start of a run, as the numbers of multipliers and alpha depend on the problem
+class ConvergenceTrace
+{
+    public:
+        /// @brief default constructor
+        explicit ConvergenceTrace() = default;
+        /// @brief clear the table and start a new run
+        /// @param the names of the columns
+        void begin(const std::vector<std::string> &names);
+        /// @brief add a row
+        /// @param the values. One per column
+        void addRow(const std::vector<RealType> &values);
+        /// @brief clear the table
+        void clear() { _names.clear(); _columns.clear(); }
+        /// @brief the time since the start of the run
+        /// @return the time in seconds
+        RealType elapsedSeconds() const
+        {
+            return std::chrono::duration<RealType>(std::chrono::steady_clock::now() - _start).count();
+        }
+        /// @brief the names of the columns
+        const std::vector<std::string> & names() const { return _names; }
+        /// @brief the number of columns
+        IndexType numColumns() const { return _names.size(); }
+        /// @brief the number of rows
+        IndexType numRows() const { return _columns.empty() ? 0 : _columns.front().size(); }
+        /// @brief the values of a column
+        const std::vector<RealType> & column(IndexType colIdx) const { return _columns.at(colIdx); }
+        /// @brief the index of a column
+        /// @return INDEX_TYPE_MAX if not found
+        IndexType columnIdx(const std::string &name) const;
+        /// @brief the values in row-major order, ie. numRows() x numColumns()
+        std::vector<RealType> rowMajor() const;
+        /// @brief write the table as comma-separated values with a header line
+        /// @return if successful
+        bool writeCsv(const std::string &filename) const;
+        /// @brief write the table as a binary file: the header, the names and then one array per column
+        /// @return if successful
+        bool writeBinary(const std::string &filename) const;
+        /// @brief read a table written by writeBinary
+        /// @return if successful. If not, the table is cleared
+        bool readBinary(const std::string &filename);
+    private:
+        std::vector<std::string> _names; ///< The names of the columns
+        std::vector<std::vector<RealType>> _columns; ///< The values of each column
+        std::chrono::steady_clock::time_point _start = std::chrono::steady_clock::now(); ///< The start of the run
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //IDEAPLACE_CONVERGENCE_TRACE_H_
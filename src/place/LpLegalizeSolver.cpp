@@ -89,6 +89,12 @@ void LpLegalizeSolver::addWirelengthObj()
             auto weight = _db.net(netIdx).weight();
             _obj += weight * (_wlR[netIdx] - _wlL[netIdx]);
         }
+        // The proximity groups count as nets connecting the cell centers
+        for (IndexType grpIdx = 0; grpIdx < _proxL.size(); ++grpIdx)
+        {
+            hasAtLeastOneNet = true;
+            _obj += _db.proximityGrp(grpIdx).weight() * (_proxR[grpIdx] - _proxL[grpIdx]);
+        }
         if (!hasAtLeastOneNet)
         {
             ERR("LP Legalizer:: No valid net \n");
@@ -152,7 +158,7 @@ void LpLegalizeSolver::configureObjFunc()
 IndexType LpLegalizeSolver::numVars() const
 {
     auto numLocVars = _db.numCells();
-    auto numHpwlVars = _db.numNets() * 2 * _optHpwl;
+    auto numHpwlVars = (_db.numNets() + _db.proximityGrps().size()) * 2 * _optHpwl;
     auto numBoundaryVars = 1 * _optArea;
     IndexType numSymVars;
     if (_isMultipleSymGrp)
@@ -191,6 +197,20 @@ void LpLegalizeSolver::addWirelengthVars()
     }
 }
 
+void LpLegalizeSolver::addProximityVars()
+{
+    if (_optHpwl == 1)
+    {
+        _proxL.resize(_db.proximityGrps().size());
+        _proxR.resize(_db.proximityGrps().size());
+        for (IndexType i = 0; i < _db.proximityGrps().size(); ++i)
+        {
+            _proxL.at(i) = lp_trait::addVar(_solver);
+            _proxR.at(i) = lp_trait::addVar(_solver);
+        }
+    }
+}
+
 void LpLegalizeSolver::addAreaVars()
 {
     if (_optArea == 1)
@@ -250,6 +270,8 @@ void LpLegalizeSolver::addIlpVars()
     this->addLocVars();
     // Add wire length variables
     this->addWirelengthVars();
+    // Add proximity group variables
+    this->addProximityVars();
     // Add area variables
     this->addAreaVars();
     // Add symmetric variables
@@ -546,6 +568,21 @@ void LpLegalizeSolver::addHpwlConstraints()
     }
 }
 
+void LpLegalizeSolver::addProximityConstraints()
+{
+    for (IndexType grpIdx = 0; grpIdx < _proxL.size(); ++grpIdx)
+    {
+        for (IndexType cellIdx : _db.proximityGrp(grpIdx).cells())
+        {
+            const auto &cellBBox = _db.cell(cellIdx).cellBBox();
+            RealType offset = static_cast<RealType>(_isHor ? cellBBox.xLen() : cellBBox.yLen()) / 2;
+            // prox_l <= _loc + offset and prox_r >= _loc + offset for all cells in the group
+            lp_trait::addConstr(_solver, _proxL.at(grpIdx) - _locs.at(cellIdx) <= offset);
+            lp_trait::addConstr(_solver, _proxR.at(grpIdx) - _locs.at(cellIdx) >= offset);
+        }
+    }
+}
+
 void LpLegalizeSolver::addCurrentFlowConstraints()
 {
     if (_isHor) { return; }
@@ -594,6 +631,8 @@ void LpLegalizeSolver::addIlpConstraints()
     addSymmetryConstraints();
     // Add HPWL constraints
     addHpwlConstraints();
+    // Add proximity group constraints
+    addProximityConstraints();
     /// Add current flow constraints
     addCurrentFlowConstraints();
 }
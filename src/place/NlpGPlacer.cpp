@@ -1,5 +1,6 @@
 #include "NlpGPlacer.h"
 #include "place/signalPathMgr.h"
+#include "place/VectorMath.h"
 
 
 PROJECT_NAMESPACE_BEGIN
@@ -254,6 +255,23 @@ void NlpGPlacerBase<nlp_settings>::initOperators()
         }
         op.setGetVarFunc(getVarFunc);
     }
+    // Proximity groups. They are in the wirelength objective and pull the cell centers together
+    for (const auto &proximityGrp : _db.proximityGrps())
+    {
+        if (proximityGrp.cells().size() < 2)
+        {
+            continue;
+        }
+        _proxOps.emplace_back(nlp_prox_type(getAlphaFunc, getLambdaFuncHpwl));
+        auto &op = _proxOps.back();
+        op.setWeight(proximityGrp.weight());
+        for (IndexType cellIdx : proximityGrp.cells())
+        {
+            const auto &cellBBox = _db.cell(cellIdx).cellBBox();
+            op.addCell(cellIdx, cellBBox.xLen() * _scale / 2, cellBBox.yLen() * _scale / 2);
+        }
+        op.setGetVarFunc(getVarFunc);
+    }
     // Pair-wise cell overlapping
     for (IndexType cellIdxI = 0; cellIdxI < _db.numCells(); ++cellIdxI)
     {
@@ -473,21 +491,15 @@ void NlpGPlacerBase<nlp_settings>::initOperators()
         if (constr.relationalType() == Orient2DType::VERTICAL) 
         {
 
-            _verOps.emplace_back(sCellIdx, sOffset.y(),
-                    tCellIdx, tOffset.y(),
-                    getLambdaFuncCosine);
-            _verOps.back().setGetVarFunc(getVarFunc);
-            _verOps.back().setGetAlphaFunc(getAlphaFunc);
-            _verOps.back().setWeight(_db.parameters().defaultRelationalConstraintWeight() * constr.weight() / rel_size);
+            _verBatch.addConstraint(plIdx(sCellIdx, Orient2DType::VERTICAL), sOffset.y(),
+                    plIdx(tCellIdx, Orient2DType::VERTICAL), tOffset.y(),
+                    _db.parameters().defaultRelationalConstraintWeight() * constr.weight() / rel_size);
         }
         else if (constr.relationalType() == Orient2DType::HORIZONTAL) 
         {
-            _horOps.emplace_back(sCellIdx, sOffset.x(),
-                    tCellIdx, tOffset.x(),
-                    getLambdaFuncCosine);
-            _horOps.back().setGetVarFunc(getVarFunc);
-            _horOps.back().setGetAlphaFunc(getAlphaFunc);
-            _horOps.back().setWeight(_db.parameters().defaultRelationalConstraintWeight() * constr.weight() / rel_size);
+            _horBatch.addConstraint(plIdx(sCellIdx, Orient2DType::HORIZONTAL), sOffset.x(),
+                    plIdx(tCellIdx, Orient2DType::HORIZONTAL), tOffset.x(),
+                    _db.parameters().defaultRelationalConstraintWeight() * constr.weight() / rel_size);
         }
         else
         {
@@ -495,9 +507,14 @@ void NlpGPlacerBase<nlp_settings>::initOperators()
             return;
         }
     }
-    INF("Ideaplace global placement:: number of operators %d, hpwl %d ovl %d oob %d asym %d sigFlow %d power %d crf \n", 
-    _hpwlOps.size()+ _ovlOps.size()+ _oobOps.size()+ _asymOps.size()+ _cosOps.size()+ _powerWlOps.size() + _crfOps.size(),
-            _hpwlOps.size(), _ovlOps.size(), _oobOps.size(), _asymOps.size(), _cosOps.size(), _powerWlOps.size(), _crfOps.size());
+    _verBatch.setGetAlphaFunc(getAlphaFunc);
+    _verBatch.setGetLambdaFunc(getLambdaFuncCosine);
+    _horBatch.setGetAlphaFunc(getAlphaFunc);
+    _horBatch.setGetLambdaFunc(getLambdaFuncCosine);
+    INF("Ideaplace global placement:: number of operators %d, hpwl %d ovl %d oob %d asym %d sigFlow %d power %d crf %d proximity %d ver %d hor %d \n", 
+    _hpwlOps.size()+ _ovlOps.size()+ _oobOps.size()+ _asymOps.size()+ _cosOps.size()+ _powerWlOps.size() + _crfOps.size() + _proxOps.size(),
+            _hpwlOps.size(), _ovlOps.size(), _oobOps.size(), _asymOps.size(), _cosOps.size(), _powerWlOps.size(), _crfOps.size(), _proxOps.size(),
+            _verBatch.numConstraints(), _horBatch.numConstraints());
 }
 
 template<typename nlp_settings>
@@ -548,6 +565,27 @@ void NlpGPlacerBase<nlp_settings>::writeOut()
 
 }
 
+template<typename nlp_settings>
+bool NlpGPlacerBase<nlp_settings>::reportProgress(IntType outerIter)
+{
+    if (_monitor == nullptr)
+    {
+        return false;
+    }
+    SolveProgress progress;
+    progress.stage = SolveStageType::GLOBAL_PLACEMENT;
+    progress.outerIter = outerIter;
+    progress.obj = _obj;
+    progress.objHpwl = _objHpwl;
+    progress.objOvl = _objOvl;
+    progress.objOob = _objOob;
+    progress.objAsym = _objAsym;
+    progress.objCos = _objCos;
+    progress.objPowerWl = _objPowerWl;
+    progress.objCrf = _objCrf;
+    return _monitor->report(progress);
+}
+
 template<typename nlp_settings>
 void NlpGPlacerBase<nlp_settings>::constructTasks()
 {
@@ -571,6 +609,12 @@ void NlpGPlacerBase<nlp_settings>::constructObjectiveCalculationTasks()
         auto eva = [&]() { return diff::placement_differentiable_traits<nlp_hpwl_type>::evaluate(hpwl);};
         _evaHpwlTasks.emplace_back(Task<EvaObjTask>(EvaObjTask(eva)));
     }
+    // The proximity groups are summed into the hpwl
+    for (const auto &prox : _proxOps)
+    {
+        auto eva = [&]() { return diff::placement_differentiable_traits<nlp_prox_type>::evaluate(prox);};
+        _evaHpwlTasks.emplace_back(Task<EvaObjTask>(EvaObjTask(eva)));
+    }
     for (const auto &ovl : _ovlOps)
     {
         auto eva = [&]() { return diff::placement_differentiable_traits<nlp_ovl_type>::evaluate(ovl);};
@@ -601,16 +645,8 @@ void NlpGPlacerBase<nlp_settings>::constructObjectiveCalculationTasks()
         auto eva = [&]() { return diff::placement_differentiable_traits<nlp_crf_type>::evaluate(op);};
         _evaCosTasks.emplace_back(Task<EvaObjTask>(EvaObjTask(eva)));
     }
-    for (const auto &op : _verOps)
-    {
-        auto eva = [&]() { return diff::placement_differentiable_traits<nlp_ver_type>::evaluate(op);};
-        _evaVerTasks.emplace_back(Task<EvaObjTask>(EvaObjTask(eva)));
-    }
-    for (const auto &op : _horOps)
-    {
-        auto eva = [&]() { return diff::placement_differentiable_traits<nlp_hor_type>::evaluate(op);};
-        _evaHorTasks.emplace_back(Task<EvaObjTask>(EvaObjTask(eva)));
-    }
+    _evaVerTasks.emplace_back(Task<EvaObjTask>(EvaObjTask([&]() { return _verBatch.evaluate(_pl); })));
+    _evaHorTasks.emplace_back(Task<EvaObjTask>(EvaObjTask([&]() { return _horBatch.evaluate(_pl); })));
 }
 
 template<typename nlp_settings>
@@ -691,7 +727,7 @@ void NlpGPlacerBase<nlp_settings>::constructSumObjTasks()
     auto hor = [&]()
     {
         _objHor = 0.0;
-        for (const auto &eva : _evaVerTasks)
+        for (const auto &eva : _evaHorTasks)
         {
             _objHor += eva.taskData().obj();
         }
@@ -854,15 +890,33 @@ void NlpGPlacerFirstOrder<nlp_settings>::optimize()
     alpha_update_trait::init(*this, alpha, alphaUpdate);
 
     IntType iter = 0;
-    do
+    BoolType stop = false;
+    if (this->_db.parameters().ifResumeGp())
+    {
+        if (resumeFromCheckpoint(iter, stop, multiplier, multAdjuster, alpha, alphaUpdate))
+        {
+            INF("First order NLP: resume from outer iteration %d \n", iter);
+            this->assignIoPins();
+            this->_wrapObjAllTask.run();
+        }
+        else
+        {
+            WRN("First order NLP: failed to resume from %s. Start from the beginning \n", this->_db.parameters().gpResumeFile().c_str());
+        }
+    }
+    beginConvergenceTrace(multiplier, alpha);
+    while (not stop)
     {
         INF("First order NLP: iter %d \n", iter);
+        traceOuterIteration(iter, multiplier, alpha);
 
         optm_trait::optimize(*this, optm);
         updateProblemStopWatch->start();
+        const auto multsBefore = multiplier._variedMults;
         mult_trait::update(*this, multiplier);
         mult_trait::recordRaw(*this, multiplier);
         mult_adjust_trait::update(*this, multiplier, multAdjuster);
+        this->recordMultDistance(multsBefore, multiplier._variedMults);
 
         alpha_update_trait::update(*this, alpha, alphaUpdate);
         this->assignIoPins();
@@ -872,11 +926,118 @@ void NlpGPlacerFirstOrder<nlp_settings>::optimize()
         DBG("obj %f hpwl %f ovl %f oob %f asym %f cos %f \n", this->_obj, this->_objHpwl, this->_objOvl, this->_objOob, this->_objAsym, this->_objCos);
 #endif
         ++iter;
-    } while (not base_type::stop_condition_trait::stopPlaceCondition(*this, this->_stopCondition));
+        stop = base_type::stop_condition_trait::stopPlaceCondition(*this, this->_stopCondition);
+        writeCheckpoint(iter, stop, multiplier, multAdjuster, alpha, alphaUpdate);
+        if (this->reportProgress(iter))
+        {
+            // Keep the current solution as the partial result
+            WRN("First order NLP: cancelled after outer iteration %d \n", iter);
+            break;
+        }
+    }
+    traceOuterIteration(iter, multiplier, alpha);
     optimizeStopWatch->stop();
     this->writeOut();
 }
 
+template<typename nlp_settings>
+template<typename trace_mult_type, typename trace_alpha_type>
+void NlpGPlacerFirstOrder<nlp_settings>::beginConvergenceTrace(const trace_mult_type &multiplier, const trace_alpha_type &alpha)
+{
+    if (not isTracingConvergence())
+    {
+        return;
+    }
+    std::vector<std::string> names = {"outer", "inner", "time", "obj", "hpwl", "ovl", "oob", "asym", "cos", "powerWl", "crf", "ver", "hor",
+        "gradNorm", "stepNorm"};
+    for (IndexType idx = 0; idx < multiplier._constMults.size(); ++idx)
+    {
+        names.emplace_back("constMult" + std::to_string(idx));
+    }
+    for (IndexType idx = 0; idx < multiplier._variedMults.size(); ++idx)
+    {
+        names.emplace_back("variedMult" + std::to_string(idx));
+    }
+    for (IndexType idx = 0; idx < alpha._alpha.size(); ++idx)
+    {
+        names.emplace_back("alpha" + std::to_string(idx));
+    }
+    this->_convergenceTrace->begin(names);
+    _traceRow.resize(names.size());
+}
+
+template<typename nlp_settings>
+template<typename trace_mult_type, typename trace_alpha_type>
+void NlpGPlacerFirstOrder<nlp_settings>::traceOuterIteration(IntType outerIter, const trace_mult_type &multiplier, const trace_alpha_type &alpha)
+{
+    if (not isTracingConvergence())
+    {
+        return;
+    }
+    _traceOuterIter = outerIter;
+    _traceParams.clear();
+    _traceParams.insert(_traceParams.end(), multiplier._constMults.begin(), multiplier._constMults.end());
+    _traceParams.insert(_traceParams.end(), multiplier._variedMults.begin(), multiplier._variedMults.end());
+    _traceParams.insert(_traceParams.end(), alpha._alpha.begin(), alpha._alpha.end());
+    // The multipliers and alpha may have been updated after the last evaluation
+    this->calcObj();
+    calcGrad();
+    addTraceRow(0, 0.0);
+}
+
+template<typename nlp_settings>
+void NlpGPlacerFirstOrder<nlp_settings>::addTraceRow(IndexType innerIter, RealType stepNorm)
+{
+    auto &row = _traceRow;
+    const RealType fixed[] = {static_cast<RealType>(_traceOuterIter), static_cast<RealType>(innerIter), this->_convergenceTrace->elapsedSeconds(),
+        this->_obj, this->_objHpwl, this->_objOvl, this->_objOob, this->_objAsym, this->_objCos, this->_objPowerWl, this->_objCrf,
+        this->_objVer, this->_objHor, _grad.norm(), stepNorm};
+    constexpr IndexType numFixed = sizeof(fixed) / sizeof(fixed[0]);
+    Assert(row.size() == numFixed + _traceParams.size());
+    std::copy(fixed, fixed + numFixed, row.begin());
+    std::copy(_traceParams.begin(), _traceParams.end(), row.begin() + numFixed);
+    this->_convergenceTrace->addRow(row);
+}
+
+template<typename nlp_settings>
+void NlpGPlacerFirstOrder<nlp_settings>::writeCheckpoint(IntType outerIter, BoolType isFinished, const mult_type &multiplier, const mult_adjust_type &multAdjuster,
+        const alpha_type &alpha, const alpha_update_type &alphaUpdate)
+{
+    const auto &para = this->_db.parameters();
+    if (not para.ifWriteGpCheckpoint())
+    {
+        return;
+    }
+    // Always keep the final result, so that a failed legalization can restart from it
+    if (not isFinished and outerIter % static_cast<IntType>(para.gpCheckpointInterval()) != 0)
+    {
+        return;
+    }
+    auto checkpoint = checkpoint_trait::capture(*this, outerIter, isFinished, multiplier, multAdjuster, alpha, alphaUpdate);
+    if (not nlp::checkpoint::write(checkpoint, para.gpCheckpointFile()))
+    {
+        WRN("First order NLP: failed to write the checkpoint at outer iteration %d \n", outerIter);
+    }
+}
+
+template<typename nlp_settings>
+bool NlpGPlacerFirstOrder<nlp_settings>::resumeFromCheckpoint(IntType &outerIter, BoolType &isFinished, mult_type &multiplier, mult_adjust_type &multAdjuster,
+        alpha_type &alpha, alpha_update_type &alphaUpdate)
+{
+    typename checkpoint_trait::checkpoint_type checkpoint;
+    if (not nlp::checkpoint::read(checkpoint, this->_db.parameters().gpResumeFile()))
+    {
+        return false;
+    }
+    if (not checkpoint_trait::restore(*this, checkpoint, multiplier, multAdjuster, alpha, alphaUpdate))
+    {
+        return false;
+    }
+    outerIter = checkpoint.outerIter;
+    isFinished = checkpoint.isFinished;
+    return true;
+}
+
 template<typename nlp_settings>
 void NlpGPlacerFirstOrder<nlp_settings>::initProblem()
 {
@@ -930,8 +1091,7 @@ void NlpGPlacerFirstOrder<nlp_settings>::constructCalcPartialsTasks()
     using Cos = CalculateOperatorPartialTask<nlp_cos_type, EigenVector>;
     using Pwl = CalculateOperatorPartialTask<nlp_power_wl_type, EigenVector>;
     using Crf = CalculateOperatorPartialTask<nlp_crf_type, EigenVector>;
-    using Ver = CalculateOperatorPartialTask<nlp_ver_type, EigenVector>;
-    using Hor = CalculateOperatorPartialTask<nlp_hor_type, EigenVector>;
+    using Prox = CalculateOperatorPartialTask<nlp_prox_type, EigenVector>;
     for (auto &hpwlOp : this->_hpwlOps)
     {
         _calcHpwlPartialTasks.emplace_back(Task<Hpwl>(Hpwl(&hpwlOp)));
@@ -960,13 +1120,9 @@ void NlpGPlacerFirstOrder<nlp_settings>::constructCalcPartialsTasks()
     {
         _calcCrfPartialTasks.emplace_back(Task<Crf>(&crfOp));
     }
-    for (auto &verOp : this->_verOps)
-    {
-        _calcVerPartialTasks.emplace_back(Task<Ver>(&verOp));
-    }
-    for (auto &horOp : this->_horOps)
+    for (auto &proxOp : this->_proxOps)
     {
-        _calcHorPartialTasks.emplace_back(Task<Hor>(&horOp));
+        _calcProxPartialTasks.emplace_back(Task<Prox>(&proxOp));
     }
 }
 
@@ -980,8 +1136,7 @@ void NlpGPlacerFirstOrder<nlp_settings>::constructUpdatePartialsTasks()
     using Cos = UpdateGradientFromPartialTask<nlp_cos_type, EigenVector>;
     using Pwl = UpdateGradientFromPartialTask<nlp_power_wl_type, EigenVector>;
     using Crf = UpdateGradientFromPartialTask<nlp_crf_type, EigenVector>;
-    using Ver = UpdateGradientFromPartialTask<nlp_ver_type, EigenVector>;
-    using Hor = UpdateGradientFromPartialTask<nlp_hor_type, EigenVector>;
+    using Prox = UpdateGradientFromPartialTask<nlp_prox_type, EigenVector>;
     auto getIdxFunc = [&](IndexType cellIdx, Orient2DType orient) { return this->plIdx(cellIdx, orient); }; // wrapper the convert cell idx to pl idx
     for (auto &hpwl : _calcHpwlPartialTasks)
     {
@@ -1011,13 +1166,9 @@ void NlpGPlacerFirstOrder<nlp_settings>::constructUpdatePartialsTasks()
     {
         _updateCrfPartialTasks.emplace_back(Task<Crf>(Crf(crf.taskDataPtr(), &_gradCrf, getIdxFunc)));
     }
-    for (auto &ver : _calcVerPartialTasks)
-    {
-        _updateVerPartialTasks.emplace_back(Task<Ver>(Ver(ver.taskDataPtr(), &_gradVer, getIdxFunc)));
-    }
-    for (auto &hor : _calcHorPartialTasks)
+    for (auto &prox : _calcProxPartialTasks)
     {
-        _updateHorPartialTasks.emplace_back(Task<Hor>(Hor(hor.taskDataPtr(), &_gradHor, getIdxFunc)));
+        _updateProxPartialTasks.emplace_back(Task<Prox>(Prox(prox.taskDataPtr(), &_gradHpwl, getIdxFunc)));
     }
 }
 
@@ -1039,15 +1190,15 @@ void NlpGPlacerFirstOrder<nlp_settings>::constructClearGradTasks()
 template<typename nlp_settings>
 void NlpGPlacerFirstOrder<nlp_settings>::constructSumGradTask()
 {
-    _sumHpwlGradTask = Task<FuncTask>(FuncTask([&](){ for (auto &upd : _updateHpwlPartialTasks){ upd.run(); }}));
+    _sumHpwlGradTask = Task<FuncTask>(FuncTask([&](){ for (auto &upd : _updateHpwlPartialTasks){ upd.run(); } for (auto &upd : _updateProxPartialTasks){ upd.run(); }}));
     _sumOvlGradTask = Task<FuncTask>(FuncTask([&](){ for (auto &upd : _updateOvlPartialTasks){ upd.run(); }}));
     _sumOobGradTask = Task<FuncTask>(FuncTask([&](){ for (auto &upd : _updateOobPartialTasks){ upd.run(); }}));
     _sumAsymGradTask = Task<FuncTask>(FuncTask([&](){ for (auto &upd : _updateAsymPartialTasks){ upd.run(); }}));
     _sumCosGradTask = Task<FuncTask>(FuncTask([&](){ for (auto &upd : _updateCosPartialTasks){ upd.run(); }}));
     _sumPowerWlTaskGradTask = Task<FuncTask>(FuncTask([&](){ for (auto &upd : _updatePowerWlPartialTasks){ upd.run(); }}));
     _sumCrfGradTask = Task<FuncTask>(FuncTask([&]() { for (auto &upd : _updateCrfPartialTasks) {upd.run(); }}));
-    _sumVerGradTask = Task<FuncTask>(FuncTask([&]() { for (auto &upd : _updateVerPartialTasks) {upd.run(); }}));
-    _sumHorGradTask = Task<FuncTask>(FuncTask([&]() { for (auto &upd : _updateHorPartialTasks) {upd.run(); }}));
+    _sumVerGradTask = Task<FuncTask>(FuncTask([&]() { this->_verBatch.accumulateGradient(this->_pl, _gradVer); }));
+    _sumHorGradTask = Task<FuncTask>(FuncTask([&]() { this->_horBatch.accumulateGradient(this->_pl, _gradHor); }));
     _sumGradTask = Task<FuncTask>(FuncTask([&](){ _grad = _gradHpwl + _gradOvl + _gradOob + _gradAsym + _gradCos + _gradPowerWl + _gradCrf
                 + _gradVer + _gradHor; }));
 }
@@ -1073,6 +1224,9 @@ void NlpGPlacerFirstOrder<nlp_settings>::constructWrapCalcGradTask()
         for (IndexType i = 0; i < _calcHpwlPartialTasks.size(); ++i ) { _calcHpwlPartialTasks[i].run(); }
         for (IndexType i = 0; i < _updateHpwlPartialTasks.size(); ++i ) { _updateHpwlPartialTasks[i].run(); }
         #pragma omp parallel for schedule(static)
+        for (IndexType i = 0; i < _calcProxPartialTasks.size(); ++i ) { _calcProxPartialTasks[i].run(); }
+        for (IndexType i = 0; i < _updateProxPartialTasks.size(); ++i ) { _updateProxPartialTasks[i].run(); }
+        #pragma omp parallel for schedule(static)
         for (IndexType i = 0; i < _calcOvlPartialTasks.size(); ++i ) { _calcOvlPartialTasks[i].run(); }
         for (IndexType i = 0; i < _updateOvlPartialTasks.size(); ++i ) { _updateOvlPartialTasks[i].run(); }
         #pragma omp parallel for schedule(static)
@@ -1090,12 +1244,8 @@ void NlpGPlacerFirstOrder<nlp_settings>::constructWrapCalcGradTask()
         #pragma omp parallel for schedule(static)
         for (IndexType i = 0; i < _calcCrfPartialTasks.size(); ++i ) { _calcCrfPartialTasks[i].run(); }
         for (IndexType i = 0; i < _updateCrfPartialTasks.size(); ++i ) { _updateCrfPartialTasks[i].run(); }
-        #pragma omp parallel for schedule(static)
-        for (IndexType i = 0; i < _calcVerPartialTasks.size(); ++i ) { _calcVerPartialTasks[i].run(); }
-        for (IndexType i = 0; i < _updateVerPartialTasks.size(); ++i ) { _updateVerPartialTasks[i].run(); }
-        #pragma omp parallel for schedule(static)
-        for (IndexType i = 0; i < _calcHorPartialTasks.size(); ++i ) { _calcHorPartialTasks[i].run(); }
-        for (IndexType i = 0; i < _updateHorPartialTasks.size(); ++i ) { _updateHorPartialTasks[i].run(); }
+        _sumVerGradTask.run();
+        _sumHorGradTask.run();
         _sumGradTask.run();
         _calcGradStopWatch->stop();
     };
@@ -1202,6 +1352,12 @@ void NlpGPlacerFirstOrder<nlp_settings>::regCalcGradForLoop(tf::Taskflow &tfFlow
         _beginGradCalcTask.precede(op);
         op.precede(_endGradCalcTask);
     }
+    for (auto & op : _calcProxPartialTasks)
+    {
+        op.regTask(tfFlow);
+        _beginGradCalcTask.precede(op);
+        op.precede(_endGradCalcTask);
+    }
     for (auto & op : _calcOvlPartialTasks)
     {
         op.regTask(tfFlow);
@@ -1302,5 +1458,13 @@ PROJECT_NAMESPACE_BEGIN
 template class NlpGPlacerBase<nlp::nlp_default_settings>;
 template class NlpGPlacerFirstOrder<nlp::nlp_default_settings>;
 template class NlpGPlacerSecondOrder<nlp::nlp_default_settings>;
+// and the weighted-average wirelength
+template class NlpGPlacerBase<nlp::nlp_wa_settings>;
+template class NlpGPlacerFirstOrder<nlp::nlp_wa_settings>;
+template class NlpGPlacerSecondOrder<nlp::nlp_wa_settings>;
+// and the adaptive inner iteration budget
+template class NlpGPlacerBase<nlp::nlp_adaptive_budget_settings>;
+template class NlpGPlacerFirstOrder<nlp::nlp_adaptive_budget_settings>;
+template class NlpGPlacerSecondOrder<nlp::nlp_adaptive_budget_settings>;
 
 PROJECT_NAMESPACE_END
@@ -8,6 +8,7 @@
 #ifndef IDEAPLACE_NLPGPLACER_H_
 #define IDEAPLACE_NLPGPLACER_H_
 
+#include <omp.h>
 #include <Eigen/Dense>
 #ifdef IDEAPLACE_TASKFLOR_FOR_GRAD_OBJ_
 #include <taskflow/taskflow.hpp>
@@ -15,6 +16,8 @@
 #include "db/Database.h"
 #include "place/different.h"
 #include "place/differentSecondOrder.hpp"
+#include "place/SolveMonitor.h"
+#include "place/ConvergenceTrace.h"
 #include "place/nlp/nlpOuterOptm.hpp"
 #include "place/nlp/nlpInitPlace.hpp"
 #include "place/nlp/nlpTasks.hpp"
@@ -22,6 +25,7 @@
 #include "place/nlp/nlpOptmKernels.hpp"
 #include "place/nlp/nlpFirstOrderKernel.hpp"
 #include "place/nlp/nlpSecondOrderKernels.hpp"
+#include "place/nlp/nlpCheckpoint.hpp"
 #include "place/nlp/conjugateGradientWnlib.hpp" // TODO: remove after no need
 #include "pinassign/VirtualPinAssigner.h"
 PROJECT_NAMESPACE_BEGIN
@@ -49,8 +53,9 @@ namespace nlp
         typedef diff::CosineDatapathDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_cos_type;
         typedef diff::PowerVerQuadraticWireLengthDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_power_wl_type;
         typedef diff::VerticalConstraintDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_crf_type;
-        typedef diff::VerticalConstraintDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_ver_type;
-        typedef diff::HorizontalConstraintDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_hor_type;
+        typedef diff::RelationalConstraintBatchDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_ver_type;
+        typedef diff::RelationalConstraintBatchDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_hor_type;
+        typedef diff::ProximityGroupDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_prox_type;
     };
     
     struct nlp_default_zero_order_algorithms
@@ -108,6 +113,7 @@ namespace nlp
         typedef diff::jacobi_hessian_approx_trait<typename nlp_types::nlp_asym_type> asym_hessian_trait;
         typedef diff::jacobi_hessian_approx_trait<typename nlp_types::nlp_cos_type> cos_hessian_trait;
         typedef diff::jacobi_hessian_approx_trait<typename nlp_types::nlp_power_wl_type> power_wl_hessian_trait;
+        typedef diff::jacobi_hessian_approx_trait<typename nlp_types::nlp_prox_type> prox_hessian_trait;
     };
 
 
@@ -148,6 +154,36 @@ namespace nlp
         typedef nlp_default_second_order_algorithms nlp_second_order_algorithms_type;
     };
 
+    /// @brief the default types with the weighted-average wirelength instead of LSE
+    struct nlp_wa_types : public nlp_default_types
+    {
+        typedef diff::WaHpwlDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_hpwl_type;
+    };
+
+    /// @brief the default settings with the weighted-average wirelength instead of LSE
+    struct nlp_wa_settings : public nlp_default_settings
+    {
+        typedef nlp_wa_types nlp_types_type;
+        typedef nlp_default_second_order_settings<nlp_types_type> nlp_second_order_setting_type;
+    };
+
+    /// @brief the default first order algorithms with the inner iterations budgeted by the objective reduction rate and the multipliers
+    struct nlp_adaptive_budget_first_order_algorithms : public nlp_default_first_order_algorithms
+    {
+        typedef converge::converge_list<
+                    converge::converge_grad_norm_by_init<nlp_default_types::nlp_numerical_type>,
+                    converge::converge_criteria_adaptive_budget<nlp_default_types::nlp_numerical_type, 2000, 3000>
+                        >
+                converge_type;
+        typedef optm::first_order::adam<converge_type, nlp_default_types::nlp_numerical_type> optm_type;
+    };
+
+    /// @brief the default settings with the adaptive inner iteration budget. Not the default, as the HPWL is a bit worse on the larger generated netlists of benchInnerBudget
+    struct nlp_adaptive_budget_settings : public nlp_default_settings
+    {
+        typedef nlp_adaptive_budget_first_order_algorithms nlp_first_order_algorithms_type;
+    };
+
 
 }// namespace nlp
 
@@ -174,6 +210,7 @@ class NlpGPlacerBase
         typedef typename nlp_types::nlp_crf_type nlp_crf_type;
         typedef typename nlp_types::nlp_ver_type nlp_ver_type;
         typedef typename nlp_types::nlp_hor_type nlp_hor_type;
+        typedef typename nlp_types::nlp_prox_type nlp_prox_type;
 
 
         /* algorithms */
@@ -197,6 +234,12 @@ class NlpGPlacerBase
     public:
         explicit NlpGPlacerBase(Database &db) : _db(db) {}
         IntType solve();
+        /// @brief set the monitor for reporting the progress and checking the cancellation
+        /// @param the monitor. nullptr to disable
+        void setMonitor(SolveMonitor *monitor) { _monitor = monitor; }
+        /// @brief set the table for recording the optimization state of each iteration
+        /// @param the table. nullptr to disable
+        void setConvergenceTrace(ConvergenceTrace *trace) { _convergenceTrace = trace; }
 
     protected:
         void assignIoPins();
@@ -215,9 +258,17 @@ class NlpGPlacerBase
         void initOptimizationKernelMembers();
         /* Output functions */
         void writeOut();
+        /// @brief report the progress after an outer iteration
+        /// @param the number of finished outer iterations
+        /// @return whether the cancellation has been requested
+        bool reportProgress(IntType outerIter);
         /* Util functions */
         IndexType plIdx(IndexType cellIdx, Orient2DType orient);
         void alignToSym();
+        /// @brief record _multDistance after an update of the multipliers
+        /// @param first: the varied multipliers before the update
+        /// @param second: the varied multipliers after the update
+        void recordMultDistance(const std::vector<nlp_numerical_type> &before, const std::vector<nlp_numerical_type> &after);
         /* construct tasks */
         virtual void constructTasks();
         // Obj-related
@@ -266,6 +317,7 @@ class NlpGPlacerBase
         nlp_numerical_type _objCrfRaw = 0.0; ///< Current flow
         nlp_numerical_type _objVerRaw = 0.0; ///< Vertical constraint
         nlp_numerical_type _objHorRaw = 0.0; ///< Horizontal constraint
+        nlp_numerical_type _multDistance = 0.0; ///< The relative change of the varied multipliers in their last update. Near 0 close to their fixed point, and 0 before the first update
         /* NLP optimization kernel memebers */
         stop_condition_type _stopCondition;
         /* Optimization data */
@@ -311,12 +363,29 @@ class NlpGPlacerBase
         std::vector<nlp_cos_type> _cosOps; ///< The signal flow operators
         std::vector<nlp_power_wl_type> _powerWlOps;
         std::vector<nlp_crf_type> _crfOps; ///< The current flow operators
-        std::vector<nlp_ver_type> _verOps; ///< The vertical constraint operators
-        std::vector<nlp_hor_type> _horOps; ///< The horizontal constraint operators
+        nlp_ver_type _verBatch; ///< The vertical constraints, in one operator
+        nlp_hor_type _horBatch; ///< The horizontal constraints, in one operator
+        std::vector<nlp_prox_type> _proxOps; ///< The proximity group operators. A part of the wirelength objective
         /* run time */
         std::unique_ptr<::klib::StopWatch> _calcObjStopWatch;
+        /* progress */
+        SolveMonitor *_monitor = nullptr; ///< The monitor for reporting the progress. Not owned
+        ConvergenceTrace *_convergenceTrace = nullptr; ///< The record of each iteration. Not owned. nullptr if not recording
 };
 
+template<typename nlp_settings>
+inline void NlpGPlacerBase<nlp_settings>::recordMultDistance(const std::vector<nlp_numerical_type> &before, const std::vector<nlp_numerical_type> &after)
+{
+    nlp_numerical_type diff = 0.0;
+    nlp_numerical_type norm = 0.0;
+    for (IndexType idx = 0; idx < after.size(); ++idx)
+    {
+        diff += (after[idx] - before[idx]) * (after[idx] - before[idx]);
+        norm += after[idx] * after[idx];
+    }
+    _multDistance = norm > 0 ? std::sqrt(diff / norm) : 1.0;
+}
+
 template<typename nlp_settings>
 inline IndexType NlpGPlacerBase<nlp_settings>::plIdx(IndexType cellIdx, Orient2DType orient)
 {
@@ -354,6 +423,7 @@ class NlpGPlacerFirstOrder : public NlpGPlacerBase<nlp_settings>
         typedef typename base_type::nlp_crf_type nlp_crf_type;
         typedef typename base_type::nlp_ver_type nlp_ver_type;
         typedef typename base_type::nlp_hor_type nlp_hor_type;
+        typedef typename base_type::nlp_prox_type nlp_prox_type;
 
         typedef typename nlp_settings::nlp_first_order_algorithms_type nlp_first_order_algorithms;
         typedef typename nlp_first_order_algorithms::converge_type converge_type;
@@ -391,6 +461,10 @@ class NlpGPlacerFirstOrder : public NlpGPlacerBase<nlp_settings>
         template<typename T>
         friend struct nlp::alpha::update::alpha_update_trait;
 
+        /* checkpoint */
+        typedef nlp::checkpoint::gp_checkpoint_trait<NlpGPlacerFirstOrder<nlp_settings>> checkpoint_trait;
+        friend checkpoint_trait;
+
 
         NlpGPlacerFirstOrder(Database &db) : NlpGPlacerBase<nlp_settings>(db) {}
         void writeoutCsv()
@@ -421,6 +495,7 @@ class NlpGPlacerFirstOrder : public NlpGPlacerBase<nlp_settings>
             for (auto &op : this->_asymOps) { op._getLambdaFunc = [&](){ return 1.0; }; }
             for (auto &op : this->_powerWlOps) { op._getLambdaFunc = [&](){ return 1.0; }; }
             for (auto &op : this->_crfOps) { op._getLambdaFunc = [&](){ return 1.0; }; }
+            for (auto &op : this->_proxOps) { op._getLambdaFunc = [&](){ return 1.0; }; }
             for (RealType x = -8; x < 8; x+=(16.0/300))
             {
                 for (RealType y = -8; y < 8; y+=(16.0/300))
@@ -452,6 +527,47 @@ class NlpGPlacerFirstOrder : public NlpGPlacerBase<nlp_settings>
         void constructWrapCalcGradTask();
         /* optimization */
         virtual void optimize() override;
+        /// @brief write the checkpoint if it is the time
+        /// @param first: the number of finished outer iterations
+        /// @param second: whether the global placement has stopped
+        void writeCheckpoint(IntType outerIter, BoolType isFinished, const mult_type &multiplier, const mult_adjust_type &multAdjuster,
+                const alpha_type &alpha, const alpha_update_type &alphaUpdate);
+        /// @brief resume from the checkpoint set in the parameters
+        /// @param first: the number of finished outer iterations in the checkpoint
+        /// @param second: whether the global placement in the checkpoint has stopped
+        /// @return if successful. If not, nothing is changed
+        bool resumeFromCheckpoint(IntType &outerIter, BoolType &isFinished, mult_type &multiplier, mult_adjust_type &multAdjuster,
+                alpha_type &alpha, alpha_update_type &alphaUpdate);
+        /* Convergence trace. The hooks only check a pointer if not recording */
+        /// @brief whether the iterations are being recorded
+        bool isTracingConvergence() const { return this->_convergenceTrace != nullptr; }
+        /// @brief set up the columns of the trace
+        template<typename trace_mult_type, typename trace_alpha_type>
+        void beginConvergenceTrace(const trace_mult_type &multiplier, const trace_alpha_type &alpha);
+        /// @brief record the state at the start of an outer iteration, or the final state. The multipliers and alpha are used by the following inner rows
+        /// @param the number of finished outer iterations
+        template<typename trace_mult_type, typename trace_alpha_type>
+        void traceOuterIteration(IntType outerIter, const trace_mult_type &multiplier, const trace_alpha_type &alpha);
+        /// @brief called by the optimization kernels before a step
+        void traceInnerBegin()
+        {
+            if (isTracingConvergence())
+            {
+                _tracePrevPl = this->_pl;
+            }
+        }
+        /// @brief called by the optimization kernels after a step
+        /// @param the number of steps in the current outer iteration
+        void traceInnerEnd(IndexType innerIter)
+        {
+            if (isTracingConvergence())
+            {
+                this->calcObj();
+                addTraceRow(innerIter, (this->_pl - _tracePrevPl).norm());
+            }
+        }
+        /// @brief add a row with the current objectives and gradient
+        void addTraceRow(IndexType innerIter, RealType stepNorm);
         /* Build the computational graph */
 #ifdef IDEAPLACE_TASKFLOR_FOR_GRAD_OBJ_
         void regCalcHpwlGradTaskFlow(tf::Taskflow &tfFlow);
@@ -485,8 +601,7 @@ class NlpGPlacerFirstOrder : public NlpGPlacerBase<nlp_settings>
         std::vector<nt::Task<nt::CalculateOperatorPartialTask<nlp_cos_type,  EigenVector>>> _calcCosPartialTasks;
         std::vector<nt::Task<nt::CalculateOperatorPartialTask<nlp_power_wl_type,  EigenVector>>> _calcPowerWlPartialTasks;
         std::vector<nt::Task<nt::CalculateOperatorPartialTask<nlp_crf_type,  EigenVector>>> _calcCrfPartialTasks;
-        std::vector<nt::Task<nt::CalculateOperatorPartialTask<nlp_ver_type,  EigenVector>>> _calcVerPartialTasks;
-        std::vector<nt::Task<nt::CalculateOperatorPartialTask<nlp_hor_type,  EigenVector>>> _calcHorPartialTasks;
+        std::vector<nt::Task<nt::CalculateOperatorPartialTask<nlp_prox_type,  EigenVector>>> _calcProxPartialTasks;
         // Update the partials
         std::vector<nt::Task<nt::UpdateGradientFromPartialTask<nlp_hpwl_type, EigenVector>>> _updateHpwlPartialTasks;
         std::vector<nt::Task<nt::UpdateGradientFromPartialTask<nlp_ovl_type,  EigenVector>>> _updateOvlPartialTasks;
@@ -495,8 +610,7 @@ class NlpGPlacerFirstOrder : public NlpGPlacerBase<nlp_settings>
         std::vector<nt::Task<nt::UpdateGradientFromPartialTask<nlp_cos_type,  EigenVector>>> _updateCosPartialTasks;
         std::vector<nt::Task<nt::UpdateGradientFromPartialTask<nlp_power_wl_type,  EigenVector>>> _updatePowerWlPartialTasks;
         std::vector<nt::Task<nt::UpdateGradientFromPartialTask<nlp_crf_type,  EigenVector>>> _updateCrfPartialTasks;
-        std::vector<nt::Task<nt::UpdateGradientFromPartialTask<nlp_ver_type,  EigenVector>>> _updateVerPartialTasks;
-        std::vector<nt::Task<nt::UpdateGradientFromPartialTask<nlp_hor_type,  EigenVector>>> _updateHorPartialTasks;
+        std::vector<nt::Task<nt::UpdateGradientFromPartialTask<nlp_prox_type,  EigenVector>>> _updateProxPartialTasks; ///< Into the hpwl gradient
         // Clear the gradient. Use to clear the _gradxxx records. Needs to call before updating the partials
         nt::Task<nt::FuncTask> _clearGradTask; //FIXME: not used right one
         nt::Task<nt::FuncTask> _clearHpwlGradTask;
@@ -517,13 +631,18 @@ class NlpGPlacerFirstOrder : public NlpGPlacerBase<nlp_settings>
         nt::Task<nt::FuncTask> _sumCosGradTask;
         nt::Task<nt::FuncTask> _sumPowerWlTaskGradTask;
         nt::Task<nt::FuncTask> _sumCrfGradTask;
-        nt::Task<nt::FuncTask> _sumVerGradTask;
-        nt::Task<nt::FuncTask> _sumHorGradTask;
+        nt::Task<nt::FuncTask> _sumVerGradTask; ///< Calculate the gradient of the vertical constraints into _gradVer
+        nt::Task<nt::FuncTask> _sumHorGradTask; ///< Calculate the gradient of the horizontal constraints into _gradHor
         // all the grads has been calculated but have not updated
         nt::Task<nt::FuncTask> _wrapCalcGradTask; ///<  calculating the gradient and sum them
         /* run time */
         std::unique_ptr<::klib::StopWatch> _calcGradStopWatch;
         std::unique_ptr<::klib::StopWatch> _optimizerKernelStopWatch;
+        /* convergence trace */
+        IntType _traceOuterIter = 0; ///< The outer iteration of the following inner rows
+        std::vector<RealType> _traceParams; ///< The multipliers and alpha of the following inner rows
+        std::vector<RealType> _traceRow; ///< The buffer of a row
+        EigenVector _tracePrevPl; ///< The solution before the current step
 };
 
 
@@ -534,18 +653,26 @@ namespace _nlp_second_order_details
     template<typename nlp_settings, BoolType is_diagonal>
     struct is_diagonal_select {};
 
+    /// @brief a diagonal hessian is stored as the vector of its diagonal
     template<typename nlp_settings>
     struct is_diagonal_select<nlp_settings, true>
     {
-        typedef typename nlp_settings::nlp_types_type::EigenMatrix matrix_type;
+        typedef typename nlp_settings::nlp_types_type::EigenVector matrix_type;
+        static constexpr BoolType isDiagonal = true;
         static void resize(matrix_type &matrix, IntType size)
         {
-            matrix.resize(size, size);
+            matrix.resize(size);
         }
 
         static decltype(auto) inverse(matrix_type &matrix)
         {
-            return matrix.diagonal().cwiseInverse().asDiagonal();
+            return matrix.cwiseInverse().asDiagonal();
+        }
+        /// @brief add the hessian of some operators. They are diagonal as well
+        template<typename other_type>
+        static void accumulate(matrix_type &matrix, const other_type &other)
+        {
+            matrix += other;
         }
     };
 
@@ -553,6 +680,7 @@ namespace _nlp_second_order_details
     struct is_diagonal_select<nlp_settings, false>
     {
         typedef typename nlp_settings::nlp_types_type::EigenMatrix matrix_type;
+        static constexpr BoolType isDiagonal = false;
         static void resize(matrix_type &matrix, IntType size)
         {
             matrix.resize(size, size);
@@ -562,6 +690,19 @@ namespace _nlp_second_order_details
             Assert(false);
             return matrix.diagonal().cwiseInverse();
         }
+        /// @brief add the hessian of some operators, either a full matrix or a diagonal vector
+        template<typename other_type>
+        static void accumulate(matrix_type &matrix, const other_type &other)
+        {
+            if constexpr (other_type::ColsAtCompileTime == 1)
+            {
+                matrix.diagonal() += other;
+            }
+            else
+            {
+                matrix += other;
+            }
+        }
     };
 
     template<typename hessian_target_type>
@@ -592,6 +733,7 @@ class NlpGPlacerSecondOrder : public NlpGPlacerFirstOrder<nlp_settings>
         typedef typename first_order_type::nlp_asym_type nlp_asym_type;
         typedef typename first_order_type::nlp_cos_type nlp_cos_type;
         typedef typename first_order_type::nlp_power_wl_type nlp_power_wl_type;
+        typedef typename first_order_type::nlp_prox_type nlp_prox_type;
         
         typedef typename second_order_setting_type::hpwl_hessian_trait hpwl_hessian_trait;
         typedef typename second_order_setting_type::ovl_hessian_trait ovl_hessian_trait;
@@ -599,10 +741,13 @@ class NlpGPlacerSecondOrder : public NlpGPlacerFirstOrder<nlp_settings>
         typedef typename second_order_setting_type::asym_hessian_trait asym_hessian_trait;
         typedef typename second_order_setting_type::cos_hessian_trait cos_hessian_trait;
         typedef typename second_order_setting_type::power_wl_hessian_trait power_wl_hessian_trait;
+        typedef typename second_order_setting_type::prox_hessian_trait prox_hessian_trait;
 
         /* figure out the types for storing the hessian */
         // Determine whether the operators are return a diagonal hessian
-        constexpr static BoolType isHpwlHessianDiagonal = diff::is_diagnol_matrix<hpwl_hessian_trait>::value;
+        // The proximity groups are added to the hpwl hessian
+        constexpr static BoolType isHpwlHessianDiagonal = diff::is_diagnol_matrix<hpwl_hessian_trait>::value
+                and diff::is_diagnol_matrix<prox_hessian_trait>::value;
         constexpr static BoolType isOvlHessianDiagonal = diff::is_diagnol_matrix<ovl_hessian_trait>::value;
         constexpr static BoolType isOobHessianDiagonal = diff::is_diagnol_matrix<oob_hessian_trait>::value;
         constexpr static BoolType isAsymHessianDiagonal = diff::is_diagnol_matrix<asym_hessian_trait>::value;
@@ -725,27 +870,37 @@ class NlpGPlacerSecondOrder : public NlpGPlacerFirstOrder<nlp_settings>
             alpha_update_type alphaUpdate = alpha_update_trait::construct(*this, alpha);
             alpha_update_trait::init(*this, alpha, alphaUpdate);
             DBG("np \n");
-            std::cout<<"nlp address " <<this <<std::endl;
+            DBG("nlp address %p \n", static_cast<void *>(this));
 
             IntType iter = 0;
+            this->beginConvergenceTrace(multiplier, alpha);
             do
             {
+                this->traceOuterIteration(iter, multiplier, alpha);
                 std::string debugGdsFilename  = "./debug/";
                 debugGdsFilename += "gp_iter_" + std::to_string(iter)+".gds";
                 DBG("iter %d \n", iter);
                 optm_trait::optimize(*this, optm);
+                const auto multsBefore = multiplier._variedMults;
                 mult_trait::update(*this, multiplier);
                 mult_trait::recordRaw(*this, multiplier);
                 mult_adjust_trait::update(*this, multiplier, multAdjuster);
+                this->recordMultDistance(multsBefore, multiplier._variedMults);
 
                 alpha_update_trait::update(*this, alpha, alphaUpdate);
                 this->assignIoPins();
                 DBG("obj %f hpwl %f ovl %f oob %f asym %f cos %f \n", this->_obj, this->_objHpwl, this->_objOvl, this->_objOob, this->_objAsym, this->_objCos);
                 ++iter;
+                if (this->reportProgress(iter))
+                {
+                    WRN("Second order NLP: cancelled after outer iteration %d \n", iter);
+                    break;
+                }
             } while (not base_type::stop_condition_trait::stopPlaceCondition(*this, this->_stopCondition));
+            this->traceOuterIteration(iter, multiplier, alpha);
             auto end = WATCH_QUICK_END();
             //std::cout<<"grad"<<"\n"<< _grad <<std::endl;
-            std::cout<<"time "<< end / 1000 <<" ms" <<std::endl;
+            INF("Second order NLP: time %lu ms \n", end / 1000);
             this->writeOut();
         }
         private:
@@ -757,6 +912,7 @@ class NlpGPlacerSecondOrder : public NlpGPlacerFirstOrder<nlp_settings>
             using asym = nt::CalculateOperatorHessianTask<nlp_asym_type, asym_hessian_trait, EigenMatrix, asym_hessian_matrix>;
             using cos = nt::CalculateOperatorHessianTask<nlp_cos_type, cos_hessian_trait, EigenMatrix, cos_hessian_matrix>;
             using pwl = nt::CalculateOperatorHessianTask<nlp_power_wl_type, power_wl_hessian_trait, EigenMatrix, power_wl_hessian_matrix>;
+            using prox = nt::CalculateOperatorHessianTask<nlp_prox_type, prox_hessian_trait, EigenMatrix, hpwl_hessian_matrix>;
             auto getIdxFunc = [&](IndexType cellIdx, Orient2DType orient) { return this->plIdx(cellIdx, orient); }; // wrapper the convert cell idx to pl idx
             for (IndexType i = 0; i < this->_hpwlOps.size(); ++i)
             {
@@ -782,6 +938,10 @@ class NlpGPlacerSecondOrder : public NlpGPlacerFirstOrder<nlp_settings>
             {
                 _calcPowerWlHessianTasks.emplace_back(pwl(&op, &_hessianPowerWl, getIdxFunc));
             }
+            for (auto &op : this->_proxOps)
+            {
+                _calcProxHessianTasks.emplace_back(prox(&op, &_hessianHpwl, getIdxFunc));
+            }
         }
         void _clearHessian()
         {
@@ -793,52 +953,60 @@ class NlpGPlacerSecondOrder : public NlpGPlacerFirstOrder<nlp_settings>
             _hessianCos.setZero();
             _hessianPowerWl.setZero();
         }
-        void _calcAllHessians()
-        {
-            #pragma omp parallel for schedule(static)
-            for (IndexType i = 0; i < _calcHpwlHessianTasks.size(); ++i) { _calcHpwlHessianTasks[i].calc(); }
-            #pragma omp parallel for schedule(static)
-            for (IndexType i = 0; i < _calcOvlHessianTasks.size(); ++i) { _calcOvlHessianTasks[i].calc(); }
-            #pragma omp parallel for schedule(static)
-            for (IndexType i = 0; i < _calcOobHessianTasks.size(); ++i) { _calcOobHessianTasks[i].calc(); }
-            #pragma omp parallel for schedule(static)
-            for (IndexType i = 0; i < _calcAsymHessianTasks.size(); ++i) { _calcAsymHessianTasks[i].calc(); }
-            #pragma omp parallel for schedule(static)
-            for (IndexType i = 0; i < _calcCosHessianTasks.size(); ++i) { _calcCosHessianTasks[i].calc(); }
-            #pragma omp parallel for schedule(static)
-            for (IndexType i = 0; i < _calcPowerWlHessianTasks.size(); ++i) { _calcPowerWlHessianTasks[i].calc(); }
-        }
-        void _updateAllHessian()
+        /// @brief calculate the hessians of the operators of a kind into their target.
+        /// A diagonal is accumulated into a vector per thread while the operators are calculated, and the vectors are then added.
+        /// A full matrix is updated by the operators in order after they are all calculated
+        template<typename selector_type, typename task_type>
+        void _calcOperatorHessians(std::vector<task_type> &tasks, typename selector_type::matrix_type &target)
         {
-            #pragma omp parallel for schedule(static)
-            for (IndexType i = 0; i < 6; ++i)
+            if constexpr (selector_type::isDiagonal)
             {
-                if (i == 0)
-                {
-                    for (auto & calc : _calcHpwlHessianTasks) { calc.update(); }
-                }
-                else if (i == 1)
-                {
-                    for (auto & calc : _calcOvlHessianTasks) { calc.update(); }
-                }
-                else if (i == 2)
-                {
-                    for (auto & calc : _calcOobHessianTasks) { calc.update(); }
-                }
-                else if (i == 3)
+                _threadHessians.resize(omp_get_max_threads());
+                for (auto &threadHessian : _threadHessians)
                 {
-                    for (auto & calc : _calcAsymHessianTasks) { calc.update(); }
+                    threadHessian.resize(this->_numVariables);
+                    threadHessian.setZero();
                 }
-                else if (i == 4)
+                #pragma omp parallel
                 {
-                    for (auto & calc : _calcCosHessianTasks) { calc.update(); }
+                    auto &threadHessian = _threadHessians[omp_get_thread_num()];
+                    #pragma omp for schedule(static)
+                    for (IndexType i = 0; i < tasks.size(); ++i)
+                    {
+                        tasks[i].calc();
+                        tasks[i].update(threadHessian);
+                    }
                 }
-                else
+                for (const auto &threadHessian : _threadHessians)
                 {
-                    for (auto & calc : _calcPowerWlHessianTasks) { calc.update(); }
+                    target += threadHessian;
                 }
             }
-            _hessian = _hessianHpwl + _hessianOvl + _hessianOob + _hessianAsym + _hessianCos + _hessianPowerWl;
+            else
+            {
+                #pragma omp parallel for schedule(static)
+                for (IndexType i = 0; i < tasks.size(); ++i) { tasks[i].calc(); }
+                for (auto & calc : tasks) { calc.update(); }
+            }
+        }
+        void _calcAllHessians()
+        {
+            _calcOperatorHessians<hpwl_hessian_diagonal_selector>(_calcHpwlHessianTasks, _hessianHpwl);
+            _calcOperatorHessians<hpwl_hessian_diagonal_selector>(_calcProxHessianTasks, _hessianHpwl);
+            _calcOperatorHessians<ovl_hessian_diagonal_selector>(_calcOvlHessianTasks, _hessianOvl);
+            _calcOperatorHessians<oob_hessian_diagonal_selector>(_calcOobHessianTasks, _hessianOob);
+            _calcOperatorHessians<asym_hessian_diagonal_selector>(_calcAsymHessianTasks, _hessianAsym);
+            _calcOperatorHessians<cos_hessian_diagonal_selector>(_calcCosHessianTasks, _hessianCos);
+            _calcOperatorHessians<power_wl_hessian_diagonal_selector>(_calcPowerWlHessianTasks, _hessianPowerWl);
+        }
+        void _updateAllHessian()
+        {
+            hessian_diagonal_selector::accumulate(_hessian, _hessianHpwl);
+            hessian_diagonal_selector::accumulate(_hessian, _hessianOvl);
+            hessian_diagonal_selector::accumulate(_hessian, _hessianOob);
+            hessian_diagonal_selector::accumulate(_hessian, _hessianAsym);
+            hessian_diagonal_selector::accumulate(_hessian, _hessianCos);
+            hessian_diagonal_selector::accumulate(_hessian, _hessianPowerWl);
         }
 
         void clipHessian()
@@ -860,6 +1028,7 @@ class NlpGPlacerSecondOrder : public NlpGPlacerFirstOrder<nlp_settings>
         asym_hessian_matrix _hessianAsym; ///< The hessian for the asymmetry function
         cos_hessian_matrix _hessianCos; ///< The hessian for the signal path function
         power_wl_hessian_matrix _hessianPowerWl;
+        std::vector<typename first_order_type::EigenVector> _threadHessians; ///< The diagonal hessian accumulated by each thread
         /* Tasks */
         std::vector<nt::CalculateOperatorHessianTask<nlp_hpwl_type, hpwl_hessian_trait, EigenMatrix, hpwl_hessian_matrix>> _calcHpwlHessianTasks; ///< calculate and update the hessian
         std::vector<nt::CalculateOperatorHessianTask<nlp_ovl_type, ovl_hessian_trait, EigenMatrix, ovl_hessian_matrix>> _calcOvlHessianTasks; ///< calculate and update the hessian
@@ -867,6 +1036,7 @@ class NlpGPlacerSecondOrder : public NlpGPlacerFirstOrder<nlp_settings>
         std::vector<nt::CalculateOperatorHessianTask<nlp_asym_type, asym_hessian_trait, EigenMatrix, asym_hessian_matrix>> _calcAsymHessianTasks; ///< calculate and update the hessian
         std::vector<nt::CalculateOperatorHessianTask<nlp_cos_type, cos_hessian_trait, EigenMatrix, cos_hessian_matrix>> _calcCosHessianTasks; ///< calculate and update the hessian
         std::vector<nt::CalculateOperatorHessianTask<nlp_power_wl_type, power_wl_hessian_trait, EigenMatrix, power_wl_hessian_matrix>> _calcPowerWlHessianTasks; ///< calculate and update the hessian
+        std::vector<nt::CalculateOperatorHessianTask<nlp_prox_type, prox_hessian_trait, EigenMatrix, hpwl_hessian_matrix>> _calcProxHessianTasks; ///< calculate and update the hpwl hessian
 
 
 };
@@ -883,6 +1053,7 @@ inline void NlpGPlacerSecondOrder<nlp_settings>::initSecondOrder()
     asym_hessian_diagonal_selector::resize(_hessianAsym, size);
     cos_hessian_diagonal_selector::resize(_hessianCos, size);
     power_wl_hessian_diagonal_selector::resize(_hessianPowerWl , size);
+    hessian_diagonal_selector::resize(_hessian, size);
 }
 
 
@@ -0,0 +1,113 @@
+/**
+ * @file SolveMonitor.h
+ * @brief Progress reporting and cooperative cancellation of the placement flow
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_SOLVE_MONITOR_H_
+#define IDEAPLACE_SOLVE_MONITOR_H_
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include "global/global.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief the stages of the placement flow
+enum class SolveStageType
+{
+    NOT_STARTED = 0,
+    GLOBAL_PLACEMENT = 1,
+    LEGALIZATION = 2,
+    DETAILED_PLACEMENT = 3,
+    PIN_ASSIGNMENT = 4,
+    FINISHED = 5,
+    CANCELLED = 6
+};
+
+/// @brief a progress event of the placement flow
+struct SolveProgress
+{
+    SolveStageType stage = SolveStageType::NOT_STARTED; ///< The current stage
+    IntType outerIter = 0; ///< The number of finished outer iterations of the global placement
+    RealType obj = 0.0; ///< The total objective of the global placement
+    RealType objHpwl = 0.0; ///< The wirelength objective
+    RealType objOvl = 0.0; ///< The overlapping penalty
+    RealType objOob = 0.0; ///< The out of boundary penalty
+    RealType objAsym = 0.0; ///< The asymmetry penalty
+    RealType objCos = 0.0; ///< The signal path penalty
+    RealType objPowerWl = 0.0; ///< The power wirelength
+    RealType objCrf = 0.0; ///< The current flow penalty
+};
+
+/// @class IDEAPLACE::SolveMonitor
+/// @brief shared between the thread running the placement and the threads observing it.
+/// The placement reports its progress at the stage boundaries and after each outer iteration, and checks the cancellation flag at the same places
+class SolveMonitor
+{
+    public:
+        typedef std::function<void(const SolveProgress &)> callback_type;
+        /// @brief default constructor
+        explicit SolveMonitor() = default;
+        /// @brief set the callback for the progress events. It is called from the thread running the placement
+        /// @param the callback. Empty to remove
+        void setCallback(callback_type callback)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _callback = std::move(callback);
+        }
+        /// @brief request the placement to stop at the next check
+        void cancel() { _cancelRequested.store(true, std::memory_order_relaxed); }
+        /// @brief whether the cancellation has been requested
+        bool isCancelRequested() const { return _cancelRequested.load(std::memory_order_relaxed); }
+        /// @brief clear the progress and the cancellation before a new run. The callback is kept
+        void reset()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _progress = SolveProgress();
+            _cancelRequested.store(false, std::memory_order_relaxed);
+        }
+        /// @brief the latest progress event
+        SolveProgress progress() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _progress;
+        }
+        /// @brief report a progress event
+        /// @param the progress event
+        /// @return whether the cancellation has been requested
+        bool report(const SolveProgress &progress)
+        {
+            callback_type callback;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _progress = progress;
+                callback = _callback;
+            }
+            // Call outside the lock, so that the callback can query or cancel
+            if (callback)
+            {
+                callback(progress);
+            }
+            return isCancelRequested();
+        }
+        /// @brief report entering a stage. The statistics of the global placement are kept
+        /// @param the stage
+        /// @return whether the cancellation has been requested
+        bool reportStage(SolveStageType stage)
+        {
+            auto current = progress();
+            current.stage = stage;
+            return report(current);
+        }
+    private:
+        mutable std::mutex _mutex; ///< Protecting the progress and the callback
+        std::atomic<bool> _cancelRequested{false}; ///< Whether the cancellation has been requested
+        SolveProgress _progress; ///< The latest progress
+        callback_type _callback; ///< The callback for the progress events
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //IDEAPLACE_SOLVE_MONITOR_H_
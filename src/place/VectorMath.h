@@ -0,0 +1,26 @@
+/**
+ * @file VectorMath.h
+ * @brief Let the loops calling exp and log1p vectorize with the vector math of glibc (libmvec)
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_VECTOR_MATH_H_
+#define IDEAPLACE_VECTOR_MATH_H_
+
+#include <cmath>
+#include "global/define.h"
+
+/* glibc declares the vector variants of its math only with -ffast-math. The declarations below add them for exp and log1p,
+ * so that each clone of a loop calls the variant of its width. The loops vectorize only with -fno-math-errno.
+ * They change the declarations of the C library for the whole translation unit, so include this header only in the ones instantiating the placement operators,
+ * after place/different.h. GCC generates the code of the templates at the end of the translation unit, so they see the attributes */
+
+#if defined(IDEAPLACE_CPU_DISPATCH) && defined(__x86_64__) && defined(__GLIBC__) && defined(__GNUC__) && !defined(__clang__) && !defined(__FAST_MATH__)
+extern "C"
+{
+    __attribute__((simd("notinbranch"))) double exp(double) noexcept;
+    __attribute__((simd("notinbranch"))) double log1p(double) noexcept;
+}
+#endif
+
+#endif // IDEAPLACE_VECTOR_MATH_H_
@@ -79,6 +79,25 @@ namespace op
         return exp( var / alpha ) / ( exp( var / alpha) + 1);
     }
 
+    /// @brief log(exp(var) + 1) without overflow. The exponent is never positive
+    /// @param first: var
+    /// @param second: exp(-|var|), shared with sigmoid()
+    template<typename NumType>
+    inline NumType softplus(NumType var, NumType expNegAbs)
+    {
+        return std::max(var, NumType(0)) + std::log1p(expNegAbs);
+    }
+
+    /// @brief exp(var) / (exp(var) + 1), the derivative of softplus(), without overflow. Without branches, so that a loop of it vectorizes
+    /// @param first: var
+    /// @param second: exp(-|var|), shared with softplus()
+    template<typename NumType>
+    inline NumType sigmoid(NumType var, NumType expNegAbs)
+    {
+        const NumType nonNeg = var >= 0;
+        return (expNegAbs + nonNeg * (1 - expNegAbs)) / (1 + expNegAbs);
+    }
+
     namespace _conv_details
     {
         template<typename, typename, bool>
@@ -110,7 +129,102 @@ namespace op
 };
 
 
+namespace _lse_details
+{
+    /// @brief exp(loc / alpha) of the locations, and their in-order sums in each quarter, so that the sums do not change with the instruction set
+    /// @param first: the x, y, -x and -y of the pins
+    /// @param second: the number of the pins
+    /// @param third: alpha
+    /// @param fourth: the output of exp(loc / alpha)
+    /// @param fifth: the output of the sums: xmax ymax xmin ymin
+    template<typename NumType>
+    inline void expSums(const NumType *loc, IndexType numPins, NumType alpha, NumType *exps, NumType *sums)
+    {
+        for (IndexType idx = 0; idx < 4 * numPins; ++idx)
+        {
+            exps[idx] = std::exp(loc[idx] / alpha);
+        }
+        for (IndexType quarter = 0; quarter < 4; ++quarter)
+        {
+            const NumType *quarterExps = exps + quarter * numPins;
+            NumType sum = 0;
+            for (IndexType idx = 0; idx < numPins; ++idx)
+            {
+                sum += quarterExps[idx];
+            }
+            sums[quarter] = sum;
+        }
+    }
+
+    /// @brief the sum of log(sum(exp(loc / alpha))) of the quarters
+    /// @param first: the x, y, -x and -y of the pins
+    /// @param second: the number of the pins
+    /// @param third: alpha
+    /// @param fourth: a buffer of the size of the locations
+    template<typename NumType>
+    IDEAPLACE_MULTIVERSION NumType logSumExp(const NumType *loc, IndexType numPins, NumType alpha, NumType *buf)
+    {
+        std::array<NumType, 4> sums;
+        expSums(loc, numPins, alpha, buf, sums.data());
+        // xmax xmin ymax ymin
+        return log(sums[0]) + log(sums[2]) + log(sums[1]) + log(sums[3]);
+    }
+
+    /// @brief overwrite the x and the y of the variables with the partials scale * (exp(loc / alpha) / sum(exp(loc / alpha)) - exp(-loc / alpha) / sum(exp(-loc / alpha)))
+    /// @param first: the x, y, -x and -y of the pins
+    /// @param second: the number of the pins
+    /// @param third: the number of the leading pins in each quarter that are variables
+    /// @param fourth: alpha
+    /// @param fifth: scale
+    /// @param sixth: a buffer of the size of the locations
+    template<typename NumType>
+    IDEAPLACE_MULTIVERSION void partials(NumType *loc, IndexType numPins, IndexType numVars, NumType alpha, NumType scale, NumType *buf)
+    {
+        std::array<NumType, 4> sums;
+        expSums(loc, numPins, alpha, buf, sums.data());
+        // avoid overflow
+        for (IndexType i = 0; i < 4; ++i)
+        {
+            sums[i] = std::max(sums[i], op::conv<NumType>(1e-8));
+        }
+        for (IndexType dim = 0; dim < 2; ++dim)
+        {
+            const NumType *expPos = buf + dim * numPins;
+            const NumType *expNeg = buf + (dim + 2) * numPins;
+            const NumType posSum = sums[dim];
+            const NumType negSum = sums[dim + 2];
+            NumType *partial = loc + dim * numPins;
+            for (IndexType idx = 0; idx < numVars; ++idx)
+            {
+                partial[idx] = scale * ((expPos[idx] / posSum) - (expNeg[idx] / negSum));
+            }
+        }
+    }
+
+    /// @brief the buffers of a thread. The operators are evaluated concurrently, so the buffers are not kept in them
+    template<typename NumType>
+    struct Buffers
+    {
+        std::vector<NumType> loc; ///< The x, y, -x and -y of the pins. The partials overwrite x and y
+        std::vector<NumType> exps; ///< The exp results
+
+        /// @brief the buffers of this thread, with at least the room of the pins
+        static Buffers &local(IndexType numPins)
+        {
+            static thread_local Buffers buffers;
+            if (buffers.loc.size() < 4 * numPins)
+            {
+                buffers.loc.resize(4 * numPins);
+                buffers.exps.resize(4 * numPins);
+            }
+            return buffers;
+        }
+    };
+} // namespace _lse_details
+
 /// @brief LSE-smoothed HPWL
+/// Each pass gathers the pin locations through the callback into the buffers of the thread, runs a flat kernel of _lse_details on them, then scatters the partials through the callback.
+/// With -fno-math-errno and place/VectorMath.h in the translation unit, the exp loop of the kernels vectorizes and calls the vector exp of libmvec
 template<typename NumType, typename CoordType>
 struct LseHpwlDifferentiable
 {
@@ -148,35 +262,10 @@ struct LseHpwlDifferentiable
         {
             return 0;
         }
-        std::array<NumType, 4> max_val = { 0, 0, 0, 0}; // xmax xin ymax ymin
         auto alpha = _getAlphaFunc();
         auto lambda = _getLambdaFunc();
-        NumType *pMax = &max_val.front(); 
-        for (IndexType pinIdx = 0; pinIdx < _cells.size(); ++pinIdx)
-        {
-            NumType x = op::conv<NumType>(
-                    _getVarFunc(_cells[pinIdx], Orient2DType::HORIZONTAL) + _offsetX[pinIdx]
-                    );
-            NumType y = op::conv<NumType>(
-                    _getVarFunc(_cells[pinIdx], Orient2DType::VERTICAL) + _offsetY[pinIdx]
-                    );
-            pMax[0] += exp(x / alpha);
-            pMax[1] += exp(- x / alpha);
-            pMax[2] += exp(y / alpha);
-            pMax[3] += exp(- y / alpha);
-        }
-        if (_validVirtualPin == 1)
-        {
-            pMax[0] += exp(_virtualPinX / alpha);
-            pMax[1] += exp(- _virtualPinX / alpha);
-            pMax[2] += exp(_virtualPinY / alpha);
-            pMax[3] += exp(- _virtualPinY / alpha);
-        }
-        NumType obj = 0;
-        for (int i = 0; i < 4; ++ i)
-        {
-            obj += log(pMax[i]);
-        }
+        auto &buf = gatherPins();
+        NumType obj = _lse_details::logSumExp(buf.loc.data(), numPins(), alpha, buf.exps.data());
         return alpha * obj * _weight * lambda;
     }
 
@@ -186,49 +275,195 @@ struct LseHpwlDifferentiable
         {
             return;
         }
-        std::array<NumType, 4> max_val = { 0, 0, 0, 0}; // xmax xin ymax ymin
         auto alpha = _getAlphaFunc();
         auto lambda = _getLambdaFunc();
-        NumType *pMax = &max_val.front(); 
-        std::vector<std::array<NumType, 4>> exp_results(_cells.size());
+        auto &buf = gatherPins();
+        // The virtual pin is not a variable
+        _lse_details::partials(buf.loc.data(), numPins(), _cells.size(), alpha, lambda * _weight, buf.exps.data());
+        const NumType *xPartial = buf.loc.data();
+        const NumType *yPartial = xPartial + numPins();
         for (IndexType pinIdx = 0; pinIdx < _cells.size(); ++pinIdx)
         {
-            NumType x = op::conv<NumType>(
+            IndexType cellIdx = _cells[pinIdx];
+            _accumulateGradFunc(xPartial[pinIdx], cellIdx, Orient2DType::HORIZONTAL);
+            _accumulateGradFunc(yPartial[pinIdx], cellIdx, Orient2DType::VERTICAL);
+        }
+    }
+
+    /// @brief the number of the pins, including the virtual pin
+    IndexType numPins() const { return _cells.size() + _validVirtualPin; }
+
+    /// @brief fill the buffers of the thread with the x, y, -x and -y of the pins, each with the virtual pin last
+    /// @return the buffers of the thread
+    _lse_details::Buffers<NumType> &gatherPins() const
+    {
+        const IndexType numLocs = numPins();
+        auto &buf = _lse_details::Buffers<NumType>::local(numLocs);
+        NumType *x = buf.loc.data();
+        NumType *y = x + numLocs;
+        for (IndexType pinIdx = 0; pinIdx < _cells.size(); ++pinIdx)
+        {
+            x[pinIdx] = op::conv<NumType>(
                     _getVarFunc(_cells[pinIdx], Orient2DType::HORIZONTAL) + _offsetX[pinIdx]
                     );
-            NumType y = op::conv<NumType>(
+            y[pinIdx] = op::conv<NumType>(
                     _getVarFunc(_cells[pinIdx], Orient2DType::VERTICAL) + _offsetY[pinIdx]
                     );
-            exp_results[pinIdx][0] = exp(x / alpha);
-            pMax[0] += exp_results[pinIdx][0];
-            exp_results[pinIdx][1] = exp(- x / alpha);
-            pMax[1] += exp_results[pinIdx][1];
-            exp_results[pinIdx][2] = exp( y / alpha);
-            pMax[2] += exp_results[pinIdx][2];
-            exp_results[pinIdx][3] = exp(- y / alpha);
-            pMax[3] += exp_results[pinIdx][3];
         }
         if (_validVirtualPin == 1)
         {
-            pMax[0] += exp(_virtualPinX / alpha);
-            pMax[1] += exp(- _virtualPinX / alpha);
-            pMax[2] += exp(_virtualPinY / alpha);
-            pMax[3] += exp(- _virtualPinY / alpha);
+            x[_cells.size()] = op::conv<NumType>(_virtualPinX);
+            y[_cells.size()] = op::conv<NumType>(_virtualPinY);
         }
-        // avoid overflow
-        for (IndexType i =0; i < 4; ++i)
+        NumType *neg = y + numLocs;
+        for (IndexType idx = 0; idx < 2 * numLocs; ++idx)
         {
-            pMax[i] = std::max(pMax[i], op::conv<NumType>(1e-8));
+            neg[idx] = - x[idx];
         }
+        return buf;
+    }
+
+    IntType _validVirtualPin = 0;
+    CoordType _virtualPinX = 0;
+    CoordType _virtualPinY = 0;
+    std::vector<IndexType> _cells;
+    std::vector<CoordType> _offsetX;
+    std::vector<CoordType> _offsetY;
+    NumType _weight = 1;
+    std::function<NumType(void)> _getAlphaFunc; ///< A function to get the current alpha
+    std::function<NumType(void)> _getLambdaFunc; ///< A function to get the current lambda multiplier
+    std::function<CoordType(IndexType cellIdx, Orient2DType orient)> _getVarFunc; ///< A function to get current variable value
+    std::function<void(NumType, IndexType, Orient2DType)> _accumulateGradFunc; ///< A function to update partial
+};
+
+
+template <typename NumType, typename CoordType>
+struct is_placement_differentiable_concept<LseHpwlDifferentiable<NumType, CoordType>>
+{
+    typedef std::true_type  is_placement_differentiable_concept_type;
+};
+
+/// @brief weighted-average (WA) smoothed HPWL. The span of a net in a direction is the exp(x / alpha) weighted average of the pin coordinates minus the exp(-x / alpha) weighted one.
+/// It underestimates the span by less than LSE overestimates it with the same alpha, so alpha does not need to be as small. Same interface as LseHpwlDifferentiable
+template<typename NumType, typename CoordType>
+struct WaHpwlDifferentiable
+{
+    typedef NumType numerical_type;
+    typedef CoordType coordinate_type;
+
+    /// @brief the two weighted averages of the coordinates of a direction. The exponents are shifted by the extreme coordinates, which cancels in the averages
+    struct wa_stats_type
+    {
+        NumType hi = 0; ///< The maximum coordinate
+        NumType lo = 0; ///< The minimum coordinate
+        NumType sumMax = 0; ///< sum(exp((x - hi) / alpha))
+        NumType sumMin = 0; ///< sum(exp((lo - x) / alpha))
+        NumType avgMax = 0; ///< The smoothed maximum: sum(x * exp((x - hi) / alpha)) / sumMax
+        NumType avgMin = 0; ///< The smoothed minimum: sum(x * exp((lo - x) / alpha)) / sumMin
+    };
+
+    WaHpwlDifferentiable(const std::function<NumType(void)> &getAlphaFunc, const std::function<NumType(void)> &getLambdaFunc)
+    { _getAlphaFunc = getAlphaFunc; _getLambdaFunc = getLambdaFunc; }
+
+    void setGetVarFunc(const std::function<CoordType(IndexType, Orient2DType)> &getVarFunc) { _getVarFunc = getVarFunc; }
+    void setAccumulateGradFunc(const std::function<void(NumType, IndexType, Orient2DType)> &func) { _accumulateGradFunc = func; }
+    void setGetAlphaFunc(const std::function<NumType(void)> &getAlphaFunc) { _getAlphaFunc = getAlphaFunc; }
+
+    void setVirtualPin(const CoordType &x, const CoordType &y)
+    {
+        _validVirtualPin = 1;
+        _virtualPinX = x;
+        _virtualPinY = y;
+    }
+    void removeVirtualPin() { _validVirtualPin = 0; }
+    void addVar(IndexType cellIdx, const CoordType &offsetX, const CoordType &offsetY)
+    {
+        _cells.emplace_back(cellIdx);
+        _offsetX.emplace_back(offsetX);
+        _offsetY.emplace_back(offsetY);
+    }
+    void setWeight(const NumType &weight) { _weight = weight; }
+    bool validHpwl() const { return _cells.size() + _validVirtualPin > 1;}
+
+    /// @brief the coordinates of the pins in a direction. The virtual pin, if any, is the last
+    void pinLocs(Orient2DType orient, std::vector<NumType> &locs) const
+    {
+        const bool isHor = orient == Orient2DType::HORIZONTAL;
+        locs.resize(_cells.size() + _validVirtualPin);
         for (IndexType pinIdx = 0; pinIdx < _cells.size(); ++pinIdx)
         {
-            IndexType cellIdx = _cells[pinIdx];
-            NumType xPartial = lambda * _weight;
-            NumType yPartial = xPartial;
-            xPartial *= (exp_results[pinIdx][0] / pMax[0]) - (exp_results[pinIdx][1] / pMax[1]);
-            yPartial *= (exp_results[pinIdx][2] / pMax[2]) - (exp_results[pinIdx][3] / pMax[3]);
-            _accumulateGradFunc(xPartial, cellIdx, Orient2DType::HORIZONTAL);
-            _accumulateGradFunc(yPartial, cellIdx, Orient2DType::VERTICAL);
+            locs[pinIdx] = op::conv<NumType>(_getVarFunc(_cells[pinIdx], orient) + (isHor ? _offsetX[pinIdx] : _offsetY[pinIdx]));
+        }
+        if (_validVirtualPin == 1)
+        {
+            locs.back() = op::conv<NumType>(isHor ? _virtualPinX : _virtualPinY);
+        }
+    }
+
+    static wa_stats_type waStats(const std::vector<NumType> &locs, NumType alpha)
+    {
+        wa_stats_type stats;
+        const auto minMax = std::minmax_element(locs.begin(), locs.end());
+        stats.lo = *minMax.first;
+        stats.hi = *minMax.second;
+        NumType weightedSumMax = 0;
+        NumType weightedSumMin = 0;
+        for (NumType loc : locs)
+        {
+            const NumType expMax = std::exp((loc - stats.hi) / alpha);
+            const NumType expMin = std::exp((stats.lo - loc) / alpha);
+            stats.sumMax += expMax;
+            stats.sumMin += expMin;
+            weightedSumMax += loc * expMax;
+            weightedSumMin += loc * expMin;
+        }
+        // Both sums are at least one, from the extreme coordinates
+        stats.avgMax = weightedSumMax / stats.sumMax;
+        stats.avgMin = weightedSumMin / stats.sumMin;
+        return stats;
+    }
+
+    NumType evaluate() const
+    {
+        if (! validHpwl())
+        {
+            return 0;
+        }
+        const NumType alpha = _getAlphaFunc();
+        const NumType lambda = _getLambdaFunc();
+        std::vector<NumType> locs;
+        NumType obj = 0;
+        for (Orient2DType orient : {Orient2DType::HORIZONTAL, Orient2DType::VERTICAL})
+        {
+            pinLocs(orient, locs);
+            const auto stats = waStats(locs, alpha);
+            obj += stats.avgMax - stats.avgMin;
+        }
+        return obj * _weight * lambda;
+    }
+
+    void accumlateGradient() const
+    {
+        if (! validHpwl())
+        {
+            return;
+        }
+        const NumType alpha = _getAlphaFunc();
+        const NumType lambda = _getLambdaFunc();
+        std::vector<NumType> locs;
+        for (Orient2DType orient : {Orient2DType::HORIZONTAL, Orient2DType::VERTICAL})
+        {
+            pinLocs(orient, locs);
+            const auto stats = waStats(locs, alpha);
+            for (IndexType pinIdx = 0; pinIdx < _cells.size(); ++pinIdx)
+            {
+                const NumType loc = locs[pinIdx];
+                // d avgMax / dx = p (1 + (x - avgMax) / alpha), d avgMin / dx = q (1 - (x - avgMin) / alpha)
+                const NumType p = std::exp((loc - stats.hi) / alpha) / stats.sumMax;
+                const NumType q = std::exp((stats.lo - loc) / alpha) / stats.sumMin;
+                const NumType partial = p * (1 + (loc - stats.avgMax) / alpha) - q * (1 - (loc - stats.avgMin) / alpha);
+                _accumulateGradFunc(lambda * _weight * partial, _cells[pinIdx], orient);
+            }
         }
     }
 
@@ -245,9 +480,129 @@ struct LseHpwlDifferentiable
     std::function<void(NumType, IndexType, Orient2DType)> _accumulateGradFunc; ///< A function to update partial
 };
 
+template <typename NumType, typename CoordType>
+struct is_placement_differentiable_concept<WaHpwlDifferentiable<NumType, CoordType>>
+{
+    typedef std::true_type  is_placement_differentiable_concept_type;
+};
+
+/// @brief the proximity of a group of cells. The cost of a direction is twice the smoothed root mean square distance of the cell centers to their centroid, 2 * sqrt(sum((x - centroid)^2) / n + alpha^2).
+/// It equals the span of two cells, as the dummy net connecting the cells did, and pulls each cell to the centroid with a gradient linear in its distance
+template<typename NumType, typename CoordType>
+struct ProximityGroupDifferentiable
+{
+    typedef NumType numerical_type;
+    typedef CoordType coordinate_type;
+
+    /// @brief the centroid and the smoothed spread of the coordinates of a direction
+    struct spread_stats_type
+    {
+        NumType centroid = 0; ///< The mean of the coordinates
+        NumType spread = 0; ///< sqrt(sum((x - centroid)^2) / n + alpha^2)
+    };
+
+    ProximityGroupDifferentiable(const std::function<NumType(void)> &getAlphaFunc, const std::function<NumType(void)> &getLambdaFunc)
+    { _getAlphaFunc = getAlphaFunc; _getLambdaFunc = getLambdaFunc; }
+
+    void setGetVarFunc(const std::function<CoordType(IndexType, Orient2DType)> &getVarFunc) { _getVarFunc = getVarFunc; }
+    void setAccumulateGradFunc(const std::function<void(NumType, IndexType, Orient2DType)> &func) { _accumulateGradFunc = func; }
+    void setGetAlphaFunc(const std::function<NumType(void)> &getAlphaFunc) { _getAlphaFunc = getAlphaFunc; }
+
+    /// @brief add a cell to the group
+    /// @param first: the cell index
+    /// @param second: the x offset of the cell center to the cell location
+    /// @param third: the y offset of the cell center to the cell location
+    void addCell(IndexType cellIdx, const CoordType &offsetX, const CoordType &offsetY)
+    {
+        _cells.emplace_back(cellIdx);
+        _offsetX.emplace_back(offsetX);
+        _offsetY.emplace_back(offsetY);
+    }
+    void setWeight(const NumType &weight) { _weight = weight; }
+    bool validGroup() const { return _cells.size() > 1; }
+
+    /// @brief the coordinates of the cell centers in a direction
+    void cellLocs(Orient2DType orient, std::vector<NumType> &locs) const
+    {
+        const bool isHor = orient == Orient2DType::HORIZONTAL;
+        locs.resize(_cells.size());
+        for (IndexType idx = 0; idx < _cells.size(); ++idx)
+        {
+            locs[idx] = op::conv<NumType>(_getVarFunc(_cells[idx], orient) + (isHor ? _offsetX[idx] : _offsetY[idx]));
+        }
+    }
+
+    static spread_stats_type spreadStats(const std::vector<NumType> &locs, NumType alpha)
+    {
+        spread_stats_type stats;
+        const NumType numCells = op::conv<NumType>(locs.size());
+        for (NumType loc : locs)
+        {
+            stats.centroid += loc;
+        }
+        stats.centroid /= numCells;
+        NumType sumSquare = 0;
+        for (NumType loc : locs)
+        {
+            sumSquare += (loc - stats.centroid) * (loc - stats.centroid);
+        }
+        stats.spread = std::sqrt(sumSquare / numCells + alpha * alpha);
+        return stats;
+    }
+
+    NumType evaluate() const
+    {
+        if (! validGroup())
+        {
+            return 0;
+        }
+        const NumType alpha = _getAlphaFunc();
+        const NumType lambda = _getLambdaFunc();
+        std::vector<NumType> locs;
+        NumType obj = 0;
+        for (Orient2DType orient : {Orient2DType::HORIZONTAL, Orient2DType::VERTICAL})
+        {
+            cellLocs(orient, locs);
+            obj += 2 * spreadStats(locs, alpha).spread;
+        }
+        return obj * _weight * lambda;
+    }
+
+    void accumlateGradient() const
+    {
+        if (! validGroup())
+        {
+            return;
+        }
+        const NumType alpha = _getAlphaFunc();
+        const NumType lambda = _getLambdaFunc();
+        const NumType numCells = op::conv<NumType>(_cells.size());
+        std::vector<NumType> locs;
+        for (Orient2DType orient : {Orient2DType::HORIZONTAL, Orient2DType::VERTICAL})
+        {
+            cellLocs(orient, locs);
+            const auto stats = spreadStats(locs, alpha);
+            for (IndexType idx = 0; idx < _cells.size(); ++idx)
+            {
+                // The partials of the centroid sum to zero over the group
+                const NumType partial = 2 * (locs[idx] - stats.centroid) / (numCells * stats.spread);
+                _accumulateGradFunc(lambda * _weight * partial, _cells[idx], orient);
+            }
+        }
+    }
+
+    std::vector<IndexType> _cells;
+    std::vector<CoordType> _offsetX;
+    std::vector<CoordType> _offsetY;
+    NumType _weight = 1;
+    std::function<NumType(void)> _getAlphaFunc; ///< A function to get the current alpha
+    std::function<NumType(void)> _getLambdaFunc; ///< A function to get the current lambda multiplier
+    std::function<CoordType(IndexType cellIdx, Orient2DType orient)> _getVarFunc; ///< A function to get current variable value
+    std::function<void(NumType, IndexType, Orient2DType)> _accumulateGradFunc; ///< A function to update partial
+};
 
 template <typename NumType, typename CoordType>
-struct is_placement_differentiable_concept<LseHpwlDifferentiable<NumType, CoordType>>
+struct is_placement_differentiable_concept<ProximityGroupDifferentiable<NumType, CoordType>>
 {
     typedef std::true_type  is_placement_differentiable_concept_type;
 };
@@ -980,7 +1335,8 @@ inline NumType VerticalConstraintDifferentiable<NumType, CoordType>::evaluate()
     const NumType oy1 = _sOffset;
     const NumType oy2 = _tOffset;
 
-    return alpha*std::log(std::exp(-(oy2 - oy1 + y2 - y1)/alpha) + 1) * lambda * _weight;
+    const NumType var = -(oy2 - oy1 + y2 - y1) / alpha;
+    return alpha * op::softplus(var, std::exp(-std::abs(var))) * lambda * _weight;
 }
 
 template<typename NumType, typename CoordType>
@@ -993,16 +1349,11 @@ inline void VerticalConstraintDifferentiable<NumType, CoordType>::accumlateGradi
     const NumType oy1 = _sOffset;
     const NumType oy2 = _tOffset;
 
+    const NumType var = -(oy2 - oy1 + y2 - y1) / alpha;
+    const NumType dy1 = op::sigmoid(var, std::exp(-std::abs(var))) * lambda * _weight;
 
-    NumType dy2 = - std::exp(-(oy2 - oy1 + y2 - y1)/alpha)/(std::exp(-(oy2 - oy1 + y2 - y1)/alpha) + 1);
-;
-    dy2 *= (lambda * _weight);
-
-    NumType dy1 = std::exp(-(oy2 - oy1 + y2 - y1)/alpha)/(std::exp(-(oy2 - oy1 + y2 - y1)/alpha) + 1);
-    dy1 *= (lambda * _weight);
-
-    _accumulateGradFunc(dy1 * _weight, _sCellIdx, Orient2DType::VERTICAL);
-    _accumulateGradFunc(dy2 * _weight, _tCellIdx, Orient2DType::VERTICAL);
+    _accumulateGradFunc(dy1, _sCellIdx, Orient2DType::VERTICAL);
+    _accumulateGradFunc(-dy1, _tCellIdx, Orient2DType::VERTICAL);
 }
 
 
@@ -1056,7 +1407,8 @@ inline NumType HorizontalConstraintDifferentiable<NumType, CoordType>::evaluate(
     const NumType ox1 = _sOffset;
     const NumType ox2 = _tOffset;
 
-    return alpha*std::log(std::exp(-(ox2 - ox1 + x2 - x1)/alpha) + 1) * lambda * _weight;
+    const NumType var = -(ox2 - ox1 + x2 - x1) / alpha;
+    return alpha * op::softplus(var, std::exp(-std::abs(var))) * lambda * _weight;
 }
 
 template<typename NumType, typename CoordType>
@@ -1069,17 +1421,131 @@ inline void HorizontalConstraintDifferentiable<NumType, CoordType>::accumlateGra
     const NumType ox1 = _sOffset;
     const NumType ox2 = _tOffset;
 
+    const NumType var = -(ox2 - ox1 + x2 - x1) / alpha;
+    const NumType dx1 = op::sigmoid(var, std::exp(-std::abs(var))) * lambda * _weight;
 
-    NumType dx2 = - std::exp(-(ox2 - ox1 + x2 - x1)/alpha)/(std::exp(-(ox2 - ox1 + x2 - x1)/alpha) + 1);
-;
-    dx2 *= (lambda * _weight);
+    _accumulateGradFunc(dx1, _sCellIdx, Orient2DType::HORIZONTAL);
+    _accumulateGradFunc(-dx1, _tCellIdx, Orient2DType::HORIZONTAL);
+}
 
-    NumType dx1 = std::exp(-(ox2 - ox1 + x2 - x1)/alpha)/(std::exp(-(ox2 - ox1 + x2 - x1)/alpha) + 1);
-    dx1 *= (lambda * _weight);
+/// @brief all the relational constraints of a direction in one operator. Same cost as VerticalConstraintDifferentiable and HorizontalConstraintDifferentiable:
+/// alpha * softplus((source + source offset - target - target offset) / alpha) for each constraint.
+/// The constraints are kept in arrays of the variable indices, offsets and weights, and read the placement vector directly.
+/// Each pass gathers the scaled violations, then computes exp(-|violation|) once for the softplus and the sigmoid, then sums or scatters.
+/// With -fno-math-errno and place/VectorMath.h in the translation unit, the loops vectorize and call the vector exp and log1p of libmvec, except the gather and the scatter by the variable indices
+template<typename NumType, typename CoordType>
+struct RelationalConstraintBatchDifferentiable
+{
+    typedef NumType numerical_type;
+    typedef CoordType coordinate_type;
 
-    _accumulateGradFunc(dx1 * _weight, _sCellIdx, Orient2DType::HORIZONTAL);
-    _accumulateGradFunc(dx2 * _weight, _tCellIdx, Orient2DType::HORIZONTAL);
-}
+    void setGetAlphaFunc(const std::function<NumType(void)> &getAlphaFunc) { _getAlphaFunc = getAlphaFunc; }
+    void setGetLambdaFunc(const std::function<NumType(void)> &getLambdaFunc) { _getLambdaFunc = getLambdaFunc; }
+
+    /// @brief add a constraint: the source should not be above (or at the right of) the target
+    /// @param first: the index of the source variable in the placement vector
+    /// @param second: the offset of the source
+    /// @param third: the index of the target variable in the placement vector
+    /// @param fourth: the offset of the target
+    /// @param fifth: the weight of the constraint
+    void addConstraint(IndexType sVarIdx, const CoordType &sOffset, IndexType tVarIdx, const CoordType &tOffset, NumType weight)
+    {
+        _sVarIdx.emplace_back(sVarIdx);
+        _tVarIdx.emplace_back(tVarIdx);
+        _offset.emplace_back(op::conv<NumType>(sOffset - tOffset));
+        _weight.emplace_back(weight);
+        _totalWeight += weight;
+    }
+    IndexType numConstraints() const { return _sVarIdx.size(); }
+    NumType totalWeight() const { return _totalWeight; }
+
+    /// @brief the sum of the costs
+    /// @param the placement vector
+    template<typename VectorType>
+    IDEAPLACE_MULTIVERSION NumType evaluate(const VectorType &pl) const
+    {
+        if (numConstraints() == 0)
+        {
+            return 0;
+        }
+        const NumType alpha = _getAlphaFunc();
+        gatherVars(pl, alpha);
+        const IndexType numCons = numConstraints();
+        const NumType *var = _var.data();
+        const NumType *expNegAbs = _expNegAbs.data();
+        const NumType *weight = _weight.data();
+        NumType obj = 0;
+        for (IndexType idx = 0; idx < numCons; ++idx)
+        {
+            obj += weight[idx] * op::softplus(var[idx], expNegAbs[idx]);
+        }
+        return alpha * obj * _getLambdaFunc();
+    }
+
+    /// @brief add the gradient to a vector indexed as the placement
+    /// @param first: the placement vector
+    /// @param second: the gradient vector
+    template<typename VectorType>
+    IDEAPLACE_MULTIVERSION void accumulateGradient(const VectorType &pl, VectorType &grad) const
+    {
+        if (numConstraints() == 0)
+        {
+            return;
+        }
+        const NumType lambda = _getLambdaFunc();
+        gatherVars(pl, _getAlphaFunc());
+        const IndexType numCons = numConstraints();
+        NumType *var = _var.data();
+        const NumType *expNegAbs = _expNegAbs.data();
+        const NumType *weight = _weight.data();
+        for (IndexType idx = 0; idx < numCons; ++idx)
+        {
+            var[idx] = lambda * weight[idx] * op::sigmoid(var[idx], expNegAbs[idx]);
+        }
+        // Scatter apart from the computation, as the constraints may share cells
+        NumType *gradData = grad.data();
+        for (IndexType idx = 0; idx < numCons; ++idx)
+        {
+            gradData[_sVarIdx[idx]] += var[idx];
+            gradData[_tVarIdx[idx]] -= var[idx];
+        }
+    }
+
+    /// @brief fill _var with the scaled violations and _expNegAbs with exp(-|_var|).
+    /// The loops read raw pointers with a hoisted bound: the vectorizer gives up on the Eigen accessors, which assert, and on a bound it cannot prove loop invariant.
+    /// The gather stays scalar, as the generic tuning of GCC does not use the x86 gather instructions
+    template<typename VectorType>
+    IDEAPLACE_MULTIVERSION void gatherVars(const VectorType &pl, NumType alpha) const
+    {
+        const IndexType numCons = numConstraints();
+        _var.resize(numCons);
+        _expNegAbs.resize(numCons);
+        NumType *var = _var.data();
+        NumType *expNegAbs = _expNegAbs.data();
+        const auto *plData = pl.data();
+        const IndexType *sVarIdx = _sVarIdx.data();
+        const IndexType *tVarIdx = _tVarIdx.data();
+        const NumType *offset = _offset.data();
+        for (IndexType idx = 0; idx < numCons; ++idx)
+        {
+            var[idx] = (op::conv<NumType>(plData[sVarIdx[idx]] - plData[tVarIdx[idx]]) + offset[idx]) / alpha;
+        }
+        for (IndexType idx = 0; idx < numCons; ++idx)
+        {
+            expNegAbs[idx] = std::exp(-std::abs(var[idx]));
+        }
+    }
+
+    std::vector<IndexType> _sVarIdx; ///< The source variables
+    std::vector<IndexType> _tVarIdx; ///< The target variables
+    std::vector<NumType> _offset; ///< The source offset minus the target offset
+    std::vector<NumType> _weight; ///< The weights
+    NumType _totalWeight = 0; ///< The sum of the weights
+    mutable std::vector<NumType> _var; ///< The buffer of the scaled violations, or the partials. A batch is not evaluated by two threads at once
+    mutable std::vector<NumType> _expNegAbs; ///< The buffer of exp(-|_var|)
+    std::function<NumType(void)> _getAlphaFunc; ///< A function to get the current alpha
+    std::function<NumType(void)> _getLambdaFunc; ///< A function to get the current lambda multiplier
+};
 
 } //namespace diff
 
@@ -79,6 +79,69 @@ namespace diff
     };
 
 
+    template<typename NumType, typename CoordType>
+    struct jacobi_hessian_approx_trait<WaHpwlDifferentiable<NumType, CoordType>>
+    {
+        typedef WaHpwlDifferentiable<NumType, CoordType> operator_type;
+        static void accumulateHessian(const operator_type & op, const std::function<void(NumType, IndexType, IndexType, Orient2DType, Orient2DType)> &accumulateHessianFunc)
+        {
+            if (! op.validHpwl())
+            {
+                return;
+            }
+            const NumType alpha = op._getAlphaFunc();
+            const NumType scale = op._getLambdaFunc() * op._weight;
+            std::vector<NumType> locs;
+            for (Orient2DType orient : {Orient2DType::HORIZONTAL, Orient2DType::VERTICAL})
+            {
+                op.pinLocs(orient, locs);
+                const auto stats = operator_type::waStats(locs, alpha);
+                for (IndexType pinIdx = 0; pinIdx < op._cells.size(); ++pinIdx)
+                {
+                    const NumType loc = locs[pinIdx];
+                    const NumType p = std::exp((loc - stats.hi) / alpha) / stats.sumMax;
+                    const NumType q = std::exp((stats.lo - loc) / alpha) / stats.sumMin;
+                    // dp / dx = p (1 - p) / alpha and dq / dx = - q (1 - q) / alpha
+                    const NumType dMax = p * (1 + (loc - stats.avgMax) / alpha);
+                    const NumType dMin = q * (1 - (loc - stats.avgMin) / alpha);
+                    const NumType dMax2 = p * (1 - p) / alpha * (1 + (loc - stats.avgMax) / alpha) + p * (1 - dMax) / alpha;
+                    const NumType dMin2 = - q * (1 - q) / alpha * (1 - (loc - stats.avgMin) / alpha) - q * (1 - dMin) / alpha;
+                    accumulateHessianFunc(scale * (dMax2 - dMin2), op._cells[pinIdx], op._cells[pinIdx], orient, orient);
+                }
+            }
+        }
+    };
+
+    template<typename NumType, typename CoordType>
+    struct jacobi_hessian_approx_trait<ProximityGroupDifferentiable<NumType, CoordType>>
+    {
+        typedef ProximityGroupDifferentiable<NumType, CoordType> operator_type;
+        static void accumulateHessian(const operator_type & op, const std::function<void(NumType, IndexType, IndexType, Orient2DType, Orient2DType)> &accumulateHessianFunc)
+        {
+            if (! op.validGroup())
+            {
+                return;
+            }
+            const NumType alpha = op._getAlphaFunc();
+            const NumType scale = op._getLambdaFunc() * op._weight;
+            const NumType numCells = op::conv<NumType>(op._cells.size());
+            std::vector<NumType> locs;
+            for (Orient2DType orient : {Orient2DType::HORIZONTAL, Orient2DType::VERTICAL})
+            {
+                op.cellLocs(orient, locs);
+                const auto stats = operator_type::spreadStats(locs, alpha);
+                for (IndexType idx = 0; idx < op._cells.size(); ++idx)
+                {
+                    // d / dx of 2 (x - centroid) / (n spread). Not negative, as (x - centroid)^2 <= (n - 1) / n * sum((x - centroid)^2)
+                    const NumType dist = locs[idx] - stats.centroid;
+                    const NumType partial2 = 2 / (numCells * stats.spread)
+                        * (1 - 1 / numCells - dist * dist / (numCells * stats.spread * stats.spread));
+                    accumulateHessianFunc(scale * partial2, op._cells[idx], op._cells[idx], orient, orient);
+                }
+            }
+        }
+    };
+
     template<typename NumType, typename CoordType>
     struct jacobi_hessian_approx_trait<CellPairOverlapPenaltyDifferentiable<NumType, CoordType>>
     {
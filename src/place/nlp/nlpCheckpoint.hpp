@@ -0,0 +1,207 @@
+/**
+ * @file nlpCheckpoint.hpp
+ * @brief The checkpoint of the non-linear programming global placement between the outer iterations
+ * @date 10/17/2026
+ */
+
+#pragma once
+
+#include <cstdio>
+#include "global/global.h"
+#include "util/BinaryStream.h"
+#include "util/MmapTokenizer.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace nlp
+{
+    namespace checkpoint
+    {
+        /// @brief the state of the global placement at the end of an outer iteration
+        template<typename nlp_numerical_type>
+        struct gp_checkpoint
+        {
+            static constexpr char MAGIC[8] = {'I', 'D', 'E', 'A', 'G', 'P', 'C', 'K'};
+            static constexpr std::uint32_t VERSION = 1;
+            IntType outerIter = 0; ///< The number of finished outer iterations
+            BoolType isFinished = false; ///< Whether the global placement has stopped. If so, the legalization can start from pl directly
+            std::vector<nlp_numerical_type> pl; ///< The placement solutions
+            std::vector<nlp_numerical_type> constMults; ///< The constant multipliers
+            std::vector<nlp_numerical_type> variedMults; ///< The varied penalty multipliers
+            std::vector<nlp_numerical_type> alpha; ///< The alpha of the operators
+            /* The algorithm components are plain structs, and are kept as raw bytes */
+            std::vector<Byte> multUpdateState; ///< The state of the multiplier update
+            std::vector<Byte> multAdjustState; ///< The state of the multiplier adjustment
+            std::vector<Byte> alphaUpdateState; ///< The state of the alpha update
+            std::vector<Byte> stopConditionState; ///< The state of the outer stop condition
+        };
+
+        /// @brief pack a plain struct into raw bytes
+        template<typename T>
+        inline std::vector<Byte> packState(const T &state)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "The algorithm state need to be a plain struct to be checkpointed");
+            std::vector<Byte> bytes(sizeof(T));
+            std::memcpy(bytes.data(), &state, sizeof(T));
+            return bytes;
+        }
+
+        /// @brief unpack the raw bytes into a plain struct
+        /// @return false if the sizes do not match, eg. the checkpoint is from different algorithm settings
+        template<typename T>
+        inline bool unpackState(const std::vector<Byte> &bytes, T &state)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "The algorithm state need to be a plain struct to be checkpointed");
+            if (bytes.size() != sizeof(T))
+            {
+                return false;
+            }
+            std::memcpy(&state, bytes.data(), sizeof(T));
+            return true;
+        }
+
+        /// @brief write a checkpoint. The file is written to a temporary file first and then renamed, so that a crash does not destroy the previous checkpoint
+        /// @return if successful
+        template<typename nlp_numerical_type>
+        inline bool write(const gp_checkpoint<nlp_numerical_type> &c, const std::string &filename)
+        {
+            typedef gp_checkpoint<nlp_numerical_type> checkpoint_type;
+            const std::string tempFilename = filename + ".tmp";
+            {
+                ::klib::BinaryWriter writer(tempFilename);
+                for (char ch : checkpoint_type::MAGIC) { writer.pod(ch); }
+                writer.pod(checkpoint_type::VERSION);
+                writer.pod(static_cast<std::uint32_t>(sizeof(nlp_numerical_type)));
+                writer.pod(c.outerIter);
+                writer.pod(c.isFinished);
+                writer.vec(c.pl);
+                writer.vec(c.constMults);
+                writer.vec(c.variedMults);
+                writer.vec(c.alpha);
+                writer.vec(c.multUpdateState);
+                writer.vec(c.multAdjustState);
+                writer.vec(c.alphaUpdateState);
+                writer.vec(c.stopConditionState);
+                writer.close();
+                if (!writer.good())
+                {
+                    ERR("nlp::checkpoint::%s failed writing %s \n", __FUNCTION__, tempFilename.c_str());
+                    return false;
+                }
+            }
+            if (std::rename(tempFilename.c_str(), filename.c_str()) != 0)
+            {
+                ERR("nlp::checkpoint::%s failed renaming %s to %s \n", __FUNCTION__, tempFilename.c_str(), filename.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        /// @brief read a checkpoint
+        /// @return if successful
+        template<typename nlp_numerical_type>
+        inline bool read(gp_checkpoint<nlp_numerical_type> &c, const std::string &filename)
+        {
+            typedef gp_checkpoint<nlp_numerical_type> checkpoint_type;
+            ::klib::MmapFile file;
+            if (!file.open(filename))
+            {
+                ERR("nlp::checkpoint::%s cannot open %s \n", __FUNCTION__, filename.c_str());
+                return false;
+            }
+            ::klib::BinaryReader reader(file.content());
+            char magic[sizeof(checkpoint_type::MAGIC)];
+            for (char &ch : magic) { reader.pod(ch); }
+            std::uint32_t version = 0, numericalSize = 0;
+            reader.pod(version);
+            reader.pod(numericalSize);
+            if (!reader.ok() || std::memcmp(magic, checkpoint_type::MAGIC, sizeof(magic)) != 0
+                    || version != checkpoint_type::VERSION || numericalSize != sizeof(nlp_numerical_type))
+            {
+                ERR("nlp::checkpoint::%s %s is not a compatible global placement checkpoint \n", __FUNCTION__, filename.c_str());
+                return false;
+            }
+            reader.pod(c.outerIter);
+            reader.pod(c.isFinished);
+            reader.vec(c.pl);
+            reader.vec(c.constMults);
+            reader.vec(c.variedMults);
+            reader.vec(c.alpha);
+            reader.vec(c.multUpdateState);
+            reader.vec(c.multAdjustState);
+            reader.vec(c.alphaUpdateState);
+            reader.vec(c.stopConditionState);
+            if (!reader.ok() || !reader.atEnd())
+            {
+                ERR("nlp::checkpoint::%s %s is corrupted \n", __FUNCTION__, filename.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        /// @brief capture and restore the checkpoint of a global placer
+        template<typename nlp_type>
+        struct gp_checkpoint_trait
+        {
+            typedef gp_checkpoint<typename nlp_type::nlp_numerical_type> checkpoint_type;
+
+            /// @brief capture the state after an outer iteration
+            template<typename mult_type, typename mult_adjust_type, typename alpha_type, typename alpha_update_type>
+            static checkpoint_type capture(nlp_type &n, IntType outerIter, BoolType isFinished,
+                    const mult_type &mult, const mult_adjust_type &multAdjust, const alpha_type &alpha, const alpha_update_type &alphaUpdate)
+            {
+                checkpoint_type c;
+                c.outerIter = outerIter;
+                c.isFinished = isFinished;
+                c.pl.assign(n._pl.data(), n._pl.data() + n._pl.size());
+                c.constMults = mult._constMults;
+                c.variedMults = mult._variedMults;
+                c.alpha = alpha._alpha;
+                c.multUpdateState = packState(mult.update);
+                c.multAdjustState = packState(multAdjust);
+                c.alphaUpdateState = packState(alphaUpdate);
+                c.stopConditionState = packState(n._stopCondition);
+                return c;
+            }
+
+            /// @brief restore the state. The multipliers and alpha need to be initialized before, as the operators refer to them
+            /// @return false if the checkpoint does not match the problem
+            template<typename mult_type, typename mult_adjust_type, typename alpha_type, typename alpha_update_type>
+            static bool restore(nlp_type &n, const checkpoint_type &c,
+                    mult_type &mult, mult_adjust_type &multAdjust, alpha_type &alpha, alpha_update_type &alphaUpdate)
+            {
+                if (c.pl.size() != n._numVariables or c.constMults.size() != mult._constMults.size()
+                        or c.variedMults.size() != mult._variedMults.size() or c.alpha.size() != alpha._alpha.size())
+                {
+                    ERR("nlp::checkpoint::%s the checkpoint does not match the problem \n", __FUNCTION__);
+                    return false;
+                }
+                // Unpack into copies, so that nothing is changed if any of them fails
+                auto multUpdate = mult.update;
+                auto multAdjustCopy = multAdjust;
+                auto alphaUpdateCopy = alphaUpdate;
+                auto stopCondition = n._stopCondition;
+                if (not unpackState(c.multUpdateState, multUpdate)
+                        or not unpackState(c.multAdjustState, multAdjustCopy)
+                        or not unpackState(c.alphaUpdateState, alphaUpdateCopy)
+                        or not unpackState(c.stopConditionState, stopCondition))
+                {
+                    ERR("nlp::checkpoint::%s the checkpoint is from different algorithm settings \n", __FUNCTION__);
+                    return false;
+                }
+                mult.update = multUpdate;
+                multAdjust = multAdjustCopy;
+                alphaUpdate = alphaUpdateCopy;
+                n._stopCondition = stopCondition;
+                std::copy(c.pl.begin(), c.pl.end(), n._pl.data());
+                // Assign in place: the operators keep referring to the same multiplier and alpha objects
+                std::copy(c.constMults.begin(), c.constMults.end(), mult._constMults.begin());
+                std::copy(c.variedMults.begin(), c.variedMults.end(), mult._variedMults.begin());
+                std::copy(c.alpha.begin(), c.alpha.end(), alpha._alpha.begin());
+                return true;
+            }
+        };
+    } // namespace checkpoint
+} // namespace nlp
+
+PROJECT_NAMESPACE_END
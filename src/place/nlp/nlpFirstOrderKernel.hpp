@@ -66,8 +66,10 @@ namespace nlp
                 do 
                 {
                     n.calcGrad();
+                    n.traceInnerBegin();
                     n._pl -= optm_type::_stepSize * n._grad;
                     ++iter;
+                    n.traceInnerEnd(iter);
                 } while (!converge_trait::stopCriteria(n, o, o._converge) );
 #ifdef DEBUG_GR
                 DBG("naive gradient decesent: %f hpwl %f cos %f ovl %f oob %f asym %f \n", n._obj, n._objHpwl, n._objCos, n._objOvl, n._objOob, n._objAsym);
@@ -82,6 +84,27 @@ namespace nlp
             typedef first_order::adam<converge_criteria_type, nlp_numerical_type> optm_type;
             typedef typename optm_type::converge_type converge_type;
             typedef nlp::converge::converge_criteria_trait<converge_type> converge_trait;
+            /// @brief update the moments and the variables. A plain loop so that each clone vectorizes for its ISA
+            IDEAPLACE_MULTIVERSION static void step(IndexType numVars, IndexType iter, const nlp_numerical_type *grad,
+                    nlp_numerical_type *m, nlp_numerical_type *v, nlp_numerical_type *pl)
+            {
+                const nlp_numerical_type mCorrection = 1 - std::pow(optm_type::beta1, iter);
+                const nlp_numerical_type vCorrection = 1 - std::pow(optm_type::beta2, iter);
+                const bool isAdam = iter > 1000;
+                for (IndexType idx = 0; idx < numVars; ++idx)
+                {
+                    m[idx] = optm_type::beta1 * m[idx] + (1 - optm_type::beta1) * grad[idx];
+                    v[idx] = optm_type::beta2 * v[idx] + (1 - optm_type::beta2) * grad[idx] * grad[idx];
+                    if (isAdam)
+                    {
+                        pl[idx] -= optm_type::alpha * ((m[idx] / mCorrection) / (std::sqrt(v[idx] / vCorrection) + optm_type::epsilon));
+                    }
+                    else
+                    {
+                        pl[idx] -= optm_type::naiveGradientDescentStepSize * grad[idx];
+                    }
+                }
+            }
             template<typename nlp_type, std::enable_if_t<nlp::is_first_order_diff<nlp_type>::value, void>* = nullptr>
             static void optimize(nlp_type &n, optm_type &o)
             {
@@ -95,24 +118,14 @@ namespace nlp
                 {
                     ++iter;
                     n.calcGrad();
+                    n.traceInnerBegin();
 
                     n._optimizerKernelStopWatch->start();
 
-                    m = o.beta1 * m + (1 - o.beta1) * n._grad;
-                    v = o.beta2 * v + (1 - o.beta2) * n._grad.cwiseProduct(n._grad);
-                    auto mt = m / (1 - pow(o.beta1, iter));
-                    auto vt = v / (1 - pow(o.beta2, iter));
-                    auto bot = vt.array().sqrt() + o.epsilon;
-                    if (iter > 1000)
-                    {
-                        n._pl = n._pl - o.alpha * ( mt.array() / bot).matrix();
-                    }
-                    else
-                    {
-                        n._pl -= optm_type::naiveGradientDescentStepSize * n._grad;
-                    }
+                    step(numVars, iter, n._grad.data(), m.data(), v.data(), n._pl.data());
 
                     n._optimizerKernelStopWatch->stop();
+                    n.traceInnerEnd(iter);
                     //n.calcObj();
                     //DBG("norm %f \n", n._grad.norm());
                     //DBG("adam: %f hpwl %f cos %f ovl %f oob %f asym %f \n", n._obj, n._objHpwl, n._objCos, n._objOvl, n._objOob, n._objAsym);
@@ -132,6 +145,17 @@ namespace nlp
             typedef first_order::nesterov<converge_criteria_type, nlp_numerical_type> optm_type;
             typedef typename optm_type::converge_type converge_type;
             typedef nlp::converge::converge_criteria_trait<converge_type> converge_trait;
+            /// @brief take the gradient step and the momentum. yPrev becomes the new y. A plain loop so that each clone vectorizes for its ISA
+            IDEAPLACE_MULTIVERSION static void step(IndexType numVars, nlp_numerical_type gamma, const nlp_numerical_type *grad,
+                    nlp_numerical_type *pl, nlp_numerical_type *yCurr, nlp_numerical_type *yPrev)
+            {
+                for (IndexType idx = 0; idx < numVars; ++idx)
+                {
+                    yCurr[idx] = pl[idx] - optm_type::eta * grad[idx];
+                    pl[idx] = (1 - gamma) * yCurr[idx] + gamma * yPrev[idx];
+                    yPrev[idx] = yCurr[idx];
+                }
+            }
             template<typename nlp_type, std::enable_if_t<nlp::is_first_order_diff<nlp_type>::value, void>* = nullptr>
             static void optimize(nlp_type &n, optm_type &o)
             {
@@ -148,10 +172,9 @@ namespace nlp
                 {
                     ++iter;
                     n.calcGrad();
-                    yCurr = n._pl - o.eta * n._grad;
-                    n._pl = (1 - gamma) * yCurr + gamma * yPrev;
-
-                    yPrev = yCurr;
+                    n.traceInnerBegin();
+                    step(numVars, gamma, n._grad.data(), n._pl.data(), yCurr.data(), yPrev.data());
+                    n.traceInnerEnd(iter);
 
                     const auto lambdaTemp = lambdaCurr;
                     lambdaCurr = (1 + std::sqrt(1 + 4 * lambdaPrev * lambdaPrev)) * 0.5;
@@ -129,6 +129,77 @@ namespace nlp
             }
         };
 
+        /// @brief budget the inner iterations of each outer iteration.
+        /// The budget is small when the multipliers are far from their fixed point, as the problem changes much at their next update.
+        /// In the budget, stop once the objective reduction rate stays under a ratio of its peak in the solve.
+        /// The nlp needs _multDistance, the relative change of the multipliers in their last update.
+        /// min_iter should be past the warm-up of the kernel: the first order adam steps by gradient descent for 1000 iterations, and the objective jumps at the switch
+        template<typename nlp_numerical_type, IntType min_iter=2000, IntType max_iter=3000>
+        struct converge_criteria_adaptive_budget
+        {
+            IntType checkInterval = 100; ///< Evaluate the objective every this number of iterations
+            IntType numLowChecksToStop = 3; ///< Stop after this number of consecutive checks with a low reduction rate
+            nlp_numerical_type stopRateRatio = 0.01; ///< A reduction rate is low under this ratio of the peak rate
+            nlp_numerical_type multDistanceScale = 0.1; ///< The multiplier distance that halves the budget over min_iter
+            IntType _iter = 0; ///< The iterations in the current solve
+            IntType _budget = max_iter; ///< The budget of the current solve
+            IntType _numLowChecks = 0; ///< The consecutive checks with a low reduction rate
+            nlp_numerical_type _fLastCheck = -1.0; ///< The objective at the last check. Negative if not checked
+            nlp_numerical_type _peakRate = 0.0; ///< The peak reduction rate in the current solve
+        };
+
+        template<typename nlp_numerical_type, IntType min_iter, IntType max_iter>
+        struct converge_criteria_trait<converge_criteria_adaptive_budget<nlp_numerical_type, min_iter, max_iter>>
+        {
+            typedef converge_criteria_adaptive_budget<nlp_numerical_type, min_iter, max_iter> converge_type;
+            static void clear(converge_type &c)
+            {
+                c._iter = 0;
+                c._numLowChecks = 0;
+                c._fLastCheck = -1.0;
+                c._peakRate = 0.0;
+            }
+            /// @brief the budget of a solve. max_iter at the fixed point of the multipliers and toward min_iter far from it
+            template<typename nlp_type>
+            static IntType budget(nlp_type &n, converge_type &c)
+            {
+                const nlp_numerical_type ratio = c.multDistanceScale / (c.multDistanceScale + std::abs(n._multDistance));
+                return min_iter + static_cast<IntType>((max_iter - min_iter) * ratio);
+            }
+            template<typename nlp_type, typename optm_type>
+            static BoolType stopCriteria(nlp_type &n, optm_type &, converge_type &c)
+            {
+                if (c._iter == 0)
+                {
+                    c._budget = budget(n, c);
+                }
+                ++c._iter;
+                if (c._iter >= c._budget)
+                {
+                    clear(c);
+                    return true;
+                }
+                if (c._iter % c.checkInterval != 0)
+                {
+                    return false;
+                }
+                n.calcObj();
+                if (c._fLastCheck >= 0.0)
+                {
+                    const nlp_numerical_type rate = (c._fLastCheck - n._obj) / std::max(c._fLastCheck, static_cast<nlp_numerical_type>(1e-12)) / c.checkInterval;
+                    c._peakRate = std::max(c._peakRate, rate);
+                    c._numLowChecks = rate < c.stopRateRatio * c._peakRate ? c._numLowChecks + 1 : 0;
+                    if (c._iter >= min_iter and c._numLowChecks >= c.numLowChecksToStop)
+                    {
+                        clear(c);
+                        return true;
+                    }
+                }
+                c._fLastCheck = n._obj;
+                return false;
+            }
+        };
+
         /// @brief a convenient wrapper for combining different types of converge condition. the list in the template will be check one by one and return converge if any of them say so
         template<typename converge_type, typename... others>
         struct converge_list 
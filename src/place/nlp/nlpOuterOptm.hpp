@@ -274,6 +274,10 @@ namespace nlp
                     {
                         totalHpwlWeights += op._weight;
                     }
+                    for (const auto & op : nlp._proxOps)
+                    {
+                        totalHpwlWeights += op._weight;
+                    }
                     for (const auto & op : nlp._cosOps)
                     {
                         totalCosWeights += op._weight;
@@ -286,14 +290,8 @@ namespace nlp
                     {
                         totalCrfWeights += op._weight;
                     }
-                    for (const auto & op : nlp._verOps)
-                    {
-                        totalVerWeights += op._weight;
-                    }
-                    for (const auto & op : nlp._horOps)
-                    {
-                        totalHorWeights += op._weight;
-                    }
+                    totalVerWeights += nlp._verBatch.totalWeight();
+                    totalHorWeights += nlp._horBatch.totalWeight();
                     mult._constMults.at(0) = 1.0; // hpwl
                     const auto hpwlMult = mult._constMults.at(0);
                     const auto hpwlNorm = nlp._gradHpwl.norm();
@@ -547,6 +545,10 @@ namespace nlp
                     {
                         u.totalHpwlWeights += op._weight;
                     }
+                    for (const auto & op : n._proxOps)
+                    {
+                        u.totalHpwlWeights += op._weight;
+                    }
                     for (const auto & op : n._cosOps)
                     {
                         u.totalCosWeights += op._weight;
@@ -710,8 +712,9 @@ namespace nlp
                 for (auto &op : nlp._asymOps) { op._getLambdaFunc = [&](){ return mult._variedMults[2]; }; }
                 for (auto &op : nlp._powerWlOps) { op._getLambdaFunc = [&](){ return mult._constMults[2]; }; }
                 for (auto &op : nlp._crfOps) { op._getLambdaFunc = [&](){ return mult._variedMults[3]; }; }
-                for (auto &op : nlp._verOps) { op._getLambdaFunc = [&](){ return mult._variedMults[4]; }; }
-                for (auto &op : nlp._horOps) { op._getLambdaFunc = [&](){ return mult._variedMults[5]; }; }
+                nlp._verBatch.setGetLambdaFunc([&](){ return mult._variedMults[4]; });
+                nlp._horBatch.setGetLambdaFunc([&](){ return mult._variedMults[5]; });
+                for (auto &op : nlp._proxOps) { op._getLambdaFunc = [&](){ return mult._constMults[0]; }; }
             }
 
             template<typename nlp_type>
@@ -775,6 +778,10 @@ namespace nlp
                 {
                     op.setGetAlphaFunc([&](){ return alpha._alpha[0]; });
                 }
+                for (auto & op : nlp._proxOps)
+                {
+                    op.setGetAlphaFunc([&](){ return alpha._alpha[0]; });
+                }
                 for (auto & op : nlp._ovlOps)
                 {
                     op.setGetAlphaFunc([&](){ return alpha._alpha[1]; });
@@ -787,14 +794,8 @@ namespace nlp
                 {
                     op.setGetAlphaFunc([&](){ return alpha._alpha[3]; });
                 }
-                for (auto & op : nlp._verOps)
-                {
-                    op.setGetAlphaFunc([&](){ return alpha._alpha[4]; });
-                }
-                for (auto & op : nlp._horOps)
-                {
-                    op.setGetAlphaFunc([&](){ return alpha._alpha[5]; });
-                }
+                nlp._verBatch.setGetAlphaFunc([&](){ return alpha._alpha[4]; });
+                nlp._horBatch.setGetAlphaFunc([&](){ return alpha._alpha[5]; });
             }
 
         };
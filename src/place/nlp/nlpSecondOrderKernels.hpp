@@ -64,8 +64,10 @@ namespace nlp
                 {
                     n.calcGrad();
                     n.calcHessian();;
+                    n.traceInnerBegin();
                     n._pl -= optm_type::_stepSize * n.inverseHessian() * n._grad;
                     ++iter;
+                    n.traceInnerEnd(iter);
                 } while (!converge_trait::stopCriteria(n, o, o._converge) );
                 n.calcObj();
                 DBG("converge at iter %d \n", iter);
@@ -93,6 +95,7 @@ namespace nlp
                     ++iter;
                     n.calcGrad();
                     n.calcHessian();
+                    n.traceInnerBegin();
                     auto grad = n.inverseHessian() * n._grad;
                     m = o.beta1 * m + (1 - o.beta1) * grad;
                     v = o.beta2 * v + (1 - o.beta2) * grad.cwiseProduct(grad);
@@ -100,6 +103,7 @@ namespace nlp
                     auto vt = v / (1 - pow(o.beta2, iter));
                     auto bot = vt.array().sqrt() + o.epsilon;
                     n._pl = n._pl - o.alpha * ( mt.array() / bot).matrix();
+                    n.traceInnerEnd(iter);
                     //n.calcObj();
                     //DBG("norm %f \n", n._grad.norm());
                     //DBG("adam: %f hpwl %f cos %f ovl %f oob %f asym %f \n", n._obj, n._objHpwl, n._objCos, n._objOvl, n._objOob, n._objAsym);
@@ -135,8 +139,10 @@ namespace nlp
                     ++iter;
                     n.calcGrad();
                     n.calcHessian();
+                    n.traceInnerBegin();
                     yCurr = n._pl - o.eta * n.inverseHessian() * n._grad;
                     n._pl = (1 - gamma) * yCurr + gamma * yPrev;
+                    n.traceInnerEnd(iter);
 
                     yPrev = yCurr;
 
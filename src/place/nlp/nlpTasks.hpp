@@ -329,6 +329,40 @@ namespace nt
         }
     };
 
+    template<typename nlp_numerical_type, typename nlp_coordinate_type>
+    struct calc_operator_partial_build_cellmap_trait<diff::WaHpwlDifferentiable<nlp_numerical_type, nlp_coordinate_type>>
+    {
+        typedef diff::WaHpwlDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_op_type;
+        template<typename calc_type>
+        static void build(nlp_op_type &op, calc_type &calc)
+        {
+            calc._numCells = op._cells.size(); // dx and dy for each cells
+            calc._inverseCellMap.resize(op._cells.size());
+            for (IndexType idx = 0; idx < op._cells.size(); ++idx)
+            {
+                calc._cellMap[op._cells[idx]] = idx;
+                calc._inverseCellMap[idx] = op._cells[idx];
+            }
+        }
+    };
+
+    template<typename nlp_numerical_type, typename nlp_coordinate_type>
+    struct calc_operator_partial_build_cellmap_trait<diff::ProximityGroupDifferentiable<nlp_numerical_type, nlp_coordinate_type>>
+    {
+        typedef diff::ProximityGroupDifferentiable<nlp_numerical_type, nlp_coordinate_type> nlp_op_type;
+        template<typename calc_type>
+        static void build(nlp_op_type &op, calc_type &calc)
+        {
+            calc._numCells = op._cells.size(); // dx and dy for each cells
+            calc._inverseCellMap.resize(op._cells.size());
+            for (IndexType idx = 0; idx < op._cells.size(); ++idx)
+            {
+                calc._cellMap[op._cells[idx]] = idx;
+                calc._inverseCellMap[idx] = op._cells[idx];
+            }
+        }
+    };
+
     template<typename nlp_numerical_type, typename nlp_coordinate_type>
     struct calc_operator_partial_build_cellmap_trait<diff::CellPairOverlapPenaltyDifferentiable<nlp_numerical_type, nlp_coordinate_type>>
     {
@@ -475,6 +509,9 @@ namespace nt
         typedef typename nlp_op_type::coordinate_type nlp_coordiante_type;
         friend calc_operator_partial_build_cellmap_trait<nlp_op_type>;
         static constexpr IntType MAX_NUM_CELLS = IDEAPLACE_DEFAULT_MAX_NUM_CELLS;
+        /// @brief a vector target keeps only the diagonal. So does the operator then
+        static constexpr bool isDiagonal = TargetMatrix::ColsAtCompileTime == 1;
+        typedef std::conditional_t<isDiagonal, TargetMatrix, Matrix> local_matrix_type;
         public:
             CalculateOperatorHessianTask() = delete;
             CalculateOperatorHessianTask(CalculateOperatorHessianTask &other) = delete;
@@ -492,7 +529,14 @@ namespace nt
                 _op = op; 
                 // Use this trait to speficify different number of cells for different operators
                 calc_operator_partial_build_cellmap_trait<nlp_op_type>::build(*op, *this); 
-                _hessian.resize(2 * _numCells, 2 * _numCells);
+                if constexpr (isDiagonal)
+                {
+                    _hessian.resize(2 * _numCells);
+                }
+                else
+                {
+                    _hessian.resize(2 * _numCells, 2 * _numCells);
+                }
 
                 _target = target;
                 _idxFunc = idxFunc;
@@ -518,7 +562,18 @@ namespace nt
                 {
                     j += _numCells;
                 }
-                _hessian(i, j) += num;
+                if constexpr (isDiagonal)
+                {
+                    // The Jacobi approximations only write the diagonal
+                    if (i == j)
+                    {
+                        _hessian(i) += num;
+                    }
+                }
+                else
+                {
+                    _hessian(i, j) += num;
+                }
             }
             virtual void clear() 
             { 
@@ -530,7 +585,9 @@ namespace nt
                 clear(); 
                 hessian_type::accumulateHessian(*_op, _accumulateFunc);
             }
-            void update()
+            void update() { update(*_target); }
+            /// @brief add the hessian of the operator to a matrix of the target type other than the target, eg. the one of a thread
+            void update(TargetMatrix &target)
             {
                 for (IndexType i = 0; i < _numCells * 2; ++i)
                 {
@@ -546,26 +603,33 @@ namespace nt
                         iOrient = Orient2DType::VERTICAL;
                         iCellIdx = _inverseCellMap[i - _numCells];
                     }
-                    for (IndexType j = 0; j < _numCells * 2; ++j)
+                    if constexpr (isDiagonal)
                     {
-                        Orient2DType jOrient;
-                        IndexType jCellIdx;
-                        if (j < _numCells)
-                        {
-                            jOrient = Orient2DType::HORIZONTAL;
-                            jCellIdx = _inverseCellMap[j];
-                        }
-                        else
+                        target(_idxFunc(iCellIdx, iOrient)) += _hessian(i);
+                    }
+                    else
+                    {
+                        for (IndexType j = 0; j < _numCells * 2; ++j)
                         {
-                            jOrient = Orient2DType::VERTICAL;
-                            jCellIdx = _inverseCellMap[j - _numCells];
+                            Orient2DType jOrient;
+                            IndexType jCellIdx;
+                            if (j < _numCells)
+                            {
+                                jOrient = Orient2DType::HORIZONTAL;
+                                jCellIdx = _inverseCellMap[j];
+                            }
+                            else
+                            {
+                                jOrient = Orient2DType::VERTICAL;
+                                jCellIdx = _inverseCellMap[j - _numCells];
+                            }
+                            target(_idxFunc(iCellIdx, iOrient), _idxFunc(jCellIdx, jOrient)) += _hessian(i, j);
                         }
-                        (*_target)(_idxFunc(iCellIdx, iOrient), _idxFunc(jCellIdx, jOrient)) += _hessian(i, j);
                     }
                 }
             }
         protected:
-            Matrix _hessian;
+            local_matrix_type _hessian;
             nlp_op_type* _op = nullptr;
             std::array<IndexType, MAX_NUM_CELLS> _cellMap; ///< From db cell index to this class index
             std::vector<IndexType> _inverseCellMap;
@@ -0,0 +1,190 @@
+#include "AsyncLogger.h"
+#include <algorithm>
+#include <chrono>
+#include "MsgPrinter.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace AsyncLogDetails
+{
+    /// @brief hand the ring of a thread back to the logger when the thread exits. The ring is owned by AsyncLogger, so that its pending messages outlive the thread
+    struct LocalRingOwner
+    {
+        ~LocalRingOwner()
+        {
+            if (ring != nullptr)
+            {
+                logger->releaseRing(ring);
+            }
+        }
+        AsyncLogger *logger = nullptr;
+        LogRing *ring = nullptr;
+    };
+    thread_local LocalRingOwner localRingOwner;
+
+    /// @brief a formatted message waiting to be written
+    struct PendingMsg
+    {
+        std::uint64_t seq;
+        MsgType type;
+        std::time_t time;
+        std::string msg;
+    };
+}
+
+AsyncLogger & AsyncLogger::instance()
+{
+    static AsyncLogger logger;
+    return logger;
+}
+
+void AsyncLogger::start(std::size_t ringCapacity)
+{
+    if (isRunning())
+    {
+        return;
+    }
+    // Multiple of the alignment, so that a padding record always has room for its size
+    _ringCapacity = std::max(ringCapacity / RECORD_ALIGN * RECORD_ALIGN, static_cast<std::size_t>(1024));
+    _isStopping.store(false);
+    _isRunning.store(true, std::memory_order_release);
+    _flusher = std::thread([this]() { this->flusherLoop(); });
+}
+
+void AsyncLogger::stop()
+{
+    if (!isRunning())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _isStopping.store(true);
+    }
+    _wakeUp.notify_one();
+    _flusher.join();
+    _isRunning.store(false, std::memory_order_release);
+    drain();
+}
+
+AsyncLogDetails::LogRing & AsyncLogger::localRing()
+{
+    auto &owner = AsyncLogDetails::localRingOwner;
+    if (owner.ring == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(_ringMutex);
+        if (_freeRings.empty())
+        {
+            _rings.emplace_back(std::make_unique<AsyncLogDetails::LogRing>(_ringCapacity));
+            owner.ring = _rings.back().get();
+        }
+        else
+        {
+            // The previous producer has exited, so the ring stays single-producer. Its pending messages are written before the new ones
+            owner.ring = _freeRings.back();
+            _freeRings.pop_back();
+        }
+        owner.logger = this;
+    }
+    return *owner.ring;
+}
+
+void AsyncLogger::releaseRing(AsyncLogDetails::LogRing *ring)
+{
+    std::lock_guard<std::mutex> lock(_ringMutex);
+    _freeRings.emplace_back(ring);
+}
+
+void AsyncLogger::waitForSpace()
+{
+    if (!isRunning())
+    {
+        drain();
+        return;
+    }
+    _isWakeRequested.store(true, std::memory_order_relaxed);
+    _wakeUp.notify_one();
+    std::this_thread::yield();
+}
+
+void AsyncLogger::drain()
+{
+    std::lock_guard<std::mutex> drainLock(_drainMutex);
+    std::vector<AsyncLogDetails::LogRing *> rings;
+    {
+        std::lock_guard<std::mutex> lock(_ringMutex);
+        for (auto &ring : _rings)
+        {
+            rings.emplace_back(ring.get());
+        }
+    }
+    std::vector<AsyncLogDetails::PendingMsg> msgs;
+    char buf[1024];
+    for (auto *ring : rings)
+    {
+        // Only what is in the ring now. The producer may keep adding
+        std::size_t remaining = ring->used();
+        while (remaining > 0)
+        {
+            const auto *header = ring->front();
+            std::size_t size = header->size;
+            if (!header->isPadding)
+            {
+                const char *format = reinterpret_cast<const char *>(header) + sizeof(AsyncLogDetails::RecordHeader);
+                const char *args = format + std::strlen(format) + 1;
+                AsyncLogDetails::PendingMsg msg;
+                msg.seq = header->seq;
+                msg.type = static_cast<MsgType>(header->type);
+                msg.time = header->time;
+                int len = header->func(buf, sizeof(buf), format, args);
+                if (len >= static_cast<int>(sizeof(buf)))
+                {
+                    msg.msg.resize(len + 1);
+                    header->func(&msg.msg[0], msg.msg.size(), format, args);
+                    msg.msg.resize(len);
+                }
+                else if (len > 0)
+                {
+                    msg.msg.assign(buf, len);
+                }
+                msgs.emplace_back(std::move(msg));
+            }
+            ring->pop(size);
+            remaining -= size;
+        }
+    }
+    if (msgs.empty())
+    {
+        return;
+    }
+    std::sort(msgs.begin(), msgs.end(), [](const AsyncLogDetails::PendingMsg &lhs, const AsyncLogDetails::PendingMsg &rhs)
+            {
+                return lhs.seq < rhs.seq;
+            });
+    for (const auto &msg : msgs)
+    {
+        MsgPrinter::writeMsg(msg.type, msg.time, msg.msg.c_str());
+    }
+    MsgPrinter::flushStreams();
+}
+
+void AsyncLogger::flusherLoop()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wakeUp.wait_for(lock, std::chrono::milliseconds(20), [&]()
+                    {
+                        return _isStopping.load() || _isWakeRequested.exchange(false, std::memory_order_relaxed);
+                    });
+        }
+        drain();
+        if (_isStopping.load())
+        {
+            return;
+        }
+    }
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,258 @@
+/**
+ * @file AsyncLogger.h
+ * @brief Per-thread ring buffers and a background flusher for the messages
+ * @date 10/17/2026
+ */
+
+#ifndef IDEAPLACE_ASYNC_LOGGER_H_
+#define IDEAPLACE_ASYNC_LOGGER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "global/namespace.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+enum class MsgType;
+
+namespace AsyncLogDetails
+{
+    /// @brief whether the argument is a C string, which has to be copied instead of the pointer
+    template<typename T>
+    constexpr bool isCString()
+    {
+        using decayed = std::decay_t<T>;
+        return std::is_pointer<decayed>::value && std::is_same<std::remove_cv_t<std::remove_pointer_t<decayed>>, char>::value;
+    }
+
+    /// @brief copy the arguments into the buffer, and read them back for formatting
+    template<typename T, bool isStr = isCString<T>()>
+    struct ArgCodec
+    {
+        using decayed = std::decay_t<T>;
+        static_assert(std::is_trivially_copyable<decayed>::value, "The message arguments need to be printf-compatible");
+        typedef decayed decoded_type;
+        static std::size_t size(const T &) { return sizeof(decayed); }
+        static char * encode(char *buf, const T &arg)
+        {
+            decayed value = arg;
+            std::memcpy(buf, &value, sizeof(decayed));
+            return buf + sizeof(decayed);
+        }
+        static decoded_type decode(const char *&buf)
+        {
+            decayed value;
+            std::memcpy(&value, buf, sizeof(decayed));
+            buf += sizeof(decayed);
+            return value;
+        }
+    };
+    template<typename T>
+    struct ArgCodec<T, true>
+    {
+        typedef const char * decoded_type;
+        static const char * str(const char *arg) { return arg == nullptr ? "(null)" : arg; }
+        static std::size_t size(const T &arg) { return std::strlen(str(arg)) + 1; }
+        static char * encode(char *buf, const T &arg)
+        {
+            const char *s = str(arg);
+            std::size_t len = std::strlen(s) + 1;
+            std::memcpy(buf, s, len);
+            return buf + len;
+        }
+        static decoded_type decode(const char *&buf)
+        {
+            const char *s = buf;
+            buf += std::strlen(s) + 1;
+            return s;
+        }
+    };
+
+    /// @brief format the encoded arguments. Return the length as snprintf
+    typedef int (*FormatFunc)(char *out, std::size_t outSize, const char *format, const char *args);
+
+    template<typename... Args>
+    int formatArgs(char *out, std::size_t outSize, const char *format, const char *args)
+    {
+        // The braced initialization decodes the arguments from left to right
+        std::tuple<typename ArgCodec<Args>::decoded_type...> values{ArgCodec<Args>::decode(args)...};
+        return std::apply([&](auto... decoded)
+                {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-security"
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+                    return std::snprintf(out, outSize, format, decoded...);
+#pragma GCC diagnostic pop
+                }, values);
+    }
+
+    /// @brief the header of a record in the ring
+    struct RecordHeader
+    {
+        std::uint32_t size; ///< The size of the record including the header. Multiple of 8
+        std::uint8_t isPadding; ///< Whether the record only pads to the end of the ring
+        std::uint8_t type; ///< The MsgType
+        std::uint64_t seq; ///< The global order of the message. Taken before the message is committed, so it only orders the messages written by the same drain
+        std::time_t time; ///< The time of the message
+        FormatFunc func; ///< Formatting the arguments
+    };
+
+    /// @brief single-producer single-consumer ring of the records. The producer is the owning thread
+    class LogRing
+    {
+        public:
+            explicit LogRing(std::size_t capacity) : _data(new char[capacity]), _capacity(capacity) {}
+            std::size_t capacity() const { return _capacity; }
+            /// @brief the producer: get the space for a record of the size, padding to the start of the ring if needed.
+            /// @return nullptr if not enough free space yet
+            char * tryReserve(std::size_t size)
+            {
+                std::size_t tail = _tail.load(std::memory_order_relaxed);
+                std::size_t head = _head.load(std::memory_order_acquire);
+                std::size_t pos = tail % _capacity;
+                std::size_t toEnd = _capacity - pos;
+                std::size_t need = size <= toEnd ? size : size + toEnd;
+                if (_capacity - (tail - head) < need)
+                {
+                    return nullptr;
+                }
+                if (size > toEnd)
+                {
+                    auto *padding = reinterpret_cast<RecordHeader *>(_data.get() + pos);
+                    padding->size = static_cast<std::uint32_t>(toEnd);
+                    padding->isPadding = 1;
+                    _tail.store(tail + toEnd, std::memory_order_release);
+                    pos = 0;
+                }
+                return _data.get() + pos;
+            }
+            /// @brief the producer: publish the record written into the reserved space
+            void commit(std::size_t size) { _tail.store(_tail.load(std::memory_order_relaxed) + size, std::memory_order_release); }
+            /// @brief the consumer: get the oldest record. nullptr if empty
+            const RecordHeader * front()
+            {
+                std::size_t head = _head.load(std::memory_order_relaxed);
+                if (head == _tail.load(std::memory_order_acquire))
+                {
+                    return nullptr;
+                }
+                return reinterpret_cast<const RecordHeader *>(_data.get() + head % _capacity);
+            }
+            /// @brief the consumer: release the oldest record
+            void pop(std::size_t size) { _head.store(_head.load(std::memory_order_relaxed) + size, std::memory_order_release); }
+            /// @brief the number of bytes in use
+            std::size_t used() const { return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire); }
+        private:
+            std::unique_ptr<char[]> _data; ///< The buffer
+            std::size_t _capacity; ///< The size of the buffer
+            alignas(64) std::atomic<std::size_t> _head{0}; ///< The total bytes consumed
+            alignas(64) std::atomic<std::size_t> _tail{0}; ///< The total bytes produced
+    };
+
+    struct LocalRingOwner;
+}
+
+/// @class IDEAPLACE::AsyncLogger
+/// @brief the logging backend of MsgPrinter when the asynchronous mode is on.
+/// The logging thread only copies the format and the arguments into its own ring. The formatting and the writing are done by a background flusher, which merges the rings in the order of the messages.
+/// The order is best-effort across the threads: each drain sorts only what is in the rings at that moment, so a message committed just after a drain is written after the later messages of the other threads. The messages of one thread are always in order.
+/// A thread waits for the flusher when its ring is full, so that no message is dropped.
+/// The ring of a thread is handed to the next new thread once the thread exits, so the number of rings stays at the peak number of the logging threads alive at once
+class AsyncLogger
+{
+    public:
+        static constexpr std::size_t RECORD_ALIGN = 8;
+        static AsyncLogger & instance();
+        ~AsyncLogger() { stop(); }
+        /// @brief start the flusher
+        /// @param the size of the ring of each thread. In bytes
+        void start(std::size_t ringCapacity);
+        /// @brief write the pending messages and stop the flusher
+        void stop();
+        /// @brief whether the flusher is running
+        bool isRunning() const { return _isRunning.load(std::memory_order_acquire); }
+        /// @brief write the pending messages now
+        void flush() { drain(); }
+        /// @brief add a message
+        /// @return false if the message does not fit into a ring, and need to be printed directly
+        template<typename... Args>
+        bool push(MsgType type, const char *format, const Args &... args)
+        {
+            const std::size_t formatLen = std::strlen(format) + 1;
+            std::size_t size = sizeof(AsyncLogDetails::RecordHeader) + formatLen;
+            std::size_t sizes[] = {0, AsyncLogDetails::ArgCodec<Args>::size(args)...};
+            for (std::size_t argSize : sizes)
+            {
+                size += argSize;
+            }
+            size = (size + RECORD_ALIGN - 1) / RECORD_ALIGN * RECORD_ALIGN;
+            auto &ring = localRing();
+            if (size > ring.capacity() / 2)
+            {
+                return false;
+            }
+            char *buf = ring.tryReserve(size);
+            while (buf == nullptr)
+            {
+                waitForSpace();
+                buf = ring.tryReserve(size);
+            }
+            auto *header = reinterpret_cast<AsyncLogDetails::RecordHeader *>(buf);
+            header->size = static_cast<std::uint32_t>(size);
+            header->isPadding = 0;
+            header->type = static_cast<std::uint8_t>(type);
+            header->seq = _seq.fetch_add(1, std::memory_order_relaxed);
+            header->time = std::time(nullptr);
+            header->func = &AsyncLogDetails::formatArgs<Args...>;
+            char *data = buf + sizeof(AsyncLogDetails::RecordHeader);
+            std::memcpy(data, format, formatLen);
+            data += formatLen;
+            ((data = AsyncLogDetails::ArgCodec<Args>::encode(data, args)), ...);
+            ring.commit(size);
+            if (ring.used() > ring.capacity() / 2 && !_isWakeRequested.exchange(true, std::memory_order_relaxed))
+            {
+                _wakeUp.notify_one();
+            }
+            return true;
+        }
+    private:
+        friend struct AsyncLogDetails::LocalRingOwner;
+        explicit AsyncLogger() = default;
+        /// @brief get the ring of the calling thread. Reuse a ring of an exited thread if any
+        AsyncLogDetails::LogRing & localRing();
+        /// @brief take back the ring of an exiting thread. Its pending messages are still written by the next drain
+        void releaseRing(AsyncLogDetails::LogRing *ring);
+        /// @brief let the flusher make space. Drain in the calling thread if the flusher is not running
+        void waitForSpace();
+        /// @brief format and write all the pending messages
+        void drain();
+        /// @brief the main loop of the flusher
+        void flusherLoop();
+    private:
+        std::mutex _ringMutex; ///< Protecting the rings
+        std::vector<std::unique_ptr<AsyncLogDetails::LogRing>> _rings; ///< All the rings, owned or free
+        std::vector<AsyncLogDetails::LogRing *> _freeRings; ///< The rings of the exited threads, waiting for a new thread
+        std::size_t _ringCapacity = 1 << 18; ///< The size of a new ring
+        std::mutex _drainMutex; ///< Only one consumer at a time
+        std::mutex _wakeMutex; ///< For waking up the flusher
+        std::condition_variable _wakeUp; ///< Notified when a ring is filling up or stopping
+        std::thread _flusher; ///< The background flusher
+        std::atomic<bool> _isRunning{false}; ///< Whether the flusher is running
+        std::atomic<bool> _isStopping{false}; ///< Whether the flusher should exit
+        std::atomic<bool> _isWakeRequested{false}; ///< Whether a ring asked the flusher to drain before the next period
+        std::atomic<std::uint64_t> _seq{0}; ///< The order of the next message
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //IDEAPLACE_ASYNC_LOGGER_H_
@@ -0,0 +1,258 @@
+/**
+ * @file BinaryStream.h
+ * @brief Raw binary writer and bounds-checked reader for the snapshot and checkpoint files
+ * @date 10/17/2026
+ */
+
+#ifndef KLIB_BINARY_STREAM_H_
+#define KLIB_BINARY_STREAM_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "global/namespace.h"
+#include "global/type.h"
+
+namespace klib
+{
+    /// @class klib::BinaryWriter
+    /// @brief write the values sequentially as their raw bytes. Only meant to be read by the same build on the same machine type
+    class BinaryWriter
+    {
+        public:
+            /// @brief constructor
+            /// @param the file to write
+            explicit BinaryWriter(const std::string &filename) : _file(filename, std::ios::binary), _out(_file) {}
+            /// @brief constructor
+            /// @param the stream to write. Need to outlive the writer
+            explicit BinaryWriter(std::ostream &out) : _out(out) {}
+            /// @brief whether all the writes so far are successful
+            bool good() const { return _out.good(); }
+            /// @brief flush and close the file. Only flush if writing to a given stream
+            void close()
+            {
+                if (_file.is_open())
+                {
+                    _file.close();
+                }
+                else
+                {
+                    _out.flush();
+                }
+            }
+            /// @brief write a plain value
+            template<typename T>
+            void pod(const T &value)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written as raw bytes");
+                _out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+            }
+            /// @brief write a vector as its size followed by the raw elements
+            template<typename T>
+            void vec(const std::vector<T> &values)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written as raw bytes");
+                pod(static_cast<std::uint64_t>(values.size()));
+                if (!values.empty())
+                {
+                    _out.write(reinterpret_cast<const char *>(values.data()), sizeof(T) * values.size());
+                }
+            }
+            /// @brief write a string as its size followed by the characters
+            void str(const std::string &value)
+            {
+                pod(static_cast<std::uint64_t>(value.size()));
+                _out.write(value.data(), value.size());
+            }
+            /// @brief write one field of all the objects as a single vector
+            template<typename ObjType, typename GetField>
+            void column(const std::vector<ObjType> &objs, GetField getField)
+            {
+                using T = std::decay_t<decltype(getField(objs.front()))>;
+                std::vector<T> values;
+                values.reserve(objs.size());
+                for (const auto &obj : objs)
+                {
+                    values.emplace_back(getField(obj));
+                }
+                vec(values);
+            }
+            /// @brief write the names of all the objects as the offsets and the concatenated characters
+            template<typename ObjType, typename GetName>
+            void strings(const std::vector<ObjType> &objs, GetName getName)
+            {
+                std::vector<std::uint64_t> offsets(1, 0);
+                offsets.reserve(objs.size() + 1);
+                std::vector<char> chars;
+                for (const auto &obj : objs)
+                {
+                    const std::string &name = getName(obj);
+                    chars.insert(chars.end(), name.begin(), name.end());
+                    offsets.emplace_back(chars.size());
+                }
+                vec(offsets);
+                vec(chars);
+            }
+            /// @brief write the arrays of all the objects in compressed sparse row format
+            template<typename ObjType, typename GetArray>
+            void csr(const std::vector<ObjType> &objs, GetArray getArray)
+            {
+                using T = typename std::decay_t<decltype(getArray(objs.front()))>::value_type;
+                std::vector<std::uint64_t> offsets(1, 0);
+                offsets.reserve(objs.size() + 1);
+                std::vector<T> values;
+                for (const auto &obj : objs)
+                {
+                    const auto &array = getArray(obj);
+                    values.insert(values.end(), array.begin(), array.end());
+                    offsets.emplace_back(values.size());
+                }
+                vec(offsets);
+                vec(values);
+            }
+        private:
+            std::ofstream _file; ///< The output file, if writing to a file
+            std::ostream &_out; ///< The output stream
+    };
+
+    /// @class klib::BinaryReader
+    /// @brief read the values written by BinaryWriter from the memory. Every read is bounds checked, and the first failure fails all the following reads
+    class BinaryReader
+    {
+        public:
+            /// @brief constructor
+            /// @param the whole file content. Need to outlive the reader
+            explicit BinaryReader(std::string_view data) : _data(data) {}
+            /// @brief whether all the reads so far are successful
+            bool ok() const { return _ok; }
+            /// @brief whether the whole content has been read
+            bool atEnd() const { return _pos == _data.size(); }
+            /// @brief read a plain value
+            template<typename T>
+            bool pod(T &value)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read as raw bytes");
+                if (!_ok || remaining() < sizeof(T))
+                {
+                    return fail();
+                }
+                std::memcpy(&value, _data.data() + _pos, sizeof(T));
+                _pos += sizeof(T);
+                return true;
+            }
+            /// @brief read a vector written by BinaryWriter::vec
+            template<typename T>
+            bool vec(std::vector<T> &values)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read as raw bytes");
+                std::uint64_t size = 0;
+                if (!pod(size) || size > remaining() / sizeof(T))
+                {
+                    return fail();
+                }
+                values.resize(size);
+                if (size > 0)
+                {
+                    std::memcpy(values.data(), _data.data() + _pos, sizeof(T) * size);
+                }
+                _pos += sizeof(T) * size;
+                return true;
+            }
+            /// @brief read a string written by BinaryWriter::str
+            bool str(std::string &value)
+            {
+                std::uint64_t size = 0;
+                if (!pod(size) || size > remaining())
+                {
+                    return fail();
+                }
+                value.assign(_data.data() + _pos, size);
+                _pos += size;
+                return true;
+            }
+            /// @brief read the number of objects, and allocate them
+            template<typename ObjType>
+            bool objects(std::vector<ObjType> &objs)
+            {
+                std::uint64_t size = 0;
+                // Each object has at least one byte in the following columns
+                if (!pod(size) || size > remaining())
+                {
+                    return fail();
+                }
+                objs.resize(size);
+                return true;
+            }
+            /// @brief read one field of all the objects written by BinaryWriter::column
+            template<typename T, typename ObjType, typename SetField>
+            bool column(std::vector<ObjType> &objs, SetField setField)
+            {
+                std::vector<T> values;
+                if (!vec(values) || values.size() != objs.size())
+                {
+                    return fail();
+                }
+                for (std::size_t idx = 0; idx < objs.size(); ++idx)
+                {
+                    setField(objs[idx], values[idx]);
+                }
+                return true;
+            }
+            /// @brief read the names written by BinaryWriter::strings
+            template<typename ObjType, typename GetName>
+            bool strings(std::vector<ObjType> &objs, GetName getName)
+            {
+                std::vector<std::uint64_t> offsets;
+                std::vector<char> chars;
+                if (!vec(offsets) || !vec(chars) || !validOffsets(offsets, objs.size(), chars.size()))
+                {
+                    return fail();
+                }
+                for (std::size_t idx = 0; idx < objs.size(); ++idx)
+                {
+                    getName(objs[idx]).assign(chars.data() + offsets[idx], offsets[idx + 1] - offsets[idx]);
+                }
+                return true;
+            }
+            /// @brief read the arrays written by BinaryWriter::csr
+            template<typename ObjType, typename GetArray>
+            bool csr(std::vector<ObjType> &objs, GetArray getArray)
+            {
+                using T = typename std::decay_t<decltype(getArray(objs.front()))>::value_type;
+                std::vector<std::uint64_t> offsets;
+                std::vector<T> values;
+                if (!vec(offsets) || !vec(values) || !validOffsets(offsets, objs.size(), values.size()))
+                {
+                    return fail();
+                }
+                for (std::size_t idx = 0; idx < objs.size(); ++idx)
+                {
+                    getArray(objs[idx]).assign(values.begin() + offsets[idx], values.begin() + offsets[idx + 1]);
+                }
+                return true;
+            }
+        private:
+            std::size_t remaining() const { return _data.size() - _pos; }
+            bool fail() { _ok = false; return false; }
+            static bool validOffsets(const std::vector<std::uint64_t> &offsets, std::size_t numObjs, std::size_t numValues)
+            {
+                if (offsets.size() != numObjs + 1 || offsets.front() != 0 || offsets.back() != numValues)
+                {
+                    return false;
+                }
+                return std::is_sorted(offsets.begin(), offsets.end());
+            }
+        private:
+            std::string_view _data; ///< The whole file
+            std::size_t _pos = 0; ///< The current reading position
+            bool _ok = true; ///< Whether all the reads so far are successful
+    };
+}
+
+#endif //KLIB_BINARY_STREAM_H_
@@ -0,0 +1,100 @@
+/**
+ * @file Hash.h
+ * @brief Stable 64-bit hash of byte strings (xxHash64)
+ * @date 10/17/2026
+ */
+
+#ifndef KLIB_HASH_H_
+#define KLIB_HASH_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace klib
+{
+    namespace _hash
+    {
+        constexpr std::uint64_t P1 = 11400714785074694791ULL;
+        constexpr std::uint64_t P2 = 14029467366897019727ULL;
+        constexpr std::uint64_t P3 = 1609587929392839161ULL;
+        constexpr std::uint64_t P4 = 9650029242287828579ULL;
+        constexpr std::uint64_t P5 = 2870177450012600261ULL;
+
+        inline std::uint64_t rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+        inline std::uint64_t read64(const char *p) { std::uint64_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+        inline std::uint32_t read32(const char *p) { std::uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+        inline std::uint64_t round(std::uint64_t acc, std::uint64_t input)
+        {
+            acc += input * P2;
+            acc = rotl(acc, 31);
+            return acc * P1;
+        }
+        inline std::uint64_t mergeRound(std::uint64_t acc, std::uint64_t val)
+        {
+            acc ^= round(0, val);
+            return acc * P1 + P4;
+        }
+    }
+
+    /// @brief xxHash64 of the bytes. Stable across runs and builds on little-endian machines, so it can be used for the on-disk keys
+    /// @param first: the bytes
+    /// @param second: the seed
+    /// @return the hash value
+    inline std::uint64_t hash64(std::string_view data, std::uint64_t seed = 0)
+    {
+        using namespace _hash;
+        const char *p = data.data();
+        const char *end = p + data.size();
+        std::uint64_t h;
+        if (data.size() >= 32)
+        {
+            std::uint64_t v1 = seed + P1 + P2;
+            std::uint64_t v2 = seed + P2;
+            std::uint64_t v3 = seed;
+            std::uint64_t v4 = seed - P1;
+            const char *limit = end - 32;
+            do
+            {
+                v1 = round(v1, read64(p)); p += 8;
+                v2 = round(v2, read64(p)); p += 8;
+                v3 = round(v3, read64(p)); p += 8;
+                v4 = round(v4, read64(p)); p += 8;
+            } while (p <= limit);
+            h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+            h = mergeRound(h, v1);
+            h = mergeRound(h, v2);
+            h = mergeRound(h, v3);
+            h = mergeRound(h, v4);
+        }
+        else
+        {
+            h = seed + P5;
+        }
+        h += static_cast<std::uint64_t>(data.size());
+        for (; p + 8 <= end; p += 8)
+        {
+            h ^= round(0, read64(p));
+            h = rotl(h, 27) * P1 + P4;
+        }
+        if (p + 4 <= end)
+        {
+            h ^= static_cast<std::uint64_t>(read32(p)) * P1;
+            h = rotl(h, 23) * P2 + P3;
+            p += 4;
+        }
+        for (; p < end; ++p)
+        {
+            h ^= static_cast<std::uint64_t>(static_cast<unsigned char>(*p)) * P5;
+            h = rotl(h, 11) * P1;
+        }
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        h ^= h >> 32;
+        return h;
+    }
+}
+
+#endif //KLIB_HASH_H_
@@ -0,0 +1,186 @@
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+#include <unistd.h>
+#include "global/define.h"
+#ifdef IDEAPLACE_TRACK_ALLOCATIONS
+#include <malloc.h>
+#endif
+
+namespace klib
+{
+    std::atomic<bool> MemoryTracker::_isEnabled(false);
+    std::atomic<std::uint64_t> MemoryTracker::_numAllocs(0);
+    std::atomic<std::uint64_t> MemoryTracker::_allocBytes(0);
+    std::atomic<std::int64_t> MemoryTracker::_liveBytes(0);
+    std::atomic<std::int64_t> MemoryTracker::_peakLiveBytes(0);
+
+    bool MemoryTracker::isAllocationTrackingAvailable()
+    {
+#ifdef IDEAPLACE_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    namespace MemoryTrackerDetails
+    {
+        /// @brief read a "Key:   value kB" field of /proc/self/status
+        inline std::uint64_t readStatusKb(const char *key)
+        {
+            std::ifstream status("/proc/self/status");
+            std::string line;
+            const std::size_t keyLen = std::strlen(key);
+            while (std::getline(status, line))
+            {
+                if (line.compare(0, keyLen, key) == 0 && line.size() > keyLen && line[keyLen] == ':')
+                {
+                    return std::strtoull(line.c_str() + keyLen + 1, nullptr, 10) * 1024;
+                }
+            }
+            return 0;
+        }
+    }
+
+    std::uint64_t MemoryTracker::residentBytes()
+    {
+        return MemoryTrackerDetails::readStatusKb("VmRSS");
+    }
+
+    std::uint64_t MemoryTracker::peakResidentBytes()
+    {
+        return MemoryTrackerDetails::readStatusKb("VmHWM");
+    }
+
+    bool MemoryTracker::resetPeakResidentBytes()
+    {
+        // "5" resets the peak RSS of the process
+        std::FILE *file = std::fopen("/proc/self/clear_refs", "w");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        bool success = std::fputs("5", file) >= 0;
+        success = std::fclose(file) == 0 && success;
+        return success;
+    }
+
+    void MemoryStageRecorder::beginStage(const std::string &stage)
+    {
+        endStage();
+        MemoryStats stats;
+        stats.stage = stage;
+        _stats.emplace_back(stats);
+        _isRssPeakReset = MemoryTracker::resetPeakResidentBytes();
+        MemoryTracker::resetPeakLiveBytes();
+        _startNumAllocs = MemoryTracker::numAllocs();
+        _startAllocBytes = MemoryTracker::allocBytes();
+        _startLiveBytes = MemoryTracker::liveBytes();
+        _isInStage = true;
+    }
+
+    void MemoryStageRecorder::endStage()
+    {
+        if (!_isInStage)
+        {
+            return;
+        }
+        _isInStage = false;
+        auto &stats = _stats.back();
+        stats.numAllocs = MemoryTracker::numAllocs() - _startNumAllocs;
+        stats.allocBytes = MemoryTracker::allocBytes() - _startAllocBytes;
+        stats.peakHeapBytes = MemoryTracker::peakLiveBytes() - _startLiveBytes;
+        stats.netHeapBytes = MemoryTracker::liveBytes() - _startLiveBytes;
+        stats.rssBytes = MemoryTracker::residentBytes();
+        stats.peakRssBytes = MemoryTracker::peakResidentBytes();
+    }
+}
+
+#ifdef IDEAPLACE_TRACK_ALLOCATIONS
+/* Replace the global allocation functions. The size is taken from malloc_usable_size, so that the sized and unsized deletes agree */
+namespace
+{
+    inline void * trackedAlloc(std::size_t size)
+    {
+        void *ptr = std::malloc(size == 0 ? 1 : size);
+        if (ptr != nullptr && klib::MemoryTracker::isEnabled())
+        {
+            klib::MemoryTracker::recordAlloc(malloc_usable_size(ptr));
+        }
+        return ptr;
+    }
+    inline void * trackedAlignedAlloc(std::size_t size, std::align_val_t align)
+    {
+        std::size_t alignment = std::max(static_cast<std::size_t>(align), sizeof(void *));
+        void *ptr = nullptr;
+        if (posix_memalign(&ptr, alignment, size == 0 ? 1 : size) != 0)
+        {
+            return nullptr;
+        }
+        if (klib::MemoryTracker::isEnabled())
+        {
+            klib::MemoryTracker::recordAlloc(malloc_usable_size(ptr));
+        }
+        return ptr;
+    }
+    inline void trackedFree(void *ptr)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        if (klib::MemoryTracker::isEnabled())
+        {
+            klib::MemoryTracker::recordFree(malloc_usable_size(ptr));
+        }
+        std::free(ptr);
+    }
+}
+
+void * operator new(std::size_t size)
+{
+    void *ptr = trackedAlloc(size);
+    if (ptr == nullptr) { throw std::bad_alloc(); }
+    return ptr;
+}
+void * operator new[](std::size_t size)
+{
+    void *ptr = trackedAlloc(size);
+    if (ptr == nullptr) { throw std::bad_alloc(); }
+    return ptr;
+}
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept { return trackedAlloc(size); }
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept { return trackedAlloc(size); }
+void * operator new(std::size_t size, std::align_val_t align)
+{
+    void *ptr = trackedAlignedAlloc(size, align);
+    if (ptr == nullptr) { throw std::bad_alloc(); }
+    return ptr;
+}
+void * operator new[](std::size_t size, std::align_val_t align)
+{
+    void *ptr = trackedAlignedAlloc(size, align);
+    if (ptr == nullptr) { throw std::bad_alloc(); }
+    return ptr;
+}
+void * operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return trackedAlignedAlloc(size, align); }
+void * operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return trackedAlignedAlloc(size, align); }
+void operator delete(void *ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr) noexcept { trackedFree(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { trackedFree(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { trackedFree(ptr); }
+#endif //IDEAPLACE_TRACK_ALLOCATIONS
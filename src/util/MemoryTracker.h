@@ -0,0 +1,105 @@
+/**
+ * @file MemoryTracker.h
+ * @brief Heap allocation accounting and resident memory of the process by stages
+ * @date 10/17/2026
+ */
+
+#ifndef KLIB_MEMORY_TRACKER_H_
+#define KLIB_MEMORY_TRACKER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace klib
+{
+    /// @brief the memory usage of a stage
+    struct MemoryStats
+    {
+        std::string stage; ///< The name of the stage
+        std::uint64_t numAllocs = 0; ///< The number of heap allocations
+        std::uint64_t allocBytes = 0; ///< The total bytes allocated on the heap
+        std::int64_t peakHeapBytes = 0; ///< The peak of the live heap bytes above the start of the stage
+        std::int64_t netHeapBytes = 0; ///< The live heap bytes at the end minus the start of the stage
+        std::uint64_t rssBytes = 0; ///< The resident set size at the end of the stage
+        std::uint64_t peakRssBytes = 0; ///< The peak resident set size during the stage. The peak of the process so far if the peak cannot be reset
+    };
+
+    /// @class klib::MemoryTracker
+    /// @brief count the heap allocations through the replaced global operator new/delete, and read the resident memory from /proc.
+    /// The allocation counting is compiled in with IDEAPLACE_TRACK_ALLOCATIONS and is off until enabled. The counters are process-wide, so the stages of the concurrent solvings mix
+    class MemoryTracker
+    {
+        public:
+            /// @brief start counting the allocations
+            static void enable() { _isEnabled.store(true, std::memory_order_relaxed); }
+            /// @brief stop counting the allocations
+            static void disable() { _isEnabled.store(false, std::memory_order_relaxed); }
+            /// @brief whether the allocations are being counted
+            static bool isEnabled() { return _isEnabled.load(std::memory_order_relaxed); }
+            /// @brief whether the allocation counting is compiled in
+            static bool isAllocationTrackingAvailable();
+            /// @brief record an allocation. Called by operator new
+            static void recordAlloc(std::size_t bytes)
+            {
+                _numAllocs.fetch_add(1, std::memory_order_relaxed);
+                _allocBytes.fetch_add(bytes, std::memory_order_relaxed);
+                std::int64_t live = _liveBytes.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed) + static_cast<std::int64_t>(bytes);
+                std::int64_t peak = _peakLiveBytes.load(std::memory_order_relaxed);
+                while (live > peak && !_peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+            }
+            /// @brief record a deallocation. Called by operator delete
+            static void recordFree(std::size_t bytes)
+            {
+                _liveBytes.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+            }
+            /// @brief the number of allocations counted so far
+            static std::uint64_t numAllocs() { return _numAllocs.load(std::memory_order_relaxed); }
+            /// @brief the bytes allocated so far
+            static std::uint64_t allocBytes() { return _allocBytes.load(std::memory_order_relaxed); }
+            /// @brief the live heap bytes counted. Only the differences are meaningful, as the allocations before enabling are not counted
+            static std::int64_t liveBytes() { return _liveBytes.load(std::memory_order_relaxed); }
+            /// @brief the peak live heap bytes since the last reset
+            static std::int64_t peakLiveBytes() { return _peakLiveBytes.load(std::memory_order_relaxed); }
+            /// @brief start a new peak of the live heap bytes from now
+            static void resetPeakLiveBytes() { _peakLiveBytes.store(liveBytes(), std::memory_order_relaxed); }
+            /// @brief the current resident set size. 0 if not available
+            static std::uint64_t residentBytes();
+            /// @brief the peak resident set size (VmHWM). 0 if not available
+            static std::uint64_t peakResidentBytes();
+            /// @brief start a new peak of the resident set size from now. Need Linux 4.0+
+            /// @return false if the peak cannot be reset
+            static bool resetPeakResidentBytes();
+        private:
+            static std::atomic<bool> _isEnabled; ///< Whether the allocations are being counted
+            static std::atomic<std::uint64_t> _numAllocs; ///< The number of allocations
+            static std::atomic<std::uint64_t> _allocBytes; ///< The total bytes allocated
+            static std::atomic<std::int64_t> _liveBytes; ///< The bytes allocated minus freed
+            static std::atomic<std::int64_t> _peakLiveBytes; ///< The peak of _liveBytes since the last reset
+    };
+
+    /// @class klib::MemoryStageRecorder
+    /// @brief record the memory usage of the consecutive stages of a run
+    class MemoryStageRecorder
+    {
+        public:
+            /// @brief start recording into the stats
+            /// @param the output stats. One per stage. Cleared
+            explicit MemoryStageRecorder(std::vector<MemoryStats> &stats) : _stats(stats) { _stats.clear(); }
+            ~MemoryStageRecorder() { endStage(); }
+            /// @brief end the current stage, and start a new one
+            void beginStage(const std::string &stage);
+            /// @brief end the current stage
+            void endStage();
+        private:
+            std::vector<MemoryStats> &_stats; ///< The output
+            bool _isInStage = false; ///< Whether a stage is being recorded
+            std::uint64_t _startNumAllocs = 0; ///< The counters at the start of the stage
+            std::uint64_t _startAllocBytes = 0;
+            std::int64_t _startLiveBytes = 0;
+            bool _isRssPeakReset = false; ///< Whether the peak resident set size is reset at the start
+    };
+}
+
+#endif //KLIB_MEMORY_TRACKER_H_
@@ -0,0 +1,92 @@
+#include "MmapTokenizer.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace klib
+{
+    bool MmapFile::open(const std::string &filename)
+    {
+        this->close();
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        _size = static_cast<std::size_t>(st.st_size);
+        if (_size > 0)
+        {
+            void *addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED)
+            {
+                ::close(fd);
+                _size = 0;
+                return false;
+            }
+            // The parsers read the file from the begining to the end
+            ::madvise(addr, _size, MADV_SEQUENTIAL);
+            _data = static_cast<const char *>(addr);
+            _isMapped = true;
+        }
+        // The mapping is kept after the descriptor is closed
+        ::close(fd);
+        _isOpen = true;
+        return true;
+    }
+
+    void MmapFile::close()
+    {
+        if (_isMapped)
+        {
+            ::munmap(const_cast<char *>(_data), _size);
+        }
+        _data = nullptr;
+        _size = 0;
+        _isMapped = false;
+        _isOpen = false;
+    }
+
+    bool LineTokenizer::nextLine()
+    {
+        _fields.clear();
+        if (_pos >= _text.size())
+        {
+            _line = std::string_view();
+            return false;
+        }
+        std::size_t end = _text.find('\n', _pos);
+        if (end == std::string_view::npos)
+        {
+            end = _text.size();
+        }
+        _line = _text.substr(_pos, end - _pos);
+        _pos = end + 1;
+        // Split by whitespace, as operator>> of istream
+        auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; };
+        std::size_t idx = 0;
+        while (idx < _line.size())
+        {
+            while (idx < _line.size() && isSpace(_line[idx]))
+            {
+                ++idx;
+            }
+            std::size_t begin = idx;
+            while (idx < _line.size() && !isSpace(_line[idx]))
+            {
+                ++idx;
+            }
+            if (idx > begin)
+            {
+                _fields.emplace_back(_line.substr(begin, idx - begin));
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file MmapTokenizer.h
+ * @brief Memory-mapped line and field tokenizer for the text parsers
+ * @date 10/17/2026
+ */
+
+#ifndef KLIB_MMAP_TOKENIZER_H_
+#define KLIB_MMAP_TOKENIZER_H_
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "global/namespace.h"
+#include "global/type.h"
+
+namespace klib
+{
+    using IndexType  = PROJECT_NAMESPACE::IndexType;
+
+    /// @class klib::MmapFile
+    /// @brief read-only memory mapping of a file. The whole file is seen as one string_view
+    class MmapFile
+    {
+        public:
+            explicit MmapFile() = default;
+            MmapFile(const MmapFile &) = delete;
+            MmapFile & operator=(const MmapFile &) = delete;
+            ~MmapFile() { this->close(); }
+            /// @brief map a file into memory
+            /// @param the file name
+            /// @return if successful
+            bool open(const std::string &filename);
+            /// @brief unmap the file
+            void close();
+            /// @brief whether a file is mapped
+            bool isOpen() const { return _isOpen; }
+            /// @brief get the content of the file
+            /// @return the whole file. Only valid before close()
+            std::string_view content() const { return std::string_view(_data, _size); }
+        private:
+            const char *_data = nullptr; ///< The mapped memory
+            std::size_t _size = 0; ///< The size of the file
+            bool _isMapped = false; ///< Whether _data is from mmap. Empty files are not mapped
+            bool _isOpen = false; ///< Whether the file is open
+    };
+
+    /// @class klib::LineTokenizer
+    /// @brief iterate the lines of a text, and split each line into whitespace-separated fields.
+    /// The fields are views into the text, so no string is copied
+    class LineTokenizer
+    {
+        public:
+            /// @brief constructor
+            /// @param the text to tokenize. Need to outlive the tokenizer
+            explicit LineTokenizer(std::string_view text) : _text(text) {}
+            /// @brief move to the next line and split it into fields. Same line semantics as std::getline
+            /// @return false if there is no more line
+            bool nextLine();
+            /// @brief get the current line, without the line ending
+            std::string_view line() const { return _line; }
+            /// @brief get the number of fields in the current line
+            IndexType numFields() const { return _fields.size(); }
+            /// @brief get a field in the current line
+            std::string_view field(IndexType idx) const { return _fields.at(idx); }
+            /// @brief get all the fields in the current line
+            const std::vector<std::string_view> & fields() const { return _fields; }
+        private:
+            std::string_view _text; ///< The whole text
+            std::size_t _pos = 0; ///< The begining of the next line in _text
+            std::string_view _line; ///< The current line
+            std::vector<std::string_view> _fields; ///< The fields of the current line
+    };
+
+    /// @brief parse a number from the begining of a field with std::from_chars. Trailing characters are ignored, as atof/atoi.
+    /// A negative number wraps around into an unsigned type, as atoi assigned to an unsigned
+    /// @param first: the field
+    /// @param second: the parsed number
+    /// @return if a number is parsed
+    template<typename T>
+    inline bool parseNumber(std::string_view field, T &value)
+    {
+        if (!field.empty() && field.front() == '+')
+        {
+            field.remove_prefix(1);
+        }
+        if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>)
+        {
+            long long signedValue = 0;
+            auto result = std::from_chars(field.data(), field.data() + field.size(), signedValue);
+            if (result.ec != std::errc())
+            {
+                return false;
+            }
+            value = static_cast<T>(signedValue);
+            return true;
+        }
+        else
+        {
+            auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+            return result.ec == std::errc();
+        }
+    }
+
+    /// @brief parse a number and return the default value on failure
+    template<typename T>
+    inline T toNumber(std::string_view field, T defaultValue = T(0))
+    {
+        T value = defaultValue;
+        if (!parseNumber(field, value))
+        {
+            return defaultValue;
+        }
+        return value;
+    }
+}
+
+#endif //KLIB_MMAP_TOKENIZER_H_
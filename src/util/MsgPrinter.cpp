@@ -11,6 +11,7 @@ std::time_t MsgPrinter::_startTime = std::time(nullptr);
 FILE* MsgPrinter::_screenOutStream = nullptr;
 FILE* MsgPrinter::_logOutStream = nullptr;
 std::string MsgPrinter::_logFileName = "";
+std::atomic<int> MsgPrinter::_minLevel(0);
 
 /// Converting enum type to std::string
 std::string msgTypeToStr(MsgType msgType) 
@@ -95,43 +96,94 @@ void MsgPrinter::dbg(const char* rawFormat, ...)
     va_end(args);
 }
 
+/// Print the arguments forwarded from log()
+void MsgPrinter::printArgs(MsgType msgType, const char* rawFormat, ...)
+{
+    va_list args;
+    va_start(args, rawFormat);
+    print(msgType, rawFormat, args);
+    va_end(args);
+}
+
 /// Message printing kernel
 void MsgPrinter::print(MsgType msgType, const char* rawFormat, va_list args) 
 {
-    /// Get the message type
-    std::string type = "[" + msgTypeToStr(msgType);
-
-    /// Get local time and elapsed time
-    struct tm* timeInfo;
-    std::time_t now = std::time(nullptr);
-    timeInfo = localtime(&now);
-    double elapsed = difftime(now, _startTime);
-
-    /// Local time
-    char locTime[32];
-    strftime(locTime, 32, " %F %T ", timeInfo);
+    if (!isEnabled(msgType))
+    {
+        return;
+    }
+    // Keep the order with the pending asynchronous messages
+    if (AsyncLogger::instance().isRunning())
+    {
+        AsyncLogger::instance().flush();
+    }
 
-    /// Elapsed time
-    char elpTime[32];
-    sprintf(elpTime, "%5.0lf sec]  ", elapsed);
+    char buf[1024];
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int len = vsnprintf(buf, sizeof(buf), rawFormat, args_copy);
+    va_end(args_copy);
+    if (len >= static_cast<int>(sizeof(buf)))
+    {
+        std::string msg(len + 1, '\0');
+        vsnprintf(&msg[0], msg.size(), rawFormat, args);
+        writeMsg(msgType, std::time(nullptr), msg.c_str());
+    }
+    else
+    {
+        writeMsg(msgType, std::time(nullptr), len >= 0 ? buf : rawFormat);
+    }
+    flushStreams();
+}
 
-    // Combine all the strings together
-    std::string format = type + std::string(locTime) + std::string(elpTime) + std::string(rawFormat);
+/// Write the message with the header
+void MsgPrinter::writeMsg(MsgType msgType, std::time_t time, const char *msg)
+{
+    // The time part only changes every second. Cache it for the bursts of messages
+    thread_local std::time_t lastTime = -1;
+    thread_local std::time_t lastStartTime = -1;
+    thread_local char timeStr[64];
+    if (time != lastTime || _startTime != lastStartTime)
+    {
+        lastTime = time;
+        lastStartTime = _startTime;
+        /// Get local time and elapsed time
+        struct tm timeInfo;
+        localtime_r(&time, &timeInfo);
+        double elapsed = difftime(time, _startTime);
+
+        /// Local time
+        char locTime[32];
+        strftime(locTime, 32, " %F %T ", &timeInfo);
+
+        /// Elapsed time
+        snprintf(timeStr, sizeof(timeStr), "%s%5.0lf sec]  ", locTime, elapsed);
+    }
+    /// Get the message type
+    const char *type = msgType == MsgType::INF ? "[INF" : msgType == MsgType::WRN ? "[WRN" : msgType == MsgType::ERR ? "[ERR" : "[DBG";
 
     // print to log
     if (_logOutStream)
     {
-        va_list args_copy;
-        va_copy(args_copy, args);
-        vfprintf(_logOutStream, format.c_str(), args_copy);
-        va_end(args_copy);
-        fflush(_logOutStream);
+        fprintf(_logOutStream, "%s%s%s", type, timeStr, msg);
     }
 
     // print to screen
     if (_screenOutStream)
     {
-        vfprintf(_screenOutStream, format.c_str(), args);
+        fprintf(_screenOutStream, "%s%s%s", type, timeStr, msg);
+    }
+}
+
+/// Flush the streams
+void MsgPrinter::flushStreams()
+{
+    if (_logOutStream)
+    {
+        fflush(_logOutStream);
+    }
+    if (_screenOutStream)
+    {
         fflush(_screenOutStream);
     }
 }
@@ -14,7 +14,9 @@
 #include <string>
 #include <ctime>
 #include <cstdarg>
+#include <atomic>
 #include "global/namespace.h"
+#include "AsyncLogger.h"
 
 PROJECT_NAMESPACE_BEGIN
 
@@ -36,6 +38,12 @@ enum class MsgType
 /// Function converting enum type to std::string
 std::string msgTypeToStr(MsgType msgType);
 
+/// The severity of a message type. DBG < INF < WRN < ERR
+constexpr int msgTypeLevel(MsgType msgType)
+{
+    return msgType == MsgType::DBG ? 0 : msgType == MsgType::INF ? 1 : msgType == MsgType::WRN ? 2 : 3;
+}
+
 /// Message printing class
 class MsgPrinter 
 {
@@ -51,7 +59,39 @@ class MsgPrinter
         static void err(const char *rawFormat, ...);
         static void dbg(const char *rawFormat, ...);
 
+        /// Only print the messages at least as severe as the type
+        static void setMinMsgType(MsgType msgType) { _minLevel.store(msgTypeLevel(msgType), std::memory_order_relaxed); }
+        /// Whether a message of the type will be printed anywhere. Checked by INF/WRN/ERR/DBG before evaluating the arguments
+        static bool isEnabled(MsgType msgType)
+        {
+            return msgTypeLevel(msgType) >= _minLevel.load(std::memory_order_relaxed) && (_screenOutStream != nullptr || _logOutStream != nullptr);
+        }
+        /// Start the asynchronous mode: the messages except ERR are formatted and written by a background thread
+        /// The size of the message buffer of each thread, in bytes
+        static void startAsync(std::size_t bufferSize = 1 << 18) { AsyncLogger::instance().start(bufferSize); }
+        /// Write the pending messages and go back to the synchronous mode
+        static void stopAsync() { AsyncLogger::instance().stop(); }
+        /// Write the pending messages of the asynchronous mode now
+        static void flush() { AsyncLogger::instance().flush(); }
+        /// The message printing used by INF/WRN/ERR/DBG
+        template<typename... Args>
+        static void log(MsgType msgType, const char *rawFormat, const Args &... args)
+        {
+            // The errors are printed at once, as the program may abort right after
+            if (msgType != MsgType::ERR && AsyncLogger::instance().isRunning()
+                    && AsyncLogger::instance().push(msgType, rawFormat, args...))
+            {
+                return;
+            }
+            printArgs(msgType, rawFormat, args...);
+        }
+        /// Write a formatted message with the header of the type and the time. Used by the asynchronous flusher
+        static void writeMsg(MsgType msgType, std::time_t time, const char *msg);
+        /// Flush the screen and log streams
+        static void flushStreams();
+
     private:
+        static void printArgs(MsgType msgType, const char *rawFormat, ...);
         static void print(MsgType msgType, const char *rawFormat, va_list args);
 
     private:
@@ -59,6 +99,7 @@ class MsgPrinter
         static FILE *        _screenOutStream;  // Out stream for screen printing
         static FILE *        _logOutStream;     // Out stream for log printing
         static std::string   _logFileName;      // Current log file name
+        static std::atomic<int> _minLevel;      // The least severe message type printed
 };
 
 PROJECT_NAMESPACE_END
@@ -0,0 +1,155 @@
+#include "PerfCounter.h"
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <cstring>
+
+namespace klib
+{
+    std::atomic<bool> PerfCounters::_isEnabled(false);
+
+    namespace PerfCounterDetails
+    {
+        constexpr std::size_t NUM_EVENTS = PerfCounterValues::NUM_EVENTS;
+
+        /// @brief the counter group of a thread
+        struct ThreadCounters
+        {
+            ThreadCounters() { fds.fill(-1); slots.fill(-1); }
+            ~ThreadCounters()
+            {
+#ifdef __linux__
+                for (int fd : fds)
+                {
+                    if (fd >= 0) { ::close(fd); }
+                }
+#endif
+                // A stop watch destructed later in the thread exit may still read
+                fds.fill(-1);
+                leaderFd = -1;
+            }
+            void open();
+
+            bool isOpened = false; ///< Whether the opening has been tried
+            int leaderFd = -1; ///< The group leader. -1 if no event is available
+            int numOpened = 0; ///< The number of events in the group
+            std::array<int, NUM_EVENTS> fds; ///< The file descriptor of each event. -1 if not available
+            std::array<int, NUM_EVENTS> slots; ///< The position of each event in the group read
+        };
+
+        thread_local ThreadCounters counters;
+
+        void ThreadCounters::open()
+        {
+            isOpened = true;
+#ifdef __linux__
+            const std::array<std::uint64_t, NUM_EVENTS> configs = {
+                PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+            for (std::size_t idx = 0; idx < NUM_EVENTS; ++idx)
+            {
+                struct perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(attr);
+                attr.config = configs[idx];
+                attr.disabled = leaderFd < 0 ? 1 : 0;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                // This thread, any cpu
+                int fd = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, leaderFd, 0));
+                if (fd < 0)
+                {
+                    continue;
+                }
+                if (leaderFd < 0)
+                {
+                    leaderFd = fd;
+                }
+                fds[idx] = fd;
+                slots[idx] = numOpened++;
+            }
+            if (leaderFd >= 0)
+            {
+                ::ioctl(leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ::ioctl(leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        inline ThreadCounters & localCounters()
+        {
+            if (!counters.isOpened)
+            {
+                counters.open();
+            }
+            return counters;
+        }
+    }
+
+    bool PerfCounters::enable()
+    {
+        _isEnabled.store(true, std::memory_order_relaxed);
+        return PerfCounterDetails::localCounters().leaderFd >= 0;
+    }
+
+    bool PerfCounters::isAvailable(PerfEventType event)
+    {
+        return PerfCounterDetails::localCounters().fds[static_cast<std::size_t>(event)] >= 0;
+    }
+
+    bool PerfCounters::read(PerfCounterValues &values)
+    {
+        if (!isEnabled())
+        {
+            return false;
+        }
+        auto &counters = PerfCounterDetails::localCounters();
+        if (counters.leaderFd < 0)
+        {
+            return false;
+        }
+#ifdef __linux__
+        // nr, time enabled, time running, then the values in the group order
+        std::uint64_t buf[3 + PerfCounterDetails::NUM_EVENTS];
+        if (::read(counters.leaderFd, buf, sizeof(buf)) < static_cast<ssize_t>((3 + counters.numOpened) * sizeof(std::uint64_t)))
+        {
+            return false;
+        }
+        const std::uint64_t enabled = buf[1];
+        const std::uint64_t running = buf[2];
+        for (std::size_t idx = 0; idx < PerfCounterDetails::NUM_EVENTS; ++idx)
+        {
+            if (counters.slots[idx] < 0)
+            {
+                values.values[idx] = 0;
+                continue;
+            }
+            std::uint64_t value = buf[3 + counters.slots[idx]];
+            if (running > 0 && running < enabled)
+            {
+                value = static_cast<std::uint64_t>(static_cast<double>(value) * enabled / running);
+            }
+            values.values[idx] = value;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    const char * PerfCounters::eventName(PerfEventType event)
+    {
+        switch (event)
+        {
+            case PerfEventType::CYCLES: return "cycles";
+            case PerfEventType::INSTRUCTIONS: return "instructions";
+            case PerfEventType::CACHE_MISSES: return "cache-misses";
+            case PerfEventType::BRANCH_MISSES: return "branch-misses";
+            default: return "unknown";
+        }
+    }
+}
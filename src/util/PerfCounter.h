@@ -0,0 +1,80 @@
+/**
+ * @file PerfCounter.h
+ * @brief Hardware performance counters of the calling thread via perf_event_open
+ * @date 10/17/2026
+ */
+
+#ifndef KLIB_PERF_COUNTER_H_
+#define KLIB_PERF_COUNTER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace klib
+{
+    /// @brief the hardware events being counted
+    enum class PerfEventType : std::uint8_t
+    {
+        CYCLES = 0,
+        INSTRUCTIONS = 1,
+        CACHE_MISSES = 2,
+        BRANCH_MISSES = 3,
+        COUNT = 4 ///< The number of events
+    };
+
+    /// @brief the counts of the events
+    struct PerfCounterValues
+    {
+        static constexpr std::size_t NUM_EVENTS = static_cast<std::size_t>(PerfEventType::COUNT);
+        std::array<std::uint64_t, NUM_EVENTS> values = {}; ///< Indexed by PerfEventType
+
+        std::uint64_t & operator[](PerfEventType event) { return values[static_cast<std::size_t>(event)]; }
+        std::uint64_t operator[](PerfEventType event) const { return values[static_cast<std::size_t>(event)]; }
+        PerfCounterValues & operator+=(const PerfCounterValues &rhs)
+        {
+            for (std::size_t idx = 0; idx < NUM_EVENTS; ++idx) { values[idx] += rhs.values[idx]; }
+            return *this;
+        }
+        PerfCounterValues operator-(const PerfCounterValues &rhs) const
+        {
+            PerfCounterValues result;
+            for (std::size_t idx = 0; idx < NUM_EVENTS; ++idx) { result.values[idx] = values[idx] - rhs.values[idx]; }
+            return result;
+        }
+        /// @brief whether nothing is counted
+        bool empty() const
+        {
+            for (auto value : values) { if (value != 0) { return false; } }
+            return true;
+        }
+    };
+
+    /// @class klib::PerfCounters
+    /// @brief the cycles, instructions, cache misses and branch misses of the calling thread, in the user space only.
+    /// Each thread opens its own counter group on the first read. The events not supported by the machine (eg. in a VM) or not permitted (perf_event_paranoid) read as 0, and reading is a no-op when none is available.
+    /// The counts are scaled if the kernel multiplexes the counters
+    class PerfCounters
+    {
+        public:
+            /// @brief start counting on the reads from now on
+            /// @return whether any event can be counted on the calling thread
+            static bool enable();
+            /// @brief stop counting. The reads return false afterward
+            static void disable() { _isEnabled.store(false, std::memory_order_relaxed); }
+            /// @brief whether the counters are enabled
+            static bool isEnabled() { return _isEnabled.load(std::memory_order_relaxed); }
+            /// @brief whether an event can be counted on the calling thread
+            static bool isAvailable(PerfEventType event);
+            /// @brief read the current counts of the calling thread
+            /// @param output the counts
+            /// @return false if disabled or no event is available
+            static bool read(PerfCounterValues &values);
+            /// @brief the name of an event
+            static const char * eventName(PerfEventType event);
+        private:
+            static std::atomic<bool> _isEnabled; ///< Whether the counters are enabled
+    };
+}
+
+#endif //KLIB_PERF_COUNTER_H_
@@ -1,18 +1,95 @@
 #include "StopWatch.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <thread>
 
 namespace klib
 {
-    std::vector<std::uint64_t> StopWatchMgr::_us = std::vector<std::uint64_t>(1, 0);
+    const std::uint64_t TscClock::_originTicks = TscClock::ticks();
+    const std::chrono::steady_clock::time_point TscClock::_originTime = std::chrono::steady_clock::now();
+
+    double TscClock::ticksPerUs()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        // Assume an invariant TSC. The longer the baseline, the more accurate
+        auto elapsed = std::chrono::steady_clock::now() - _originTime;
+        while (elapsed < std::chrono::milliseconds(1))
+        {
+            std::this_thread::yield();
+            elapsed = std::chrono::steady_clock::now() - _originTime;
+        }
+        std::uint64_t ticks = TscClock::ticks() - _originTicks;
+        return static_cast<double>(ticks) / std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(elapsed).count();
+#else
+        return 1000.0;
+#endif
+    }
+
+    std::vector<std::uint64_t> StopWatchMgr::_ticks = std::vector<std::uint64_t>(1, 0);
+    std::vector<std::string> StopWatchMgr::_names = std::vector<std::string>(1, "quick");
+    std::vector<PerfCounterValues> StopWatchMgr::_perf = std::vector<PerfCounterValues>(1);
     std::unordered_map<std::string, std::uint32_t> StopWatchMgr::_nameToIdxMap;
-    StopWatch StopWatchMgr::_watch = StopWatch(0); 
+    std::mutex StopWatchMgr::_mutex; // Before _watch, which records on destruction
+    std::atomic<bool> StopWatchMgr::_isTraceOn(false);
+    std::vector<std::unique_ptr<StopWatchMgr::ThreadTrace>> StopWatchMgr::_traces;
+    thread_local StopWatchMgr::ThreadTrace * StopWatchMgr::_localTrace = nullptr;
+    thread_local StopWatch StopWatchMgr::_watch = StopWatch(0);
 
-    std::unique_ptr<StopWatch> StopWatchMgr::createNewStopWatch(std::string &&name) 
+    std::unique_ptr<StopWatch> StopWatchMgr::createNewStopWatch(std::string &&name)
     {
-        auto idx = _us.size();
-        _us.emplace_back(0);
-        _nameToIdxMap[std::move(name)] = idx;
+        std::uint32_t idx;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            idx = _ticks.size();
+            _ticks.emplace_back(0);
+            _names.emplace_back(name);
+            _perf.emplace_back();
+            _nameToIdxMap[std::move(name)] = idx;
+        }
         return std::make_unique<StopWatch>(StopWatch(idx));
     }
+
+    std::uint32_t StopWatchMgr::nameIndex(const std::string &name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto iter = _nameToIdxMap.find(name);
+        if (iter != _nameToIdxMap.end())
+        {
+            return iter->second;
+        }
+        std::uint32_t idx = _ticks.size();
+        _ticks.emplace_back(0);
+        _names.emplace_back(name);
+        _perf.emplace_back();
+        _nameToIdxMap[name] = idx;
+        return idx;
+    }
+
+    bool StopWatchMgr::findTime(const std::string &name, std::uint64_t &time)
+    {
+        std::uint64_t ticks;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto iter = _nameToIdxMap.find(name);
+            if (iter == _nameToIdxMap.end())
+            {
+                return false;
+            }
+            ticks = _ticks[iter->second];
+        }
+        time = TscClock::toUs(ticks);
+        return true;
+    }
+
+    void StopWatchMgr::clearTimes()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::fill(_ticks.begin(), _ticks.end(), 0);
+    }
+
     void StopWatchMgr::quickStart()
     {
         _watch.clear();
@@ -23,5 +100,208 @@ namespace klib
         _watch.stop();
         return _watch.record();
     }
-}
 
+    StopWatchMgr::ThreadTrace & StopWatchMgr::localTrace()
+    {
+        // A raw thread_local pointer, so that the buffer is still usable by the other thread_local destructors
+        if (_localTrace == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _traces.emplace_back(std::make_unique<ThreadTrace>());
+            _traces.back()->tid = _traces.size() - 1;
+            _localTrace = _traces.back().get();
+        }
+        return *_localTrace;
+    }
+
+    void StopWatchMgr::clearTrace()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto &trace : _traces)
+        {
+            std::lock_guard<std::mutex> traceLock(trace->mutex);
+            trace->events.clear();
+        }
+    }
+
+    void StopWatchMgr::snapshotTrace(std::vector<std::string> &names, std::vector<std::pair<std::uint32_t, std::vector<TraceEvent>>> &traces)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        names = _names;
+        traces.clear();
+        for (auto &trace : _traces)
+        {
+            std::lock_guard<std::mutex> traceLock(trace->mutex);
+            if (trace->events.empty())
+            {
+                continue;
+            }
+            traces.emplace_back(trace->tid, trace->events);
+            // Parents first, so that the nesting can be rebuilt with a stack
+            std::sort(traces.back().second.begin(), traces.back().second.end(), [](const TraceEvent &lhs, const TraceEvent &rhs)
+                    {
+                        if (lhs.begin != rhs.begin) { return lhs.begin < rhs.begin; }
+                        return lhs.end > rhs.end;
+                    });
+        }
+    }
+
+    namespace StopWatchDetails
+    {
+        /// @brief escape a name for a JSON string
+        inline std::string jsonEscape(const std::string &str)
+        {
+            std::string result;
+            for (char c : str)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    result += '\\';
+                    result += c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    result += buf;
+                }
+                else
+                {
+                    result += c;
+                }
+            }
+            return result;
+        }
+    }
+
+    bool StopWatchMgr::writeChromeTrace(const std::string &filename)
+    {
+        std::vector<std::string> names;
+        std::vector<std::pair<std::uint32_t, std::vector<TraceEvent>>> traces;
+        snapshotTrace(names, traces);
+        std::ofstream out(filename);
+        if (!out.good())
+        {
+            return false;
+        }
+        const double ticksPerUs = TscClock::ticksPerUs();
+        const std::uint64_t origin = TscClock::originTicks();
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        for (const auto &trace : traces)
+        {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << trace.first
+                << ",\"args\":{\"name\":\"thread " << trace.first << "\"}}";
+            for (const auto &event : trace.second)
+            {
+                out << ",\n{\"name\":\"" << StopWatchDetails::jsonEscape(names.at(event.nameIdx))
+                    << "\",\"cat\":\"stopwatch\",\"ph\":\"X\",\"pid\":0,\"tid\":" << trace.first
+                    << ",\"ts\":" << static_cast<double>(event.begin - origin) / ticksPerUs
+                    << ",\"dur\":" << static_cast<double>(event.end - event.begin) / ticksPerUs << "}";
+            }
+        }
+        out << "\n]}\n";
+        return out.good();
+    }
+
+    void StopWatchMgr::writeProfile(std::ostream &os)
+    {
+        std::vector<std::string> names;
+        std::vector<std::pair<std::uint32_t, std::vector<TraceEvent>>> traces;
+        snapshotTrace(names, traces);
+        // The path from the root to the node, as the name indices
+        struct Node
+        {
+            std::uint64_t ticks = 0; ///< The total time
+            std::uint64_t childTicks = 0; ///< The total time of the direct children
+            std::uint64_t count = 0; ///< The number of intervals
+        };
+        std::map<std::vector<std::uint32_t>, Node> nodes;
+        for (const auto &trace : traces)
+        {
+            std::vector<std::uint32_t> path;
+            std::vector<std::uint64_t> ends;
+            for (const auto &event : trace.second)
+            {
+                while (!ends.empty() && ends.back() <= event.begin)
+                {
+                    ends.pop_back();
+                    path.pop_back();
+                }
+                std::uint64_t ticks = event.end - event.begin;
+                if (!path.empty())
+                {
+                    nodes[path].childTicks += ticks;
+                }
+                path.emplace_back(event.nameIdx);
+                ends.emplace_back(event.end);
+                auto &node = nodes[path];
+                node.ticks += ticks;
+                ++node.count;
+            }
+        }
+        const double ticksPerMs = TscClock::ticksPerUs() * 1000;
+        os << std::left << std::setw(48) << "scope" << std::right
+           << std::setw(12) << "total(ms)" << std::setw(12) << "self(ms)" << std::setw(10) << "calls" << "\n";
+        for (const auto &pair : nodes)
+        {
+            const auto &node = pair.second;
+            std::string label = std::string(2 * (pair.first.size() - 1), ' ') + names.at(pair.first.back());
+            os << std::left << std::setw(48) << label << std::right << std::fixed << std::setprecision(3)
+               << std::setw(12) << node.ticks / ticksPerMs
+               << std::setw(12) << (node.ticks - std::min(node.childTicks, node.ticks)) / ticksPerMs
+               << std::setw(10) << node.count << "\n";
+        }
+    }
+
+    PerfCounterValues StopWatchMgr::perfCounters(const std::string &name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        PerfCounterValues values;
+        for (std::size_t idx = 0; idx < _names.size(); ++idx)
+        {
+            if (_names[idx] == name)
+            {
+                values += _perf[idx];
+            }
+        }
+        return values;
+    }
+
+    void StopWatchMgr::writePerfReport(std::ostream &os)
+    {
+        // The same name may be created by many stop watches, eg. one per solving
+        std::map<std::string, PerfCounterValues> byName;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (std::size_t idx = 0; idx < _names.size(); ++idx)
+            {
+                if (!_perf[idx].empty())
+                {
+                    byName[_names[idx]] += _perf[idx];
+                }
+            }
+        }
+        os << std::left << std::setw(28) << "scope" << std::right
+           << std::setw(16) << "cycles" << std::setw(16) << "instructions" << std::setw(8) << "IPC"
+           << std::setw(14) << "cache-misses" << std::setw(10) << "MPKI" << std::setw(14) << "branch-misses" << std::setw(10) << "BMPKI" << "\n";
+        for (const auto &pair : byName)
+        {
+            const auto &values = pair.second;
+            const double cycles = values[PerfEventType::CYCLES];
+            const double kiloInstructions = values[PerfEventType::INSTRUCTIONS] / 1000.0;
+            auto ratio = [](double num, double den) { return den > 0 ? num / den : 0.0; };
+            os << std::left << std::setw(28) << pair.first << std::right << std::fixed << std::setprecision(2)
+               << std::setw(16) << values[PerfEventType::CYCLES]
+               << std::setw(16) << values[PerfEventType::INSTRUCTIONS]
+               << std::setw(8) << ratio(values[PerfEventType::INSTRUCTIONS], cycles)
+               << std::setw(14) << values[PerfEventType::CACHE_MISSES]
+               << std::setw(10) << ratio(values[PerfEventType::CACHE_MISSES], kiloInstructions)
+               << std::setw(14) << values[PerfEventType::BRANCH_MISSES]
+               << std::setw(10) << ratio(values[PerfEventType::BRANCH_MISSES], kiloInstructions) << "\n";
+        }
+    }
+}
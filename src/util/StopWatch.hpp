@@ -8,86 +8,253 @@
 #ifndef KLIB_STOPWATCH_HPP_
 #define KLIB_STOPWATCH_HPP_
 
+#include <atomic>
 #include <chrono>
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <iostream>
+#include <string>
 #include <cassert>
+#include "PerfCounter.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 namespace klib
 {
+    /// @brief the low-overhead timestamps. The time stamp counter on x86, and the steady clock in ns elsewhere
+    class TscClock
+    {
+        public:
+            /// @brief the current timestamp
+            static std::uint64_t ticks()
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                return __rdtsc();
+#else
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+            }
+            /// @brief the number of ticks per microsecond. Calibrated against the steady clock since the program started
+            static double ticksPerUs();
+            /// @brief convert a number of ticks into microseconds
+            static std::uint64_t toUs(std::uint64_t ticks) { return static_cast<std::uint64_t>(ticks / ticksPerUs()); }
+            /// @brief the timestamp when the program started
+            static std::uint64_t originTicks() { return _originTicks; }
+        private:
+            static const std::uint64_t _originTicks; ///< The timestamp at the start
+            static const std::chrono::steady_clock::time_point _originTime; ///< The steady clock time at the start
+    };
+
+    /// @brief a finished timing interval, ie. a "complete" event in the Chrome trace
+    struct TraceEvent
+    {
+        std::uint32_t nameIdx; ///< The index of the name in StopWatchMgr
+        std::uint64_t begin; ///< The timestamp at the start. In ticks
+        std::uint64_t end; ///< The timestamp at the end. In ticks
+    };
+
     class StopWatch;
-    /// @brief class for maintain the global stop watch
+    /// @brief class for maintain the global stop watch.
+    /// The stop watches are timed with the TSC. When the trace is on, each start-stop interval is also recorded into a buffer owned by the thread, so that the concurrent solvings and the OpenMP threads do not interfere.
+    /// The nesting of the intervals in a thread gives the hierarchy in the profile and the Chrome trace.
+    /// When the hardware counters are on, the counts of the thread between start and stop are added to the name as well
     class StopWatchMgr
     {
         public:
             static std::unique_ptr<StopWatch> createNewStopWatch(std::string &&name);
-            static void recordTime(std::uint64_t time, std::uint32_t idx)
+            /// @brief get the index of a name for the scoped watches. Register the name if not yet
+            static std::uint32_t nameIndex(const std::string &name);
+            static void recordTime(std::uint64_t ticks, std::uint32_t idx)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _ticks[idx] = ticks;
+            }
+            /// @brief add to the total time of a name
+            static void addTime(std::uint64_t ticks, std::uint32_t idx)
             {
-                _us[idx] = time;
+                std::lock_guard<std::mutex> lock(_mutex);
+                _ticks[idx] += ticks;
             }
+            /// @brief add to the hardware counts of a name
+            static void addPerfCounters(const PerfCounterValues &values, std::uint32_t idx)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _perf[idx] += values;
+            }
+            /// @brief get the hardware counts summed over the stop watches with the name
+            static PerfCounterValues perfCounters(const std::string &name);
+            /// @brief print the hardware counts of each name with the derived ratios (IPC, misses per 1k instructions)
+            static void writePerfReport(std::ostream &os);
+            /// @brief get the recorded time of the stop watch created last with the name
+            /// @return time in us
             static std::uint64_t time(std::string &&name)
             {
-                auto iter = _nameToIdxMap.find(std::move(name));
-                assert(iter != _nameToIdxMap.end());
-                return _us[iter->second];
+                std::uint64_t ticks;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    auto iter = _nameToIdxMap.find(std::move(name));
+                    assert(iter != _nameToIdxMap.end());
+                    ticks = _ticks[iter->second];
+                }
+                return TscClock::toUs(ticks);
             }
-            /// @brief start the default timer. The time will return on the end, and won't be recorded
+            /// @brief get the recorded time of the stop watch created last with the name, or of the scopes with the name
+            /// @param first: the name
+            /// @param second: the time in us
+            /// @return false if nothing is recorded with the name
+            static bool findTime(const std::string &name, std::uint64_t &time);
+            /// @brief set all the recorded times to zero, so that the following ones are measured from here. The names are kept
+            static void clearTimes();
+            /// @brief start the default timer of the thread. The time will return on the end, and won't be recorded
             static void quickStart();
-            /// @brief end the default timer.
+            /// @brief end the default timer of the thread.
             /// @return the time since start
             static uint64_t quickEnd();
+            /* Trace */
+            /// @brief start recording the intervals
+            static void enableTrace() { _isTraceOn.store(true, std::memory_order_relaxed); }
+            /// @brief stop recording the intervals. The recorded ones are kept
+            static void disableTrace() { _isTraceOn.store(false, std::memory_order_relaxed); }
+            /// @brief whether the intervals are being recorded
+            static bool isTraceOn() { return _isTraceOn.load(std::memory_order_relaxed); }
+            /// @brief drop the recorded intervals
+            static void clearTrace();
+            /// @brief record an interval into the buffer of the calling thread
+            static void addTraceEvent(std::uint32_t nameIdx, std::uint64_t begin, std::uint64_t end)
+            {
+                if (!isTraceOn()) { return; }
+                auto &trace = localTrace();
+                std::lock_guard<std::mutex> lock(trace.mutex);
+                trace.events.push_back(TraceEvent{nameIdx, begin, end});
+            }
+            /// @brief write the recorded intervals in the Chrome trace_event format. Open with chrome://tracing or Perfetto
+            /// @param the file name
+            /// @return if successful
+            static bool writeChromeTrace(const std::string &filename);
+            /// @brief print the recorded intervals as a tree. The intervals with the same path from the root are merged
+            static void writeProfile(std::ostream &os);
+
+        private:
+            /// @brief the intervals recorded by one thread
+            struct ThreadTrace
+            {
+                std::mutex mutex; ///< Protecting the events from the exporting. Only contended while exporting
+                std::uint32_t tid = 0; ///< The index of the thread in the trace
+                std::vector<TraceEvent> events; ///< The recorded intervals
+            };
+            /// @brief get the trace buffer of the calling thread. Allocate it on the first call
+            static ThreadTrace & localTrace();
+            /// @brief collect the names and a copy of the events of each thread
+            static void snapshotTrace(std::vector<std::string> &names, std::vector<std::pair<std::uint32_t, std::vector<TraceEvent>>> &traces);
 
         private:
-            static std::vector<std::uint64_t> _us; // The record of the stop watch times
+            static std::vector<std::uint64_t> _ticks; ///< The record of the stop watch times
+            static std::vector<std::string> _names; ///< The name of each record
+            static std::vector<PerfCounterValues> _perf; ///< The hardware counts of each record
             static std::unordered_map<std::string, std::uint32_t> _nameToIdxMap; ///< Map timer names to indices
-            static StopWatch _watch; ///< The default one for quick usage that don't need to record
+            static thread_local StopWatch _watch; ///< The default one for quick usage that don't need to record
+            static std::mutex _mutex; ///< Protecting the records, as the placers may run in different threads
+            static std::atomic<bool> _isTraceOn; ///< Whether the intervals are being recorded
+            static std::vector<std::unique_ptr<ThreadTrace>> _traces; ///< The trace buffers. Kept after the threads exit
+            static thread_local ThreadTrace *_localTrace; ///< The trace buffer of this thread
     };
     /// @brief the single stop watch
     class StopWatch
     {
         public:
-            StopWatch(std::uint32_t idx) : _idx(idx) { _count = false; start(); _us = 0; }
+            StopWatch(std::uint32_t idx) : _idx(idx) { _count = false; start(); _ticks = 0; }
             StopWatch(const StopWatch &o) = delete;
             StopWatch(StopWatch &&o)
-                : _last(std::move(o._last)),  _count(std::move(o._count)), _us(std::move(o._us)), _idx(std::move(o._idx)) {}
+                : _last(std::move(o._last)),  _count(std::move(o._count)), _ticks(std::move(o._ticks)), _idx(std::move(o._idx)),
+                  _perfStart(o._perfStart), _hasPerf(o._hasPerf) { o._count = false; }
             ~StopWatch()
             {
                 stop();
-                StopWatchMgr::recordTime(_us, _idx);
+                StopWatchMgr::recordTime(_ticks, _idx);
             }
             void stop()
             {
                 if (_count == false) { return; }
-                _us += curTime();
+                std::uint64_t now = TscClock::ticks();
+                _ticks += now - _last;
                 _count = false;
-                StopWatchMgr::recordTime(_us, _idx);
+                StopWatchMgr::recordTime(_ticks, _idx);
+                StopWatchMgr::addTraceEvent(_idx, _last, now);
+                PerfCounterValues perfEnd;
+                if (_hasPerf && PerfCounters::read(perfEnd))
+                {
+                    StopWatchMgr::addPerfCounters(perfEnd - _perfStart, _idx);
+                }
             }
             void start()
             {
-                if (_count == true) { return; } 
-                _last = std::chrono::high_resolution_clock::now(); 
+                if (_count == true) { return; }
+                _hasPerf = PerfCounters::read(_perfStart);
+                _last = TscClock::ticks();
                 _count = true;
             }
+            /// @return the time since the last start in us
             std::uint64_t curTime()
             {
-                return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - _last).count();
+                return TscClock::toUs(TscClock::ticks() - _last);
             }
+            /// @return the total time in us
             std::uint64_t record()
             {
-                return _us;
+                return TscClock::toUs(_ticks);
             }
             void clear()
             {
-                _us = 0;
+                _ticks = 0;
                 _count = false;
             }
         private:
-            std::chrono::time_point<std::chrono::high_resolution_clock> _last;
+            std::uint64_t _last = 0; ///< The timestamp of the last start
             bool _count = false;
-            std::uint64_t _us; ///< total microsecond
+            std::uint64_t _ticks; ///< total ticks
             std::uint32_t _idx; ///< The index in mgr
+            PerfCounterValues _perfStart; ///< The hardware counts at the last start
+            bool _hasPerf = false; ///< Whether _perfStart is read
+    };
+    /// @brief time a scope. The time is added to the name, and the interval goes into the trace.
+    /// Use KLIB_WATCH_SCOPE instead of constructing directly, so that the name is looked up only once
+    class StopWatchScope
+    {
+        public:
+            explicit StopWatchScope(std::uint32_t nameIdx) : _nameIdx(nameIdx)
+            {
+                _hasPerf = PerfCounters::read(_perfStart);
+                _begin = TscClock::ticks();
+            }
+            StopWatchScope(const StopWatchScope &) = delete;
+            StopWatchScope & operator=(const StopWatchScope &) = delete;
+            ~StopWatchScope()
+            {
+                std::uint64_t end = TscClock::ticks();
+                StopWatchMgr::addTime(end - _begin, _nameIdx);
+                StopWatchMgr::addTraceEvent(_nameIdx, _begin, end);
+                PerfCounterValues perfEnd;
+                if (_hasPerf && PerfCounters::read(perfEnd))
+                {
+                    StopWatchMgr::addPerfCounters(perfEnd - _perfStart, _nameIdx);
+                }
+            }
+        private:
+            std::uint32_t _nameIdx; ///< The index of the name in mgr
+            std::uint64_t _begin = 0; ///< The timestamp at the start
+            PerfCounterValues _perfStart; ///< The hardware counts at the start
+            bool _hasPerf = false; ///< Whether _perfStart is read
     };
 };
+
+#define KLIB_WATCH_SCOPE_CONCAT_IMPL(a, b) a##b
+#define KLIB_WATCH_SCOPE_CONCAT(a, b) KLIB_WATCH_SCOPE_CONCAT_IMPL(a, b)
+/// @brief time the rest of the enclosing scope under the name
+#define KLIB_WATCH_SCOPE(name) \
+    static const std::uint32_t KLIB_WATCH_SCOPE_CONCAT(_klibWatchScopeIdx, __LINE__) = ::klib::StopWatchMgr::nameIndex(name); \
+    ::klib::StopWatchScope KLIB_WATCH_SCOPE_CONCAT(_klibWatchScope, __LINE__)(KLIB_WATCH_SCOPE_CONCAT(_klibWatchScopeIdx, __LINE__))
+
 #endif //KLIB_STOPWATCH_HPP_
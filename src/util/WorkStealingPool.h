@@ -0,0 +1,165 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief A small work-stealing thread pool for coarse-grained tasks
+ * @date 10/17/2026
+ */
+
+#ifndef KLIB_WORK_STEALING_POOL_H_
+#define KLIB_WORK_STEALING_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "global/namespace.h"
+#include "global/type.h"
+
+namespace klib
+{
+    using IndexType  = PROJECT_NAMESPACE::IndexType;
+
+    /// @class klib::WorkStealingPool
+    /// @brief each worker owns a task queue. It takes the tasks from the front of its own queue, and steals from the back of the others when empty.
+    /// The queues are protected by mutexes instead of being lock-free, as the tasks are expected to be long, eg. one placement each
+    class WorkStealingPool
+    {
+        public:
+            /// @brief the task. The argument is the index of the worker running it
+            typedef std::function<void(IndexType)> task_type;
+            /// @brief constructor. Start the workers
+            /// @param the number of workers
+            explicit WorkStealingPool(IndexType numWorkers)
+            {
+                numWorkers = std::max(numWorkers, static_cast<IndexType>(1));
+                for (IndexType idx = 0; idx < numWorkers; ++idx)
+                {
+                    _queues.emplace_back(std::make_unique<TaskQueue>());
+                }
+                for (IndexType idx = 0; idx < numWorkers; ++idx)
+                {
+                    _workers.emplace_back([this, idx]() { this->workerLoop(idx); });
+                }
+            }
+            WorkStealingPool(const WorkStealingPool &) = delete;
+            WorkStealingPool & operator=(const WorkStealingPool &) = delete;
+            /// @brief destructor. Finish the queued tasks and stop the workers
+            ~WorkStealingPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stop = true;
+                }
+                _workAvailable.notify_all();
+                for (auto &worker : _workers)
+                {
+                    worker.join();
+                }
+            }
+            /// @brief the number of workers
+            IndexType numWorkers() const { return _queues.size(); }
+            /// @brief add a task to the queues in round-robin order. The tasks submitted to the same worker start in the submission order unless stolen
+            /// @param the task
+            void submit(task_type task)
+            {
+                IndexType workerIdx = _nextQueue.fetch_add(1, std::memory_order_relaxed) % numWorkers();
+                {
+                    // Count before pushing, so that a worker never sees a task not counted yet
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    ++_numQueued;
+                    ++_numPending;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(_queues[workerIdx]->mutex);
+                    _queues[workerIdx]->tasks.emplace_back(std::move(task));
+                }
+                _workAvailable.notify_one();
+            }
+            /// @brief block until all the submitted tasks are finished
+            void wait()
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _allDone.wait(lock, [&]() { return _numPending == 0; });
+            }
+        private:
+            /// @brief the task queue of a worker
+            struct TaskQueue
+            {
+                std::mutex mutex; ///< Protecting the tasks
+                std::deque<task_type> tasks; ///< The queued tasks
+            };
+            /// @brief take a task from the front of the own queue
+            bool popLocal(IndexType workerIdx, task_type &task)
+            {
+                auto &queue = *_queues[workerIdx];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty())
+                {
+                    return false;
+                }
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+            /// @brief take a task from the back of the other queues
+            bool steal(IndexType workerIdx, task_type &task)
+            {
+                for (IndexType offset = 1; offset < numWorkers(); ++offset)
+                {
+                    auto &queue = *_queues[(workerIdx + offset) % numWorkers()];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (!queue.tasks.empty())
+                    {
+                        task = std::move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                        return true;
+                    }
+                }
+                return false;
+            }
+            /// @brief the main loop of a worker
+            void workerLoop(IndexType workerIdx)
+            {
+                while (true)
+                {
+                    task_type task;
+                    if (popLocal(workerIdx, task) || steal(workerIdx, task))
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            --_numQueued;
+                        }
+                        task(workerIdx);
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (--_numPending == 0)
+                        {
+                            _allDone.notify_all();
+                        }
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _workAvailable.wait(lock, [&]() { return _stop || _numQueued > 0; });
+                    if (_stop && _numQueued == 0)
+                    {
+                        return;
+                    }
+                }
+            }
+        private:
+            std::vector<std::unique_ptr<TaskQueue>> _queues; ///< The task queue of each worker
+            std::vector<std::thread> _workers; ///< The worker threads
+            std::atomic<IndexType> _nextQueue{0}; ///< The queue for the next submitted task
+            std::mutex _mutex; ///< Protecting the counters and the stop flag
+            std::condition_variable _workAvailable; ///< Notified when a task is submitted or the pool is stopping
+            std::condition_variable _allDone; ///< Notified when all the submitted tasks are finished
+            std::size_t _numQueued = 0; ///< The number of tasks in the queues
+            std::size_t _numPending = 0; ///< The number of tasks submitted but not finished
+            bool _stop = false; ///< Whether the pool is stopping
+    };
+}
+
+#endif //KLIB_WORK_STEALING_POOL_H_